@@ -53,7 +53,11 @@ public class DialogueTreeEditor : ModuleRules
 				"ApplicationCore",
 				"ToolMenus",
 				"GameplayTags",
-				"Projects"
+				"Projects",
+				"AssetRegistry",
+				"WorkspaceMenuStructure",
+				"DesktopPlatform",
+				"Json"
 			}
 			);
 		
@@ -0,0 +1,136 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Commandlets/DialogueExportCommandlet.h"
+//UE
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+//Plugin
+#include "Dialogue.h"
+#include "Export/DialogueTextExporter.h"
+#include "LogDialogueTree.h"
+
+const int32 UDialogueExportCommandlet::LOAD_BATCH_SIZE = 64;
+
+UDialogueExportCommandlet::UDialogueExportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UDialogueExportCommandlet::Main(const FString& Params)
+{
+	//Read parameters
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		OutputDir = FPaths::Combine(
+			FPaths::ProjectSavedDir(), 
+			TEXT("DialogueExport")
+		);
+	}
+
+	FString PathList;
+	TArray<FString> SearchPaths;
+	if (FParse::Value(*Params, TEXT("Paths="), PathList, false))
+	{
+		PathList.ParseIntoArray(SearchPaths, TEXT(","), true);
+	}
+	if (SearchPaths.IsEmpty())
+	{
+		SearchPaths.Add(TEXT("/Game"));
+	}
+
+	//Find dialogues without loading them
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked
+		<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UDialogue::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	for (const FString& SearchPath : SearchPaths)
+	{
+		Filter.PackagePaths.Add(FName(*SearchPath));
+	}
+
+	TArray<FAssetData> FoundAssets;
+	AssetRegistry.GetAssets(Filter, FoundAssets);
+
+	//Uncompiled dialogues have no payload worth exporting
+	const FString CompiledStatus = StaticEnum<EDialogueCompileStatus>()
+		->GetNameStringByValue(
+			static_cast<int64>(EDialogueCompileStatus::Compiled)
+		);
+	int32 NumSkipped = 0;
+	FoundAssets.RemoveAll(
+		[&CompiledStatus, &NumSkipped](const FAssetData& Asset)
+		{
+			FString Status;
+			if (Asset.GetTagValue(UDialogue::CompileStatusTag, Status)
+				&& Status != CompiledStatus)
+			{
+				++NumSkipped;
+				return true;
+			}
+			return false;
+		}
+	);
+
+	FoundAssets.Sort(
+		[](const FAssetData& A, const FAssetData& B)
+		{
+			return A.PackageName.LexicalLess(B.PackageName);
+		}
+	);
+
+	UE_LOG(LogDialogueTree, Display, 
+		TEXT("Exporting %d dialogues to %s (%d uncompiled skipped)."),
+		FoundAssets.Num(), *OutputDir, NumSkipped);
+
+	//Load and export in batches to keep memory bounded
+	int32 NumWritten = 0;
+	for (int32 BatchStart = 0; BatchStart < FoundAssets.Num(); 
+		BatchStart += LOAD_BATCH_SIZE)
+	{
+		const int32 BatchEnd = 
+			FMath::Min(BatchStart + LOAD_BATCH_SIZE, FoundAssets.Num());
+
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			LoadPackageAsync(FoundAssets[i].PackageName.ToString());
+		}
+		FlushAsyncLoading();
+
+		TArray<UDialogue*> Batch;
+		Batch.Reserve(BatchEnd - BatchStart);
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			if (UDialogue* Dialogue = Cast<UDialogue>(
+				FoundAssets[i].FastGetAsset(false)))
+			{
+				Batch.Add(Dialogue);
+			}
+			else
+			{
+				UE_LOG(LogDialogueTree, Warning, 
+					TEXT("Failed to load dialogue %s."),
+					*FoundAssets[i].GetObjectPathString());
+			}
+		}
+
+		NumWritten += FDialogueTextExporter::ExportDialogues(Batch, OutputDir);
+
+		Batch.Empty();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	UE_LOG(LogDialogueTree, Display, 
+		TEXT("Dialogue export finished, %d of %d files changed."),
+		NumWritten, FoundAssets.Num());
+
+	return 0;
+}
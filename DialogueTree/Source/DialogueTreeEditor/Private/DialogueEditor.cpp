@@ -3,17 +3,25 @@
 //Header
 #include "DialogueEditor.h"
 //UE
+#include "DesktopPlatformModule.h"
 #include "EdGraphUtilities.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
 #include "FileHelpers.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Framework/Commands/GenericCommands.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "GraphEditorActions.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "IDetailsView.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/Paths.h"
 #include "UObject/SavePackage.h"
 #include "PropertyEditorModule.h"
 #include "SGraphPanel.h"
 #include "ToolMenuEntry.h"
+#include "Widgets/Images/SThrobber.h"
+#include "Widgets/Notifications/SNotificationList.h"
 //Plugin
 #include "Dialogue.h"
 #include "DialogueEditorTabs.h"
@@ -21,11 +29,36 @@
 #include "Graph/DialogueEdGraphSchema.h"
 #include "Graph/Nodes/GraphNodeDialogue.h"
 #include "Graph/Slate/SDialogueGraphEditor.h"
+#include "Import/DialogueScriptImporter.h"
 #include "LogDialogueTree.h"
 #include "Nodes/DialogueNode.h"
 
 #define LOCTEXT_NAMESPACE "DialogueEditor"
 
+DECLARE_STATS_GROUP(
+    TEXT("DialogueTreeEditor"), 
+    STATGROUP_DialogueTreeEditor, 
+    STATCAT_Advanced
+);
+DECLARE_MEMORY_STAT(
+    TEXT("Dialogue Transaction Buffer (All Editors)"), 
+    STAT_DialogueTransactionBuffer, 
+    STATGROUP_DialogueTreeEditor
+);
+
+FDialogueEditor::~FDialogueEditor()
+{
+    UnregisterTransactionListeners();
+
+    if (BuildPanelsHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(BuildPanelsHandle);
+    }
+
+    //Take this editor's share back out of the shared stat
+    DEC_MEMORY_STAT_BY(STAT_DialogueTransactionBuffer, TransactionBufferSize);
+}
+
 void FDialogueEditor::InitEditor(const EToolkitMode::Type Mode, 
     const TSharedPtr<IToolkitHost>& InitToolkitHost, UDialogue* InDialogue)
 {
@@ -35,8 +68,6 @@ void FDialogueEditor::InitEditor(const EToolkitMode::Type Mode,
     FGenericCommands::Register();
     FGraphEditorCommands::Register();
 
-    CreateInternalWidgets();
-
     //Define Layout 
     const TSharedRef<FTabManager::FLayout> DefaultLayout = 
         CreateLayout();
@@ -58,6 +89,15 @@ void FDialogueEditor::InitEditor(const EToolkitMode::Type Mode,
     );
 
     RegenerateMenusAndToolbars();
+
+    //Track undo memory used by this dialogue
+    RegisterTransactionListeners();
+    CountExistingTransactions();
+
+    //Panels show a loading indicator until they are built, one per frame
+    BuildPanelsHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &FDialogueEditor::BuildNextPanel)
+    );
 }
 
 UDialogue* FDialogueEditor::GetDialogue() const
@@ -160,23 +200,118 @@ FString FDialogueEditor::GetReferencerName() const
     return TEXT("FDialogueTreeEditor");
 }
 
-void FDialogueEditor::CreateInternalWidgets()
+void FDialogueEditor::JumpToNode(FName InNodeID)
 {
-    //Create viewport widget
-    ViewportWidget = CreateGraphViewportWidget();
+    if (!ViewportWidget.IsValid())
+    {
+        PendingJumpNodeID = InNodeID;
+        return;
+    }
+
+    UDialogueEdGraph* DialogueGraph = 
+        Cast<UDialogueEdGraph>(ViewportWidget->GetCurrentGraph());
+    if (!DialogueGraph)
+    {
+        return;
+    }
+
+    for (UGraphNodeDialogue* Node : DialogueGraph->GetAllNodes())
+    {
+        if (Node && Node->GetID() == InNodeID)
+        {
+            ViewportWidget->JumpToNode(Node, false, true);
+            return;
+        }
+    }
+}
 
-    //Get property module
+bool FDialogueEditor::BuildNextPanel(float DeltaTime)
+{
     FPropertyEditorModule& PropertyModule = 
         FModuleManager::LoadModuleChecked<FPropertyEditorModule>(
             "PropertyEditor"
         );
 
-    //Create details/properties widgets
-    CreateNodeDetailsWidget(PropertyModule);
+    //Swap each finished panel in for its loading indicator
+    if (!ViewportWidget.IsValid())
+    {
+        //Node widgets build their layout and pins over later frames
+        ViewportWidget = CreateGraphViewportWidget();
+        SetLiveTabContent(
+            FDialogueEditorTabs::ViewportTabID, 
+            ViewportWidget
+        );
+
+        //Apply any jump requested while the graph was being built 
+        if (!PendingJumpNodeID.IsNone())
+        {
+            JumpToNode(PendingJumpNodeID);
+            PendingJumpNodeID = NAME_None;
+        }
+        return true;
+    }
+
+    if (!NodeDetailsWidget.IsValid())
+    {
+        CreateNodeDetailsWidget(PropertyModule);
+        SetLiveTabContent(
+            FDialogueEditorTabs::NodeDetailsTabID, 
+            NodeDetailsWidget
+        );
+        return true;
+    }
+
     CreateGraphPropertiesWidget(PropertyModule);
+    SetLiveTabContent(
+        FDialogueEditorTabs::GraphPropertiesTabID,
+        GraphPropertiesWidget
+    );
 
     //Add compile button to the toolbar
     ExtendToolbar();
+    RegenerateMenusAndToolbars();
+
+    BuildPanelsHandle.Reset();
+    return false;
+}
+
+void FDialogueEditor::SetLiveTabContent(const FName& InTabID, 
+    TSharedPtr<SWidget> InContent)
+{
+    if (!TabManager.IsValid() || !InContent.IsValid())
+    {
+        return;
+    }
+
+    TSharedPtr<SDockTab> LiveTab = TabManager->FindExistingLiveTab(InTabID);
+    if (LiveTab.IsValid())
+    {
+        LiveTab->SetContent(InContent.ToSharedRef());
+    }
+}
+
+TSharedRef<SWidget> FDialogueEditor::CreateLoadingWidget() const
+{
+    return SNew(SBox)
+        .HAlign(HAlign_Center)
+        .VAlign(VAlign_Center)
+        [
+            SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .HAlign(HAlign_Center)
+            .Padding(0.f, 0.f, 0.f, 8.f)
+            [
+                SNew(SCircularThrobber)
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .HAlign(HAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text(LOCTEXT("LoadingGraphText", "Loading dialogue..."))
+            ]
+        ];
 }
 
 TSharedRef<SGraphEditor> FDialogueEditor::CreateGraphViewportWidget()
@@ -453,6 +588,10 @@ TSharedRef<SDockTab> FDialogueEditor::CreateGraphViewportTab(
     {
         NewTab->SetContent(ViewportWidget.ToSharedRef());
     }
+    else
+    {
+        NewTab->SetContent(CreateLoadingWidget());
+    }
 
     return NewTab;
 }
@@ -474,6 +613,10 @@ TSharedRef<SDockTab> FDialogueEditor::CreateGraphDetailsTab(
     {
         NewTab->SetContent(NodeDetailsWidget.ToSharedRef());
     }
+    else
+    {
+        NewTab->SetContent(CreateLoadingWidget());
+    }
 
     return NewTab;
 }
@@ -499,6 +642,10 @@ TSharedRef<SDockTab> FDialogueEditor::CreatePropertiesTab(
     {
         NewTab->SetContent(GraphPropertiesWidget.ToSharedRef());
     }
+    else
+    {
+        NewTab->SetContent(CreateLoadingWidget());
+    }
 
     return NewTab;
 }
@@ -550,6 +697,49 @@ void FDialogueEditor::FillToolbarMenu(FToolBarBuilder& ToolbarBuilder)
                 &FDialogueEditor::GetStatusImage
             )
         );
+
+        FText ImportLabel = 
+            LOCTEXT("ImportScriptLabel", "Import Script");
+
+        FUIAction ImportAction = FUIAction(
+            FExecuteAction::CreateSP(
+                this,
+                &FDialogueEditor::OnImportScript
+            ),
+            FCanExecuteAction::CreateSP(
+                this,
+                &FDialogueEditor::CanImportScript
+            )
+        );
+
+        ToolbarBuilder.AddToolBarButton(
+            ImportAction,
+            NAME_None,
+            ImportLabel,
+            LOCTEXT(
+                "ImportScriptTooltip",
+                "Create or update speeches from a CSV or JSON Lines script."
+            ),
+            FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Import")
+        );
+
+        //Undo memory readout
+        ToolbarBuilder.AddWidget(
+            SNew(SBox)
+            .VAlign(VAlign_Center)
+            .Padding(FMargin(8.f, 0.f))
+            [
+                SNew(STextBlock)
+                .Text(TAttribute<FText>(
+                    this, 
+                    &FDialogueEditor::GetTransactionBufferText
+                ))
+                .ToolTipText(LOCTEXT(
+                    "TransactionBufferTooltip",
+                    "Memory used by undo/redo transactions that record this dialogue's objects."
+                ))
+            ]
+        );
     }
     ToolbarBuilder.EndSection();
 }
@@ -620,6 +810,241 @@ void FDialogueEditor::OnCompile()
     TargetDialogueGraph->CompileAsset();
 }
 
+void FDialogueEditor::OnImportScript()
+{
+    check(TargetDialogue);
+    UDialogueEdGraph* TargetDialogueGraph = 
+        CastChecked<UDialogueEdGraph>(TargetDialogue->GetEdGraph());
+
+    //Ask for the script
+    IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+    if (!DesktopPlatform)
+    {
+        return;
+    }
+
+    TArray<FString> SelectedFiles;
+    const bool bPickedFile = DesktopPlatform->OpenFileDialog(
+        FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+        LOCTEXT("ImportScriptDialogTitle", "Import Dialogue Script").ToString(),
+        FPaths::ProjectDir(),
+        FString(),
+        TEXT("Dialogue Scripts (*.csv;*.json;*.jsonl)|*.csv;*.json;*.jsonl"),
+        EFileDialogFlags::None,
+        SelectedFiles
+    );
+
+    if (!bPickedFile || SelectedFiles.IsEmpty())
+    {
+        return;
+    }
+
+    //Import the script
+    FDialogueScriptImporter Importer(TargetDialogueGraph);
+    FDialogueScriptImportResult Result;
+    const bool bImported = Importer.ImportFile(SelectedFiles[0], Result);
+
+    for (const FString& Error : Result.Errors)
+    {
+        UE_LOG(LogDialogueTree, Warning, TEXT("Script import: %s"), *Error);
+    }
+
+    //Report the outcome
+    FText Summary = bImported
+        ? FText::Format(
+            LOCTEXT(
+                "ImportScriptSummary",
+                "Imported {0} rows: {1} created, {2} updated, {3} unchanged, {4} skipped."
+            ),
+            Result.NumRows,
+            Result.NumCreated,
+            Result.NumUpdated,
+            Result.NumUnchanged,
+            Result.NumSkipped
+        )
+        : LOCTEXT("ImportScriptFailed", "The script could not be imported.");
+
+    FNotificationInfo Info(Summary);
+    Info.ExpireDuration = 5.f;
+    if (!Result.Errors.IsEmpty())
+    {
+        Info.SubText = LOCTEXT(
+            "ImportScriptErrors",
+            "Some rows had problems. See the output log for details."
+        );
+    }
+
+    TSharedPtr<SNotificationItem> Notification = 
+        FSlateNotificationManager::Get().AddNotification(Info);
+    if (Notification.IsValid())
+    {
+        Notification->SetCompletionState(
+            bImported && Result.Errors.IsEmpty()
+                ? SNotificationItem::CS_Success
+                : SNotificationItem::CS_Fail
+        );
+    }
+}
+
+bool FDialogueEditor::CanImportScript() const
+{
+    return ViewportWidget.IsValid();
+}
+
+void FDialogueEditor::RegisterTransactionListeners()
+{
+    UTransBuffer* TransBuffer = 
+        GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+
+    if (!TransBuffer)
+    {
+        return;
+    }
+
+    TransactionStateChangedHandle = 
+        TransBuffer->OnTransactionStateChanged().AddSP(
+            this, 
+            &FDialogueEditor::OnTransactionStateChanged
+        );
+    UndoBufferChangedHandle = 
+        TransBuffer->OnUndoBufferChanged().AddSP(
+            this,
+            &FDialogueEditor::PruneCountedTransactions
+        );
+}
+
+void FDialogueEditor::UnregisterTransactionListeners()
+{
+    UTransBuffer* TransBuffer = 
+        GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+
+    if (!TransBuffer)
+    {
+        return;
+    }
+
+    TransBuffer->OnTransactionStateChanged().Remove(
+        TransactionStateChangedHandle
+    );
+    TransBuffer->OnUndoBufferChanged().Remove(UndoBufferChangedHandle);
+}
+
+void FDialogueEditor::OnTransactionStateChanged(
+    const FTransactionContext& InTransactionContext, 
+    const ETransactionStateEventType InTransactionState)
+{
+    //Only count a transaction once it has actually been committed
+    if (InTransactionState != ETransactionStateEventType::TransactionFinalized)
+    {
+        return;
+    }
+
+    UTransBuffer* TransBuffer =
+        GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+
+    if (!TransBuffer)
+    {
+        return;
+    }
+
+    //The finished transaction is almost always the newest, so look from
+    //the back
+    for (int32 Index = TransBuffer->UndoBuffer.Num() - 1; Index >= 0; --Index)
+    {
+        const FTransaction& Transaction = TransBuffer->UndoBuffer[Index].Get();
+        if (Transaction.GetContext().TransactionId
+            == InTransactionContext.TransactionId)
+        {
+            CountTransaction(Transaction);
+            return;
+        }
+    }
+}
+
+void FDialogueEditor::CountExistingTransactions()
+{
+    UTransBuffer* TransBuffer =
+        GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+
+    if (!TransBuffer)
+    {
+        return;
+    }
+
+    for (const TSharedRef<FTransaction>& Transaction : TransBuffer->UndoBuffer)
+    {
+        CountTransaction(Transaction.Get());
+    }
+}
+
+void FDialogueEditor::CountTransaction(const FTransaction& InTransaction)
+{
+    if (!TargetDialogue)
+    {
+        return;
+    }
+
+    //Only transactions recording anything in the dialogue's package count
+    const UPackage* DialoguePackage = TargetDialogue->GetOutermost();
+    TArray<UObject*> TransactionObjects;
+    InTransaction.GetTransactionObjects(TransactionObjects);
+
+    for (UObject* Object : TransactionObjects)
+    {
+        if (Object && Object->GetOutermost() == DialoguePackage)
+        {
+            const SIZE_T Size = InTransaction.DataSize();
+            CountedTransactions.Emplace(
+                InTransaction.GetContext().TransactionId,
+                Size
+            );
+            TransactionBufferSize += Size;
+            INC_MEMORY_STAT_BY(STAT_DialogueTransactionBuffer, Size);
+            return;
+        }
+    }
+}
+
+void FDialogueEditor::PruneCountedTransactions()
+{
+    UTransBuffer* TransBuffer =
+        GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+
+    if (!TransBuffer)
+    {
+        return;
+    }
+
+    //The buffer only ever loses transactions from its ends: the oldest
+    //when it fills up, and undone ones when a new transaction starts. So
+    //only the ends of the counted list need checking.
+    SIZE_T RemovedSize = 0;
+    while (!CountedTransactions.IsEmpty() && TransBuffer->FindTransactionIndex(
+        CountedTransactions[0].Key) == INDEX_NONE)
+    {
+        RemovedSize += CountedTransactions[0].Value;
+        CountedTransactions.RemoveAt(0);
+    }
+
+    while (!CountedTransactions.IsEmpty() && TransBuffer->FindTransactionIndex(
+        CountedTransactions.Last().Key) == INDEX_NONE)
+    {
+        RemovedSize += CountedTransactions.Last().Value;
+        CountedTransactions.Pop();
+    }
+
+    TransactionBufferSize -= RemovedSize;
+    DEC_MEMORY_STAT_BY(STAT_DialogueTransactionBuffer, RemovedSize);
+}
+
+FText FDialogueEditor::GetTransactionBufferText() const
+{
+    return FText::Format(
+        LOCTEXT("TransactionBufferText", "Undo Memory: {0}"),
+        FText::AsMemory(TransactionBufferSize)
+    );
+}
+
 void FDialogueEditor::RegisterCommands()
 {
     //Don't double register commands
@@ -963,6 +1388,12 @@ bool FDialogueEditor::CanCutNodes() const
 
 void FDialogueEditor::OnChangeSelection(const TSet<UObject*>& SelectedObjects)
 {
+    //Details panel may not be built yet
+    if (!NodeDetailsWidget.IsValid())
+    {
+        return;
+    }
+
     //If none selected, clear details panel
     if (SelectedObjects.Num() < 1)
     {
@@ -4,7 +4,11 @@
 #include "DialogueTreeEditorModule.h"
 //UE
 #include "AssetToolsModule.h"
+#include "Framework/Docking/TabManager.h"
 #include "IAssetTypeActions.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 //Plugin
 #include "CustomDetails/DialogueGraphCustomization.h"
 #include "CustomDetails/DialogueGraphConditionCustomization.h"
@@ -15,6 +19,7 @@
 #include "DialogueNodeSocket.h"
 #include "DialogueSpeakerSocket.h"
 #include "DialogueTreeStyle.h"
+#include "Graph/DialogueClassCatalog.h"
 #include "Graph/DialogueEdGraph.h"
 #include "Graph/DialogueGraphCondition.h"
 #include "Graph/DialogueTreeNodeFactory.h"
@@ -23,24 +28,31 @@
 #include "Graph/Nodes/GraphNodeDialogueSpeech.h"
 #include "Graph/PickableDialogueNode.h"
 #include "Graph/PickableDialogueSpeaker.h"
+#include "Search/DialogueSearchIndex.h"
+#include "Search/SDialogueSearch.h"
 
 #define LOCTEXT_NAMESPACE "FDialogueTreeEditorModule"
 
 void FDialogueTreeEditorModule::StartupModule()
 {
 	RegisterNodeFactory();
+	FDialogueClassCatalog::Initialize();
 	RegisterAssets();
 	RegisterDetailsCustomizers();
 
 	//Register Style Set
 	FDialogueTreeStyle::Initialize();
+
+	RegisterSearch();
 }
 
 void FDialogueTreeEditorModule::ShutdownModule()
 {
 	UnregisterNodeFactory();
+	FDialogueClassCatalog::Shutdown();
 	UnregisterAssets();
 	UnregisterDetailsCustomizers();
+	UnregisterSearch();
 
 	// Unregister Style Set
 	FDialogueTreeStyle::Shutdown();
@@ -127,6 +139,32 @@ void FDialogueTreeEditorModule::RegisterDetailsCustomizers()
 	);
 }
 
+void FDialogueTreeEditorModule::RegisterSearch()
+{
+	FDialogueSearchIndex::Initialize();
+
+	//Spawn the search panel from the Tools menu
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
+		SDialogueSearch::TabID,
+		FOnSpawnTab::CreateLambda(
+			[](const FSpawnTabArgs& Args)
+			{
+				return SNew(SDockTab)
+					.TabRole(ETabRole::NomadTab)
+					[
+						SNew(SDialogueSearch)
+					];
+			}
+		)
+	)
+	.SetDisplayName(LOCTEXT("DialogueSearchTabTitle", "Dialogue Search"))
+	.SetTooltipText(LOCTEXT(
+		"DialogueSearchTabTooltip",
+		"Search the text, speakers, events and conditions of every dialogue."
+	))
+	.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
 void FDialogueTreeEditorModule::UnregisterNodeFactory()
 {
 	if (NodeFactory.IsValid())
@@ -196,6 +234,18 @@ void FDialogueTreeEditorModule::UnregisterDetailsCustomizers()
 	}
 }
 
+void FDialogueTreeEditorModule::UnregisterSearch()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(
+			SDialogueSearch::TabID
+		);
+	}
+
+	FDialogueSearchIndex::Shutdown();
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FDialogueTreeEditorModule, DialogueTreeEditor)
\ No newline at end of file
@@ -0,0 +1,131 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Graph/DialogueClassCatalog.h"
+//UE
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "UObject/UObjectHash.h"
+
+//Init the catalog to be empty
+TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<UClass>>>
+	FDialogueClassCatalog::CachedClasses;
+FDelegateHandle FDialogueClassCatalog::ReloadCompleteHandle;
+FDelegateHandle FDialogueClassCatalog::BlueprintCompiledHandle;
+FDelegateHandle FDialogueClassCatalog::AssetLoadedHandle;
+
+void FDialogueClassCatalog::Initialize()
+{
+	//Hot reload and live coding
+	ReloadCompleteHandle = 
+		FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda(
+			[](EReloadCompleteReason Reason)
+			{
+				Invalidate();
+			}
+		);
+
+	//Newly loaded Blueprint classes
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddStatic(
+		&FDialogueClassCatalog::OnAssetLoaded
+	);
+
+	//Newly created or recompiled Blueprint classes
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddStatic(
+			&FDialogueClassCatalog::Invalidate
+		);
+	}
+}
+
+void FDialogueClassCatalog::Shutdown()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(
+		ReloadCompleteHandle
+	);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	ReloadCompleteHandle.Reset();
+	AssetLoadedHandle.Reset();
+	BlueprintCompiledHandle.Reset();
+
+	Invalidate();
+}
+
+void FDialogueClassCatalog::GetClasses(UClass* BaseClass,
+	TArray<UClass*>& OutClasses)
+{
+	check(BaseClass);
+
+	TArray<TWeakObjectPtr<UClass>>* FoundClasses =
+		CachedClasses.Find(BaseClass);
+	if (FoundClasses == nullptr)
+	{
+		FoundClasses = &CachedClasses.Add(BaseClass);
+		BuildClassList(BaseClass, *FoundClasses);
+	}
+
+	OutClasses.Reset(FoundClasses->Num());
+	for (const TWeakObjectPtr<UClass>& FoundClass : *FoundClasses)
+	{
+		if (FoundClass.IsValid())
+		{
+			OutClasses.Add(FoundClass.Get());
+		}
+	}
+}
+
+void FDialogueClassCatalog::Invalidate()
+{
+	CachedClasses.Empty();
+}
+
+void FDialogueClassCatalog::BuildClassList(UClass* BaseClass,
+	TArray<TWeakObjectPtr<UClass>>& OutClasses)
+{
+	TArray<UClass*> DerivedClasses;
+	GetDerivedClasses(BaseClass, DerivedClasses, true);
+	DerivedClasses.Insert(BaseClass, 0);
+
+	//Only keep classes which can actually be instanced
+	DerivedClasses.RemoveAll(
+		[](const UClass* InClass)
+		{
+			const FString ClassName = InClass->GetName();
+			return InClass->HasAnyClassFlags(
+					CLASS_Abstract
+					| CLASS_Deprecated
+					| CLASS_NewerVersionExists
+				)
+				|| ClassName.StartsWith(TEXT("SKEL_"))
+				|| ClassName.StartsWith(TEXT("REINST_"));
+		}
+	);
+
+	DerivedClasses.Sort(
+		[](const UClass& A, const UClass& B)
+		{
+			return A.GetName() < B.GetName();
+		}
+	);
+
+	OutClasses.Reset(DerivedClasses.Num());
+	for (UClass* DerivedClass : DerivedClasses)
+	{
+		OutClasses.Add(DerivedClass);
+	}
+}
+
+void FDialogueClassCatalog::OnAssetLoaded(UObject* InObject)
+{
+	if (InObject && InObject->IsA<UBlueprint>())
+	{
+		Invalidate();
+	}
+}
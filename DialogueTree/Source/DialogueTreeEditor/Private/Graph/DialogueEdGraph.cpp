@@ -23,15 +23,13 @@ UDialogueEdGraph::UDialogueEdGraph()
 
 bool UDialogueEdGraph::Modify(bool bAlwaysMarkDirty)
 {
-	bool ModifyReturnValue = Super::Modify(bAlwaysMarkDirty);
-	GetDialogue()->Modify();
-
-	for (UEdGraphNode* Node : Nodes)
-	{
-		Node->Modify();
-	}
-
-	return ModifyReturnValue;
+	/**
+	* Only the graph itself is recorded here. Nodes are expected to be 
+	* modified individually by whichever action touches them (pin link
+	* changes, moves, deletes etc.), so that a single edit does not 
+	* snapshot the entire graph into the transaction buffer. 
+	*/
+	return Super::Modify(bAlwaysMarkDirty);
 }
 
 void UDialogueEdGraph::PostEditUndo()
@@ -13,6 +13,7 @@
 #include "Dialogue.h"
 #include "DialogueEditor.h"
 #include "DialogueSpeakerSocket.h"
+#include "Graph/DialogueClassCatalog.h"
 #include "Graph/DialogueEdGraph.h"
 #include "Graph/DialogueTreeConnectionDrawingPolicy.h"
 #include "Graph/Nodes/GraphNodeDialogueBranch.h"
@@ -51,14 +52,34 @@ FNewDialogueNodeAction::FNewDialogueNodeAction(FText InNodeCategory,
 	check(TemplateNode);
 }
 
+FNewDialogueNodeAction::FNewDialogueNodeAction(FText InNodeCategory, 
+	FText InMenuDesc, FText InToolTip, FCreateTemplateNode InTemplateFactory)
+	: FEdGraphSchemaAction(
+		MoveTemp(InNodeCategory), 
+		MoveTemp(InMenuDesc),
+		MoveTemp(InToolTip), 
+		0)
+	, TemplateNode(nullptr)
+	, TemplateFactory(MoveTemp(InTemplateFactory))
+{
+	check(TemplateFactory);
+}
+
 
 UEdGraphNode* FNewDialogueNodeAction::PerformAction(UEdGraph* ParentGraph,
 	UEdGraphPin* FromPin, const FVector2D Location, bool bSelectNewNode)
 {
+	//Begin transaction 
+	FScopedTransaction Transaction(LOCTEXT("AddNode", "Add node"));
+
+	//Create the node now that it is actually wanted 
+	if (TemplateFactory)
+	{
+		TemplateNode = TemplateFactory(ParentGraph);
+	}
+
 	if (TemplateNode != nullptr)
 	{
-		//Begin transaction 
-		const FScopedTransaction Transaction(LOCTEXT("AddNode", "Add node"));
 		ParentGraph->Modify();
 		if (FromPin)
 		{
@@ -73,6 +94,7 @@ UEdGraphNode* FNewDialogueNodeAction::PerformAction(UEdGraph* ParentGraph,
 	}
 
 	//No result node was created 
+	Transaction.Cancel();
 	return nullptr;
 }
 
@@ -433,6 +455,13 @@ void UDialogueEdGraphSchema::GetSpeechNodeMenuActions(
 		return;
 	}
 
+	//Fetch the transition types once for all speakers 
+	TArray<UClass*> TransitionTypes;
+	FDialogueClassCatalog::GetClasses(
+		UDialogueTransition::StaticClass(), 
+		TransitionTypes
+	);
+
 	//Loop through the list of speakers 
 	for (UDialogueSpeakerSocket* Speaker : TargetGraph->GetAllSpeakers())
 	{
@@ -442,33 +471,22 @@ void UDialogueEdGraphSchema::GetSpeechNodeMenuActions(
 		}
 
 		//Add one create node action for each transition type 
-		for (TObjectIterator<UClass> TypeIterator; TypeIterator; ++TypeIterator)
+		for (UClass* TransitionType : TransitionTypes)
 		{
-			if (TypeIterator->IsChildOf(UDialogueTransition::StaticClass())
-				&& !TypeIterator->HasAnyClassFlags(CLASS_Abstract))
-			{
-				TSubclassOf<UDialogueTransition> CurrentType =
-					*TypeIterator;
-
-				TSharedPtr<FNewDialogueNodeAction> NewNodeAction =
-					MakeCreateSpeechNodeAction(
-						Speaker,
-						CurrentType,
-						ContextMenuBuilder.OwnerOfTemporaries
-					);
-				
-				//Create action and add to menu 
-				ContextMenuBuilder.AddAction(NewNodeAction);
-			}
+			TSharedPtr<FNewDialogueNodeAction> NewNodeAction =
+				MakeCreateSpeechNodeAction(Speaker, TransitionType);
+			
+			//Create action and add to menu 
+			ContextMenuBuilder.AddAction(NewNodeAction);
 		}
 	}
 }
 
 TSharedPtr<FNewDialogueNodeAction> UDialogueEdGraphSchema::
 	MakeCreateSpeechNodeAction(UDialogueSpeakerSocket* Speaker, 
-		TSubclassOf<UDialogueTransition> TransitionType, UObject* Outer) const
+		TSubclassOf<UDialogueTransition> TransitionType) const
 {
-	check(Speaker && TransitionType && Outer);
+	check(Speaker && TransitionType);
 
 	//Get context menu text
 	UDialogueTransition* DefaultTransitionObj =
@@ -484,10 +502,23 @@ TSharedPtr<FNewDialogueNodeAction> UDialogueEdGraphSchema::
 	FText MenuTooltip =
 		DefaultTransitionObj->GetNodeCreationTooltip();
 
-	//Get template node
-	UGraphNodeDialogueSpeech* TemplateObject =
-		UGraphNodeDialogueSpeech::MakeTemplate(Outer, Speaker, TransitionType);
-	check(TemplateObject);
+	//Only build the node if the action is chosen 
+	TWeakObjectPtr<UDialogueSpeakerSocket> WeakSpeaker = Speaker;
+	FCreateTemplateNode TemplateFactory = 
+		[WeakSpeaker, TransitionType](UEdGraph* InGraph) 
+		-> UGraphNodeDialogue*
+		{
+			if (!WeakSpeaker.IsValid() || !TransitionType)
+			{
+				return nullptr;
+			}
+
+			return UGraphNodeDialogueSpeech::MakeTemplate(
+				InGraph, 
+				WeakSpeaker.Get(), 
+				TransitionType
+			);
+		};
 
 	//Assemble action 
 	TSharedPtr<FNewDialogueNodeAction> NewAction(
@@ -495,7 +526,7 @@ TSharedPtr<FNewDialogueNodeAction> UDialogueEdGraphSchema::
 			MenuCategory,
 			MenuText,
 			MenuTooltip,
-			TemplateObject
+			MoveTemp(TemplateFactory)
 		)
 	);
 
@@ -625,6 +656,17 @@ void UDialogueEdGraphSchema::GetOptionLockNodeMenuActions(
 void UDialogueEdGraphSchema::BreakPinLinksContextMenu(
 	UEdGraphPin* TargetPin) const
 {
+	//Record only the nodes whose links are actually broken
+	const FScopedTransaction Transaction(
+		LOCTEXT("BreakPinLinks", "Break Pin Links")
+	);
+	check(TargetPin);
+	TargetPin->Modify();
+	for (UEdGraphPin* LinkedPin : TargetPin->LinkedTo)
+	{
+		LinkedPin->Modify();
+	}
+
 	BreakPinLinks(*TargetPin, true);
 }
 
@@ -5,6 +5,10 @@
 //Plugin
 #include "DialogueTreeStyle.h"
 
+TMap<TPair<const UEdGraphPin*, const UEdGraphPin*>,
+	FDialogueTreeConnectionDrawingPolicy::FSplineGeometry>
+	FDialogueTreeConnectionDrawingPolicy::SplineCache;
+
 FDialogueTreeConnectionDrawingPolicy::FDialogueTreeConnectionDrawingPolicy(
 	int32 InBackLayerID, int32 InFrontLayerID, float InZoomFactor, 
 	const FSlateRect& InClippingRect, FSlateWindowElementList& InDrawElements)
@@ -46,6 +50,19 @@ FDialogueTreeConnectionDrawingPolicy::FDialogueTreeConnectionDrawingPolicy(
 		Settings->BackwardSplineTangentFromHorizontalDelta.X;
 }
 
+void FDialogueTreeConnectionDrawingPolicy::Draw(
+	TMap<TSharedRef<SWidget>, FArrangedWidget>& InPinGeometries,
+	FArrangedChildren& ArrangedNodes)
+{
+	FConnectionDrawingPolicy::Draw(InPinGeometries, ArrangedNodes);
+
+	//Periodically drop connections that are no longer being drawn
+	if (GFrameCounter % SPLINE_CACHE_LIFETIME == 0)
+	{
+		PruneSplineCache();
+	}
+}
+
 void FDialogueTreeConnectionDrawingPolicy::DrawPreviewConnector(
 	const FGeometry& PinGeometry, const FVector2D& StartPoint,
 	const FVector2D& EndPoint, UEdGraphPin* Pin)
@@ -75,43 +92,33 @@ void FDialogueTreeConnectionDrawingPolicy::DrawSplineWithArrow(
 	const FVector2D& StartPoint, const FVector2D& EndPoint, 
 	const FConnectionParams& Params)
 {
+	const FSplineGeometry& Spline =
+		GetSplineGeometry(StartPoint, EndPoint, Params);
+
+	//Skip connections that are entirely off screen
+	const FSlateRect SplineBounds(
+		StartPoint + Spline.BoundsMin, 
+		StartPoint + Spline.BoundsMax
+	);
+	if (!FSlateRect::DoRectanglesIntersect(SplineBounds, ClippingRect))
+	{
+		return;
+	}
+
 	// Draw the spline
+	CurrentSpline = &Spline;
 	DrawConnection(
 		WireLayerID,
 		StartPoint,
 		EndPoint,
 		Params
 	);
+	CurrentSpline = nullptr;
 
 	// Draw the arrow
 	if (ArrowImage != nullptr)
 	{
-		FVector2D ArrowPoint = EndPoint - ArrowRadius;
-
-		/**
-		* Note: this is marked as deprecated, but Epic is still 
-		* using it in their connection drawing policies 
-		* and there doesn't appear to be a good alternative that 
-		* I can find. Leaving it in for now. 
-		*/
-		FPaintGeometry ArrowGeometry =
-			FPaintGeometry(
-				ArrowPoint,
-				ArrowImage->ImageSize * ZoomFactor,
-				ZoomFactor
-			);
-
-		FSlateDrawElement::MakeRotatedBox(
-			DrawElementsList,
-			ArrowLayerID,
-			ArrowGeometry,
-			ArrowImage,
-			ESlateDrawEffect::None,
-			ARROW_ANGLE,
-			TOptional<FVector2D>(),
-			FSlateDrawElement::RelativeToElement,
-			Params.WireColor
-		);
+		DrawArrow(EndPoint - ArrowRadius, Params.WireColor);
 	}
 }
 
@@ -141,6 +148,12 @@ FVector2D FDialogueTreeConnectionDrawingPolicy::ComputeSplineTangent(
 	//Calculate delta 
 	const FVector2D DeltaPos = End - Start;
 
+	//Reuse the tangent already calculated for the spline being drawn
+	if (CurrentSpline && CurrentSpline->DeltaPos == DeltaPos)
+	{
+		return CurrentSpline->Tangent;
+	}
+
 	//Determine directionality
 	const FSplineShape Shape = GetSplineShape(DeltaPos);
 
@@ -207,4 +220,113 @@ FDialogueTreeConnectionDrawingPolicy::FSplineShape
 	}
 
 	return Shape;
+}
+
+const FDialogueTreeConnectionDrawingPolicy::FSplineGeometry&
+	FDialogueTreeConnectionDrawingPolicy::GetSplineGeometry(
+		const FVector2D& StartPoint, const FVector2D& EndPoint,
+		const FConnectionParams& Params)
+{
+	//Without both pins there is nothing to key the cache on
+	if (!Params.AssociatedPin1 || !Params.AssociatedPin2)
+	{
+		CalculateSplineGeometry(StartPoint, EndPoint, UncachedSpline);
+		return UncachedSpline;
+	}
+
+	const TPair<const UEdGraphPin*, const UEdGraphPin*> ConnectionKey(
+		Params.AssociatedPin1,
+		Params.AssociatedPin2
+	);
+
+	//Recalculate only if new, if either endpoint moved, or on zoom
+	FSplineGeometry* Spline = SplineCache.Find(ConnectionKey);
+	if (!Spline)
+	{
+		Spline = &SplineCache.Add(ConnectionKey);
+		CalculateSplineGeometry(StartPoint, EndPoint, *Spline);
+	}
+	else if (Spline->DeltaPos != EndPoint - StartPoint
+		|| Spline->ZoomFactor != ZoomFactor)
+	{
+		CalculateSplineGeometry(StartPoint, EndPoint, *Spline);
+	}
+
+	Spline->LastUsedFrame = GFrameCounter;
+	return *Spline;
+}
+
+void FDialogueTreeConnectionDrawingPolicy::CalculateSplineGeometry(
+	const FVector2D& StartPoint, const FVector2D& EndPoint, 
+	FSplineGeometry& OutSpline) const
+{
+	OutSpline.DeltaPos = EndPoint - StartPoint;
+	OutSpline.ZoomFactor = ZoomFactor;
+	OutSpline.Tangent = ComputeSplineTangent(StartPoint, EndPoint);
+
+	/**
+	* The spline lies within the hull of its bezier control points, 
+	* which for a hermite spline sit a third of the tangent in from 
+	* either end. 
+	*/
+	const FVector2D ControlA = OutSpline.Tangent / 3.f;
+	const FVector2D ControlB = OutSpline.DeltaPos - OutSpline.Tangent / 3.f;
+
+	FVector2D BoundsMin = FVector2D::Min(
+		FVector2D::Min(FVector2D::ZeroVector, OutSpline.DeltaPos),
+		FVector2D::Min(ControlA, ControlB)
+	);
+	FVector2D BoundsMax = FVector2D::Max(
+		FVector2D::Max(FVector2D::ZeroVector, OutSpline.DeltaPos),
+		FVector2D::Max(ControlA, ControlB)
+	);
+
+	//Pad for wire thickness and the arrow
+	const FVector2D Padding = 
+		ArrowRadius + FVector2D(SPLINE_CULL_PADDING * ZoomFactor);
+
+	OutSpline.BoundsMin = BoundsMin - Padding;
+	OutSpline.BoundsMax = BoundsMax + Padding;
+}
+
+void FDialogueTreeConnectionDrawingPolicy::DrawArrow(
+	const FVector2D& ArrowPoint, const FLinearColor& ArrowColor)
+{
+	check(ArrowImage);
+
+	/**
+	* Note: this is marked as deprecated, but Epic is still 
+	* using it in their connection drawing policies 
+	* and there doesn't appear to be a good alternative that 
+	* I can find. Leaving it in for now. 
+	*/
+	FPaintGeometry ArrowGeometry =
+		FPaintGeometry(
+			ArrowPoint,
+			ArrowImage->ImageSize * ZoomFactor,
+			ZoomFactor
+		);
+
+	FSlateDrawElement::MakeRotatedBox(
+		DrawElementsList,
+		ArrowLayerID,
+		ArrowGeometry,
+		ArrowImage,
+		ESlateDrawEffect::None,
+		ARROW_ANGLE,
+		TOptional<FVector2D>(),
+		FSlateDrawElement::RelativeToElement,
+		ArrowColor
+	);
+}
+
+void FDialogueTreeConnectionDrawingPolicy::PruneSplineCache()
+{
+	for (auto It = SplineCache.CreateIterator(); It; ++It)
+	{
+		if (GFrameCounter - It.Value().LastUsedFrame > SPLINE_CACHE_LIFETIME)
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Dialogue.h"
 #include "Graph/DialogueEdGraph.h"
 #include "Nodes/DialogueNode.h"
+#include "Search/DialogueSearchIndex.h"
 
 #define LOCTEXT_NAMESPACE "DialogueEdGraph"
 
@@ -66,6 +67,16 @@ void UGraphNodeDialogue::ResizeNode(const FVector2D& NewSize)
 	NodeHeight = NewSize.Y;
 }
 
+void UGraphNodeDialogue::GetSearchEntries(
+	TArray<FDialogueSearchEntry>& OutEntries) const
+{
+	OutEntries.Add(FDialogueSearchEntry(
+		ID, 
+		EDialogueSearchField::NodeID, 
+		ID.ToString()
+	));
+}
+
 FName UGraphNodeDialogue::GetID() const
 {
 	return ID;
@@ -228,7 +239,8 @@ void UGraphNodeDialogue::AssignAssetNodeID() const
 	AssetNode->SetNodeID(ID);
 }
 
-void UGraphNodeDialogue::InitNodeInDialogueGraph(UEdGraph* OwningGraph)
+void UGraphNodeDialogue::InitNodeInDialogueGraph(UEdGraph* OwningGraph,
+	FName InBaseID)
 {
 	check(OwningGraph);
 	DialogueGraph = CastChecked<UDialogueEdGraph>(OwningGraph);
@@ -236,7 +248,7 @@ void UGraphNodeDialogue::InitNodeInDialogueGraph(UEdGraph* OwningGraph)
 
 	//Set initial ID
 	int32 Counter = 1;
-	FName BaseID = GetBaseID();
+	FName BaseID = InBaseID.IsNone() ? GetBaseID() : InBaseID;
 	FText IDText = FText::FromName(BaseID);
 
 	//Increment number until ID is unique 
@@ -10,6 +10,7 @@
 #include "Graph/DialogueGraphCondition.h"
 #include "Graph/Nodes/GraphNodeDialogue.h"
 #include "Nodes/DialogueBranchNode.h"
+#include "Search/DialogueSearchIndex.h"
 
 #define LOCTEXT_NAMESPACE "GraphNodeDialogueBranch"
 
@@ -137,6 +138,29 @@ bool UGraphNodeDialogueBranch::CanCompileNode()
     return true;
 }
 
+void UGraphNodeDialogueBranch::GetSearchEntries(
+    TArray<FDialogueSearchEntry>& OutEntries) const
+{
+    Super::GetSearchEntries(OutEntries);
+
+    for (UDialogueGraphCondition* GraphCondition : Conditions)
+    {
+        if (GraphCondition == nullptr)
+        {
+            continue;
+        }
+
+        if (UDialogueQuery* Query = GraphCondition->GetQuery())
+        {
+            OutEntries.Add(FDialogueSearchEntry(
+                GetID(),
+                EDialogueSearchField::ConditionClass,
+                Query->GetClass()->GetName()
+            ));
+        }
+    }
+}
+
 bool UGraphNodeDialogueBranch::GetIfAny() const
 {
     return bIfAny;
@@ -174,6 +198,25 @@ TArray<FText> UGraphNodeDialogueBranch::GetConditionDisplayTexts() const
     return ConditionTexts;
 }
 
+const TArray<TObjectPtr<UDialogueGraphCondition>>& 
+    UGraphNodeDialogueBranch::GetGraphConditions() const
+{
+    return Conditions;
+}
+
+void UGraphNodeDialogueBranch::SetGraphConditions(
+    const TArray<UDialogueGraphCondition*>& InConditions)
+{
+    Conditions.Empty(InConditions.Num());
+    for (UDialogueGraphCondition* NewCondition : InConditions)
+    {
+        if (NewCondition)
+        {
+            Conditions.Add(NewCondition);
+        }
+    }
+}
+
 UDialogueNode* UGraphNodeDialogueBranch::GetTrueNode(
     TArray<UEdGraphPin*>& OutputPins) const
 {
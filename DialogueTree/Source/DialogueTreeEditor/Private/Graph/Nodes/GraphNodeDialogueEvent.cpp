@@ -9,6 +9,7 @@
 #include "Events/ResetNodeVisits.h"
 #include "Graph/DialogueEdGraph.h"
 #include "Nodes/DialogueEventNode.h"
+#include "Search/DialogueSearchIndex.h"
 
 #define LOCTEXT_NAMESPACE "GraphNodeDialogueEvent"
 
@@ -111,6 +112,12 @@ void UGraphNodeDialogueEvent::FinalizeAssetNode()
 	}
 
 	TargetNode->SetEvents(FinalEvents);
+
+	TArray<TArray<int32>> Dependencies;
+	if (ResolveEventDependencies(Dependencies))
+	{
+		TargetNode->SetEventDependencies(Dependencies);
+	}
 }
 
 bool UGraphNodeDialogueEvent::CanCompileNode()
@@ -125,6 +132,13 @@ bool UGraphNodeDialogueEvent::CanCompileNode()
 		}
 	}
 
+	TArray<TArray<int32>> Dependencies;
+	if (!ResolveEventDependencies(Dependencies))
+	{
+		SetErrorFlag(true);
+		return false;
+	}
+
 	SetErrorFlag(false);
 	return true;
 }
@@ -134,6 +148,24 @@ FName UGraphNodeDialogueEvent::GetBaseID() const
 	return FName("Event");
 }
 
+void UGraphNodeDialogueEvent::GetSearchEntries(
+	TArray<FDialogueSearchEntry>& OutEntries) const
+{
+	Super::GetSearchEntries(OutEntries);
+
+	for (const FGraphDialogueEvent& Event : Events)
+	{
+		if (Event.Event)
+		{
+			OutEntries.Add(FDialogueSearchEntry(
+				GetID(),
+				EDialogueSearchField::EventClass,
+				Event.Event->GetClass()->GetName()
+			));
+		}
+	}
+}
+
 TArray<FText> UGraphNodeDialogueEvent::GetGraphDescriptions() const
 {
 	TArray<FText> EventTexts;
@@ -189,4 +221,81 @@ void UGraphNodeDialogueEvent::FinalizeNodeSocket(UDialogueEventBase* InEvent)
 	TargetSocket->SetDialogueNode(GraphNode->GetAssetNode());
 }
 
+bool UGraphNodeDialogueEvent::ResolveEventDependencies(
+	TArray<TArray<int32>>& OutDependencies) const
+{
+	//Map names to compiled event indices
+	TMap<FName, int32> NamedEvents;
+	int32 NumEvents = 0;
+	for (const FGraphDialogueEvent& Event : Events)
+	{
+		if (!Event.Event)
+		{
+			continue;
+		}
+
+		if (!Event.EventName.IsNone())
+		{
+			if (NamedEvents.Contains(Event.EventName))
+			{
+				return false;
+			}
+			NamedEvents.Add(Event.EventName, NumEvents);
+		}
+		++NumEvents;
+	}
+
+	//Resolve each event's dependencies
+	OutDependencies.Reset(NumEvents);
+	for (const FGraphDialogueEvent& Event : Events)
+	{
+		if (!Event.Event)
+		{
+			continue;
+		}
+
+		TArray<int32>& Dependencies = OutDependencies.AddDefaulted_GetRef();
+		for (const FName& StartAfterName : Event.StartAfter)
+		{
+			const int32* Dependency = NamedEvents.Find(StartAfterName);
+			if (!Dependency)
+			{
+				return false;
+			}
+			Dependencies.AddUnique(*Dependency);
+		}
+	}
+
+	//Verify the events can all start by peeling off those that are ready
+	TArray<int32> RemainingDependencies;
+	RemainingDependencies.Reserve(NumEvents);
+	TArray<int32> ReadyEvents;
+	for (int32 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
+	{
+		RemainingDependencies.Add(OutDependencies[EventIndex].Num());
+		if (OutDependencies[EventIndex].IsEmpty())
+		{
+			ReadyEvents.Add(EventIndex);
+		}
+	}
+
+	int32 NumStarted = 0;
+	while (!ReadyEvents.IsEmpty())
+	{
+		const int32 ReadyEvent = ReadyEvents.Pop();
+		++NumStarted;
+
+		for (int32 EventIndex = 0; EventIndex < NumEvents; ++EventIndex)
+		{
+			if (OutDependencies[EventIndex].Contains(ReadyEvent)
+				&& --RemainingDependencies[EventIndex] == 0)
+			{
+				ReadyEvents.Add(EventIndex);
+			}
+		}
+	}
+
+	return NumStarted == NumEvents;
+}
+
 #undef LOCTEXT_NAMESPACE
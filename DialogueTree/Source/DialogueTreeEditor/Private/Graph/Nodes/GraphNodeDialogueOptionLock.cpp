@@ -9,6 +9,7 @@
 #include "Graph/DialogueEdGraph.h"
 #include "Graph/DialogueGraphCondition.h"
 #include "Nodes/DialogueOptionLockNode.h"
+#include "Search/DialogueSearchIndex.h"
 
 #define LOCTEXT_NAMESPACE "GraphNodeDialogueOptionLock"
 
@@ -97,7 +98,15 @@ void UGraphNodeDialogueOptionLock::FinalizeAssetNode()
         bIfAny, 
         AssetConditions, 
         LockedMessage,
-        UnlockedMessage
+        UnlockedMessage,
+        TargetDialogue->CompileText(
+            LockedMessage, 
+            GetID().ToString() + TEXT(".LockedMessage")
+        ),
+        TargetDialogue->CompileText(
+            UnlockedMessage, 
+            GetID().ToString() + TEXT(".UnlockedMessage")
+        )
     );
 }
 
@@ -118,6 +127,29 @@ bool UGraphNodeDialogueOptionLock::CanCompileNode()
     return true;
 }
 
+void UGraphNodeDialogueOptionLock::GetSearchEntries(
+    TArray<FDialogueSearchEntry>& OutEntries) const
+{
+    Super::GetSearchEntries(OutEntries);
+
+    for (UDialogueGraphCondition* GraphCondition : Conditions)
+    {
+        if (GraphCondition == nullptr)
+        {
+            continue;
+        }
+
+        if (UDialogueQuery* Query = GraphCondition->GetQuery())
+        {
+            OutEntries.Add(FDialogueSearchEntry(
+                GetID(),
+                EDialogueSearchField::ConditionClass,
+                Query->GetClass()->GetName()
+            ));
+        }
+    }
+}
+
 bool UGraphNodeDialogueOptionLock::GetIfAny() const
 {
     return bIfAny;
@@ -9,6 +9,7 @@
 #include "Graph/DialogueEdGraph.h"
 #include "Graph/DialogueEdGraphSchema.h"
 #include "Nodes/DialogueSpeechNode.h"
+#include "Search/DialogueSearchIndex.h"
 #include "SpeechDetails.h"
 #include "Transitions/InputDialogueTransition.h"
 
@@ -123,10 +124,16 @@ void UGraphNodeDialogueSpeech::CreateAssetNode(UDialogue* InAsset)
     SpeechDetails.SpeechText = SpeechText;
     SpeechDetails.SpeechAudio = SpeechAudio;
     SpeechDetails.MinimumPlayTime = MinimumPlayTime;
+    SpeechDetails.Cooldown = Cooldown;
     SpeechDetails.bCanSkip = bCanSkip;
     SpeechDetails.GameplayTags = GameplayTags;
 
-    NewNode->InitSpeechData(SpeechDetails, TransitionType);
+    NewNode->InitSpeechData(
+        SpeechDetails, 
+        TransitionType, 
+        InAsset->CompileText(SpeechText, GetID().ToString())
+    );
+    NewNode->SetSpeakerSlot(InAsset->GetSpeakerSlot(SpeechDetails.SpeakerName));
 }
 
 bool UGraphNodeDialogueSpeech::CanCompileNode()
@@ -154,6 +161,30 @@ bool UGraphNodeDialogueSpeech::CanCompileNode()
     return false;
 }
 
+void UGraphNodeDialogueSpeech::GetSearchEntries(
+    TArray<FDialogueSearchEntry>& OutEntries) const
+{
+    Super::GetSearchEntries(OutEntries);
+
+    if (UDialogueSpeakerSocket* SpeakerSocket = GetSpeaker())
+    {
+        OutEntries.Add(FDialogueSearchEntry(
+            GetID(),
+            EDialogueSearchField::Speaker,
+            SpeakerSocket->GetSpeakerName().ToString()
+        ));
+    }
+
+    if (!SpeechText.IsEmpty())
+    {
+        OutEntries.Add(FDialogueSearchEntry(
+            GetID(),
+            EDialogueSearchField::SpeechText,
+            SpeechText.ToString()
+        ));
+    }
+}
+
 UClass* UGraphNodeDialogueSpeech::GetTransitionType() const
 {
     check(TransitionType);
@@ -180,6 +211,26 @@ UDialogueSpeakerSocket* UGraphNodeDialogueSpeech::GetSpeaker() const
     return nullptr;
 }
 
+void UGraphNodeDialogueSpeech::SetSpeechTitle(FName InTitle)
+{
+    SpeechTitle = InTitle;
+}
+
+void UGraphNodeDialogueSpeech::SetSpeechText(const FText& InText)
+{
+    SpeechText = InText;
+}
+
+USoundBase* UGraphNodeDialogueSpeech::GetSpeechAudio() const
+{
+    return SpeechAudio;
+}
+
+void UGraphNodeDialogueSpeech::SetSpeechAudio(USoundBase* InAudio)
+{
+    SpeechAudio = InAudio;
+}
+
 void UGraphNodeDialogueSpeech::SetTransitionType(
     TSubclassOf<UDialogueTransition> InType)
 {
@@ -16,6 +16,11 @@
 
 #define LOCTEXT_NAMESPACE "SGraphNodeDialogueBase"
 
+TArray<TWeakPtr<SGraphNodeDialogueBase>> SGraphNodeDialogueBase::QueuedLayouts;
+FTSTicker::FDelegateHandle SGraphNodeDialogueBase::QueuedLayoutsHandle;
+uint64 SGraphNodeDialogueBase::LayoutBudgetFrame = 0;
+int32 SGraphNodeDialogueBase::LayoutsBuiltThisFrame = 0;
+
 void SGraphNodeDialogueBase::Construct(const FArguments& InArgs, 
 	UEdGraphNode* InNode)
 {
@@ -35,19 +40,27 @@ void SGraphNodeDialogueBase::Construct(const FArguments& InArgs,
 	);
 	DialogueNode->BindOnUpdateVisuals(UpdateDelegate);
 
-	//Build the visuals
-	UpdateGraphNode();
+	//Build the visuals, now or on a later frame
+	RequestLayoutBuild();
 }
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SGraphNodeDialogueBase::UpdateGraphNode()
 {
+	bLayoutPending = false;
+
 	//Clear and reset pins
 	InputPins.Empty();
 	OutputPins.Empty();
 	InputPinBox.Reset(); 
 	OutputPinBox.Reset();
 
+	//Header and content are rebuilt once the node is drawn on screen
+	HeaderBox.Reset();
+	ContentAreaBox.Reset();
+	bHeaderPending = true;
+	bContentAreaPending = true;
+
 	//Base Layout
 	TSharedRef<SOverlay> NodeLayout = SNew(SOverlay)
 		+ SOverlay::Slot()
@@ -57,6 +70,13 @@ void SGraphNodeDialogueBase::UpdateGraphNode()
 			.ColorAndOpacity(FColor::Black)
 		]
 		+ SOverlay::Slot()
+		[
+			SNew(SImage)
+			.Image(GetNodeBodyBrush())
+			.ColorAndOpacity(GraphNode->GetNodeTitleColor())
+			.Visibility(this, &SGraphNodeDialogueBase::GetFlatBoxVisibility)
+		]
+		+ SOverlay::Slot()
 		.Padding(0.f, GetInputPinYPadding(), 0.f, 0.f)
 		.VAlign(VAlign_Top)
 		.HAlign(HAlign_Center)
@@ -80,19 +100,21 @@ void SGraphNodeDialogueBase::UpdateGraphNode()
 		.HAlign(HAlign_Center)
 		.VAlign(VAlign_Center)
 		[
-			NodeLayout
+			SNew(SBox)
+			.MinDesiredWidth(this, &SGraphNodeDialogueBase::GetMinNodeWidth)
+			.MinDesiredHeight(this, &SGraphNodeDialogueBase::GetMinNodeHeight)
+			[
+				NodeLayout
+			]
 		];
 
 	//Create pin widgets
 	CreatePinWidgets();
 
-	if (DialogueNode)
+	//Rebuild right away if on screen, else wait until scrolled into view
+	if (OwnerGraphPanelPtr.IsValid() && WasRecentlyDrawn())
 	{
-		//Prepass to update desired sizes
-		SlatePrepass(GetPrepassLayoutScaleMultiplier());
-
-		//Resize dialogue node
-		DialogueNode->ResizeNode(GetDesiredSize());
+		BuildPendingWidgets(GetNodeLOD());
 	}
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -115,6 +137,16 @@ void SGraphNodeDialogueBase::SetOwner(const TSharedRef<SGraphPanel>& OwnerPanel)
 	}
 }
 
+void SGraphNodeDialogueBase::Tick(const FGeometry& AllottedGeometry, 
+	const double InCurrentTime, const float InDeltaTime)
+{
+	SGraphNode::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+	LastDrawnFrame = GFrameCounter;
+
+	//Build deferred widgets once visible and zoomed in far enough
+	BuildPendingWidgets(GetNodeLOD());
+}
+
 TSharedRef<SWidget> SGraphNodeDialogueBase::CreateNodeContentArea()
 {
 	return SNew(SSpacer).Size(DEFAULT_NODE_SIZE);
@@ -269,24 +301,212 @@ float SGraphNodeDialogueBase::GetOutputPinYPadding() const
 	return BASE_PIN_PUSH_AMOUNT;
 }
 
+EDialogueNodeLOD SGraphNodeDialogueBase::GetNodeLOD() const
+{
+	TSharedPtr<SGraphPanel> OwnerPanel = GetOwnerPanel();
+
+	//Not yet on a panel: assume full detail 
+	if (!OwnerPanel.IsValid())
+	{
+		return EDialogueNodeLOD::Full;
+	}
+
+	const EGraphRenderingLOD::Type CurrentLOD = OwnerPanel->GetCurrentLOD();
+
+	if (CurrentLOD <= EGraphRenderingLOD::LowestDetail)
+	{
+		return EDialogueNodeLOD::Flat;
+	}
+	else if (CurrentLOD <= EGraphRenderingLOD::LowDetail)
+	{
+		return EDialogueNodeLOD::Title;
+	}
+
+	return EDialogueNodeLOD::Full;
+}
+
 TSharedRef<SWidget> SGraphNodeDialogueBase::AssembleNodeContent()
 {
 	return SNew(SVerticalBox)
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		[
-			CreateHeaderWidget()
+			SAssignNew(HeaderBox, SBox)
+			.Visibility(this, &SGraphNodeDialogueBase::GetHeaderVisibility)
 		]
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		[
-			CreateNodeContentArea()
+			SAssignNew(ContentAreaBox, SBox)
+			.Visibility(this, &SGraphNodeDialogueBase::GetContentVisibility)
 		]
 		+ SVerticalBox::Slot()
 		.AutoHeight()
 		[
-			CreateErrorWidget()
+			SNew(SBox)
+			.Visibility(this, &SGraphNodeDialogueBase::GetHeaderVisibility)
+			[
+				CreateErrorWidget()
+			]
 		];
 }
 
+void SGraphNodeDialogueBase::BuildHeader()
+{
+	check(HeaderBox.IsValid());
+	HeaderBox->SetContent(CreateHeaderWidget());
+	bHeaderPending = false;
+}
+
+void SGraphNodeDialogueBase::BuildContentArea()
+{
+	check(ContentAreaBox.IsValid());
+	ContentAreaBox->SetContent(CreateNodeContentArea());
+	bContentAreaPending = false;
+}
+
+void SGraphNodeDialogueBase::RequestLayoutBuild()
+{
+	if (ConsumeLayoutBudget())
+	{
+		UpdateGraphNode();
+		return;
+	}
+
+	bLayoutPending = true;
+	QueuedLayouts.Add(SharedThis(this));
+
+	if (!QueuedLayoutsHandle.IsValid())
+	{
+		QueuedLayoutsHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateStatic(
+				&SGraphNodeDialogueBase::BuildQueuedLayouts
+			)
+		);
+	}
+}
+
+bool SGraphNodeDialogueBase::BuildQueuedLayouts(float DeltaTime)
+{
+	while (!QueuedLayouts.IsEmpty())
+	{
+		//Skip closed graphs and nodes already rebuilt by an update
+		TSharedPtr<SGraphNodeDialogueBase> Node = QueuedLayouts.Pop().Pin();
+		if (!Node.IsValid() || !Node->bLayoutPending)
+		{
+			continue;
+		}
+
+		if (!ConsumeLayoutBudget())
+		{
+			QueuedLayouts.Add(Node);
+			return true;
+		}
+
+		Node->UpdateGraphNode();
+	}
+
+	QueuedLayoutsHandle.Reset();
+	return false;
+}
+
+bool SGraphNodeDialogueBase::ConsumeLayoutBudget()
+{
+	if (LayoutBudgetFrame != GFrameCounter)
+	{
+		LayoutBudgetFrame = GFrameCounter;
+		LayoutsBuiltThisFrame = 0;
+	}
+
+	if (LayoutsBuiltThisFrame >= LAYOUTS_PER_FRAME)
+	{
+		return false;
+	}
+
+	LayoutsBuiltThisFrame++;
+	return true;
+}
+
+void SGraphNodeDialogueBase::BuildPendingWidgets(EDialogueNodeLOD InLOD)
+{
+	bool bBuiltWidgets = false;
+
+	if (bHeaderPending && InLOD != EDialogueNodeLOD::Flat)
+	{
+		BuildHeader();
+		bBuiltWidgets = true;
+	}
+
+	if (bContentAreaPending && InLOD == EDialogueNodeLOD::Full)
+	{
+		BuildContentArea();
+		bBuiltWidgets = true;
+	}
+
+	//Only resize once everything is built so the node is measured whole
+	if (bBuiltWidgets && !bHeaderPending && !bContentAreaPending)
+	{
+		ResizeToDesiredSize();
+	}
+}
+
+void SGraphNodeDialogueBase::ResizeToDesiredSize()
+{
+	if (DialogueNode)
+	{
+		//Prepass to update desired sizes
+		SlatePrepass(GetPrepassLayoutScaleMultiplier());
+
+		//Resize dialogue node
+		DialogueNode->ResizeNode(GetDesiredSize());
+	}
+}
+
+bool SGraphNodeDialogueBase::WasRecentlyDrawn() const
+{
+	return LastDrawnFrame > 0 && GFrameCounter - LastDrawnFrame <= 1;
+}
+
+EVisibility SGraphNodeDialogueBase::GetHeaderVisibility() const
+{
+	return GetNodeLOD() == EDialogueNodeLOD::Flat ? 
+		EVisibility::Collapsed : EVisibility::Visible;
+}
+
+EVisibility SGraphNodeDialogueBase::GetContentVisibility() const
+{
+	return GetNodeLOD() == EDialogueNodeLOD::Full ?
+		EVisibility::Visible : EVisibility::Collapsed;
+}
+
+EVisibility SGraphNodeDialogueBase::GetFlatBoxVisibility() const
+{
+	return GetNodeLOD() == EDialogueNodeLOD::Flat ?
+		EVisibility::HitTestInvisible : EVisibility::Collapsed;
+}
+
+FOptionalSize SGraphNodeDialogueBase::GetMinNodeWidth() const
+{
+	if (DialogueNode 
+		&& (bHeaderPending || bContentAreaPending 
+			|| GetNodeLOD() != EDialogueNodeLOD::Full))
+	{
+		return DialogueNode->NodeWidth;
+	}
+
+	return FOptionalSize();
+}
+
+FOptionalSize SGraphNodeDialogueBase::GetMinNodeHeight() const
+{
+	if (DialogueNode
+		&& (bHeaderPending || bContentAreaPending 
+			|| GetNodeLOD() != EDialogueNodeLOD::Full))
+	{
+		return DialogueNode->NodeHeight;
+	}
+
+	return FOptionalSize();
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,1263 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Import/DialogueScriptImporter.h"
+//UE
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Sound/SoundBase.h"
+#include "UObject/UObjectGlobals.h"
+//Plugin
+#include "Conditionals/DialogueConditionBool.h"
+#include "Conditionals/Queries/NodeVisitedQuery.h"
+#include "Dialogue.h"
+#include "DialogueConnectionLimit.h"
+#include "DialogueNodeSocket.h"
+#include "DialogueSpeakerSocket.h"
+#include "Graph/DialogueEdGraph.h"
+#include "Graph/DialogueGraphCondition.h"
+#include "Graph/Nodes/GraphNodeDialogueBranch.h"
+#include "Graph/Nodes/GraphNodeDialogueEntry.h"
+#include "Graph/Nodes/GraphNodeDialogueSpeech.h"
+#include "Transitions/AutoDialogueTransition.h"
+#include "Transitions/InputDialogueTransition.h"
+
+#define LOCTEXT_NAMESPACE "DialogueScriptImporter"
+
+FDialogueScriptImporter::FDialogueScriptImporter(UDialogueEdGraph* InGraph)
+	: Graph(InGraph)
+{
+	check(Graph);
+	Dialogue = Graph->GetDialogue();
+	check(Dialogue);
+}
+
+FDialogueScriptImporter::~FDialogueScriptImporter()
+{
+}
+
+bool FDialogueScriptImporter::ImportFile(const FString& InFilePath,
+	FDialogueScriptImportResult& OutResult)
+{
+	OutResult = FDialogueScriptImportResult();
+	ImportedRows.Empty();
+	PendingAudio.Empty();
+	NumPlacedNodes = 0;
+
+	FString OpenError;
+	if (!OpenScript(InFilePath, OpenError))
+	{
+		OutResult.Errors.Add(OpenError);
+		return false;
+	}
+
+	//New speeches go in columns to the right of the existing graph
+	int32 MaxNodeX = 0;
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			MaxNodeX = FMath::Max(MaxNodeX, Node->NodePosX);
+
+			if (Node->IsA<UGraphNodeDialogueEntry>())
+			{
+				PlacementOrigin.Y = Node->NodePosY;
+			}
+		}
+	}
+	PlacementOrigin.X = MaxNodeX + NODE_COLUMN_SPACING;
+
+	const int32 NumSpeakerRoles = Dialogue->GetSpeakerRoles().Num();
+
+	FScopedSlowTask ImportTask(
+		2.f,
+		LOCTEXT("ImportingScript", "Importing dialogue script...")
+	);
+	ImportTask.MakeDialog();
+
+	FScopedTransaction Transaction(
+		LOCTEXT("ImportScriptTransaction", "Import Dialogue Script")
+	);
+	Graph->Modify();
+
+	//Create and update speeches as rows are read
+	ImportTask.EnterProgressFrame(1.f);
+	{
+		FScopedSlowTask ReadTask(
+			static_cast<float>(FMath::Max<int64>(FileSize, 1)),
+			LOCTEXT("ReadingScript", "Reading script rows...")
+		);
+
+		int64 ReportedBytes = BytesConsumed;
+		FString Record;
+		int32 RecordLine = 0;
+
+		while (ReadRecord(Record, RecordLine))
+		{
+			OutResult.NumRows++;
+
+			FDialogueScriptRow Row;
+			FString RowError;
+			if (ParseRow(Record, Row, RowError))
+			{
+				ApplyRow(Row, RecordLine, OutResult);
+			}
+			else
+			{
+				AddError(OutResult, RecordLine, RowError);
+				OutResult.NumSkipped++;
+			}
+
+			if (PendingAudio.Num() >= AUDIO_BATCH_SIZE)
+			{
+				LoadPendingAudio(OutResult);
+			}
+
+			ReadTask.EnterProgressFrame(
+				static_cast<float>(BytesConsumed - ReportedBytes)
+			);
+			ReportedBytes = BytesConsumed;
+		}
+
+		LoadPendingAudio(OutResult);
+	}
+
+	//Read the script again to gate and link each row now that every node
+	//exists. Each row is let go once wired, so the script's links and
+	//conditions are never all held at once.
+	ImportTask.EnterProgressFrame(1.f);
+	if (OpenScript(InFilePath, OpenError))
+	{
+		FScopedSlowTask LinkTask(
+			static_cast<float>(FMath::Max<int64>(FileSize, 1)),
+			LOCTEXT("LinkingScript", "Linking script rows...")
+		);
+
+		int64 ReportedBytes = BytesConsumed;
+		FString Record;
+		int32 RecordLine = 0;
+
+		while (ReadRecord(Record, RecordLine))
+		{
+			FDialogueScriptRow Row;
+			FString RowError;
+			FImportedRow* ImportedRow = ParseRow(Record, Row, RowError)
+				? ImportedRows.Find(Row.NodeID)
+				: nullptr;
+
+			//Rows skipped or repeated were reported on the first read
+			if (ImportedRow && ImportedRow->LineNumber == RecordLine)
+			{
+				ApplyConditions(*ImportedRow, Row.Conditions, OutResult);
+				ApplyLinks(*ImportedRow, Row.Links, OutResult);
+			}
+
+			LinkTask.EnterProgressFrame(
+				static_cast<float>(BytesConsumed - ReportedBytes)
+			);
+			ReportedBytes = BytesConsumed;
+		}
+	}
+	else
+	{
+		OutResult.Errors.Add(OpenError);
+	}
+	CloseScript();
+
+	if (!ImportedRows.IsEmpty())
+	{
+		LinkEntryNode(ImportedRows.CreateConstIterator().Key());
+	}
+
+	//Tally the existing speeches
+	for (const TPair<FName, FImportedRow>& Entry : ImportedRows)
+	{
+		if (Entry.Value.bCreated)
+		{
+			continue;
+		}
+
+		if (Entry.Value.bChanged)
+		{
+			OutResult.NumUpdated++;
+		}
+		else
+		{
+			OutResult.NumUnchanged++;
+		}
+	}
+	ImportedRows.Empty();
+
+	//Notify listeners and compile once for the whole import
+	if (Dialogue->GetSpeakerRoles().Num() != NumSpeakerRoles)
+	{
+		Dialogue->OnSpeakerRolesChanged.ExecuteIfBound();
+	}
+	Graph->NotifyGraphChanged();
+	Graph->CompileAsset();
+
+	return true;
+}
+
+bool FDialogueScriptImporter::OpenScript(const FString& InFilePath,
+	FString& OutError)
+{
+	CloseScript();
+	CsvColumns.Empty();
+	ReadBufferSize = 0;
+	ReadBufferPos = 0;
+	BytesConsumed = 0;
+	LineNumber = 0;
+
+	IPlatformFile& PlatformFile =
+		FPlatformFileManager::Get().GetPlatformFile();
+	File.Reset(PlatformFile.OpenRead(*InFilePath));
+	if (!File.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Could not open %s."), *InFilePath);
+		return false;
+	}
+
+	FileSize = File->Size();
+	ReadBuffer.SetNumUninitialized(READ_CHUNK_SIZE);
+	bIsCsv = FPaths::GetExtension(InFilePath).Equals(
+		TEXT("csv"),
+		ESearchCase::IgnoreCase
+	);
+
+	if (bIsCsv && !ReadCsvHeader(OutError))
+	{
+		CloseScript();
+		return false;
+	}
+
+	return true;
+}
+
+void FDialogueScriptImporter::CloseScript()
+{
+	File.Reset();
+	ReadBuffer.Empty();
+	LineBytes.Empty();
+}
+
+bool FDialogueScriptImporter::ReadLine(FString& OutLine)
+{
+	LineBytes.Reset();
+	bool bFoundLine = false;
+
+	while (true)
+	{
+		//Refill the buffer once it has all been consumed
+		if (ReadBufferPos >= ReadBufferSize)
+		{
+			const int64 Remaining = FileSize - File->Tell();
+			if (Remaining <= 0)
+			{
+				break;
+			}
+
+			const int32 ChunkSize = static_cast<int32>(
+				FMath::Min<int64>(Remaining, READ_CHUNK_SIZE)
+			);
+			if (!File->Read(ReadBuffer.GetData(), ChunkSize))
+			{
+				break;
+			}
+
+			ReadBufferSize = ChunkSize;
+			ReadBufferPos = 0;
+		}
+
+		//Take bytes up to the next line feed, which UTF-8 never splits
+		const uint8* Chunk = ReadBuffer.GetData();
+		int32 LineEnd = ReadBufferPos;
+		while (LineEnd < ReadBufferSize && Chunk[LineEnd] != '\n')
+		{
+			LineEnd++;
+		}
+
+		LineBytes.Append(Chunk + ReadBufferPos, LineEnd - ReadBufferPos);
+		BytesConsumed += LineEnd - ReadBufferPos;
+		bFoundLine = true;
+
+		if (LineEnd < ReadBufferSize)
+		{
+			ReadBufferPos = LineEnd + 1;
+			BytesConsumed++;
+			break;
+		}
+
+		ReadBufferPos = ReadBufferSize;
+	}
+
+	if (!bFoundLine)
+	{
+		return false;
+	}
+
+	//Drop CRLF endings and the UTF-8 byte order mark
+	int32 LineStart = 0;
+	int32 LineLength = LineBytes.Num();
+	if (LineLength > 0 && LineBytes[LineLength - 1] == '\r')
+	{
+		LineLength--;
+	}
+	if (LineNumber == 0 && LineLength >= 3
+		&& LineBytes[0] == 0xEF
+		&& LineBytes[1] == 0xBB
+		&& LineBytes[2] == 0xBF)
+	{
+		LineStart = 3;
+	}
+
+	FUTF8ToTCHAR Converted(
+		reinterpret_cast<const ANSICHAR*>(LineBytes.GetData() + LineStart),
+		LineLength - LineStart
+	);
+	OutLine = FString(Converted.Length(), Converted.Get());
+	LineNumber++;
+
+	return true;
+}
+
+bool FDialogueScriptImporter::ReadRecord(FString& OutRecord,
+	int32& OutLineNumber)
+{
+	//Skip blank lines, and the brackets of JSON written one object per line
+	FString Line;
+	while (true)
+	{
+		if (!ReadLine(Line))
+		{
+			return false;
+		}
+
+		const FString Trimmed = Line.TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			continue;
+		}
+		if (!bIsCsv && (Trimmed == TEXT("[") || Trimmed == TEXT("]")))
+		{
+			continue;
+		}
+
+		break;
+	}
+
+	OutLineNumber = LineNumber;
+	OutRecord = MoveTemp(Line);
+
+	if (!bIsCsv)
+	{
+		return true;
+	}
+
+	//Keep reading while inside a quoted field
+	auto CountQuotes = [](const FString& InText)
+	{
+		int32 NumQuotes = 0;
+		for (const TCHAR Char : InText)
+		{
+			if (Char == TEXT('"'))
+			{
+				NumQuotes++;
+			}
+		}
+		return NumQuotes;
+	};
+
+	int32 NumQuotes = CountQuotes(OutRecord);
+	while (NumQuotes % 2 != 0 && ReadLine(Line))
+	{
+		OutRecord += TEXT("\n");
+		OutRecord += Line;
+		NumQuotes += CountQuotes(Line);
+	}
+
+	return true;
+}
+
+bool FDialogueScriptImporter::ReadCsvHeader(FString& OutError)
+{
+	FString Record;
+	int32 HeaderLine = 0;
+	if (!ReadRecord(Record, HeaderLine))
+	{
+		OutError = TEXT("The script is empty.");
+		return false;
+	}
+
+	TArray<FString> Fields;
+	if (!SplitCsvRecord(Record, Fields))
+	{
+		OutError = TEXT("The script's header row is malformed.");
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Fields.Num(); Index++)
+	{
+		CsvColumns.Add(FName(*Fields[Index]), Index);
+	}
+
+	if (!CsvColumns.Contains(FName("ID"))
+		|| !CsvColumns.Contains(FName("Speaker")))
+	{
+		OutError = TEXT("The script's header must have ID and Speaker columns.");
+		return false;
+	}
+
+	return true;
+}
+
+bool FDialogueScriptImporter::ParseRow(const FString& InRecord,
+	FDialogueScriptRow& OutRow, FString& OutError) const
+{
+	if (!bIsCsv)
+	{
+		return ParseJsonRow(InRecord, OutRow, OutError);
+	}
+
+	TArray<FString> Fields;
+	if (!SplitCsvRecord(InRecord, Fields))
+	{
+		OutError = TEXT("Unterminated quoted field.");
+		return false;
+	}
+
+	auto GetField = [this, &Fields](const FName InColumn)
+	{
+		const int32* Index = CsvColumns.Find(InColumn);
+		if (Index && Fields.IsValidIndex(*Index))
+		{
+			return Fields[*Index];
+		}
+		return FString();
+	};
+
+	OutRow.NodeID = FName(*GetField(FName("ID")));
+	OutRow.Speaker = FName(*GetField(FName("Speaker")));
+	OutRow.Text = GetField(FName("Text"));
+	OutRow.Audio = GetField(FName("Audio"));
+
+	TArray<FString> Links;
+	SplitList(GetField(FName("Links")), Links);
+	for (const FString& Link : Links)
+	{
+		OutRow.Links.Add(FName(*Link));
+	}
+
+	SplitList(GetField(FName("Conditions")), OutRow.Conditions);
+
+	return true;
+}
+
+bool FDialogueScriptImporter::ParseJsonRow(const FString& InRecord,
+	FDialogueScriptRow& OutRow, FString& OutError) const
+{
+	//Allow objects separated by commas, as inside a JSON array
+	FString Json = InRecord.TrimStartAndEnd();
+	Json.RemoveFromEnd(TEXT(","));
+
+	TSharedPtr<FJsonObject> Object;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+	{
+		OutError = TEXT("Not a valid JSON object.");
+		return false;
+	}
+
+	//Lists may be arrays or strings separated by '|'
+	auto GetList = [&Object](const TCHAR* InField, TArray<FString>& OutValues)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (Object->TryGetArrayField(InField, Values))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Values)
+			{
+				FString ValueString;
+				if (Value.IsValid() && Value->TryGetString(ValueString))
+				{
+					SplitList(ValueString, OutValues);
+				}
+			}
+			return;
+		}
+
+		FString List;
+		if (Object->TryGetStringField(InField, List))
+		{
+			SplitList(List, OutValues);
+		}
+	};
+
+	FString Value;
+	if (Object->TryGetStringField(TEXT("id"), Value))
+	{
+		OutRow.NodeID = FName(*Value.TrimStartAndEnd());
+	}
+	if (Object->TryGetStringField(TEXT("speaker"), Value))
+	{
+		OutRow.Speaker = FName(*Value.TrimStartAndEnd());
+	}
+	Object->TryGetStringField(TEXT("text"), OutRow.Text);
+	if (Object->TryGetStringField(TEXT("audio"), Value))
+	{
+		OutRow.Audio = Value.TrimStartAndEnd();
+	}
+
+	TArray<FString> Links;
+	GetList(TEXT("links"), Links);
+	for (const FString& Link : Links)
+	{
+		OutRow.Links.Add(FName(*Link));
+	}
+
+	GetList(TEXT("conditions"), OutRow.Conditions);
+
+	return true;
+}
+
+void FDialogueScriptImporter::ApplyRow(const FDialogueScriptRow& InRow,
+	int32 InLineNumber, FDialogueScriptImportResult& OutResult)
+{
+	//Verify the row can be imported
+	FString RowError;
+	UGraphNodeDialogue* ExistingNode = nullptr;
+
+	if (InRow.NodeID.IsNone())
+	{
+		RowError = TEXT("Row has no ID.");
+	}
+	else if (InRow.Speaker.IsNone())
+	{
+		RowError = FString::Printf(
+			TEXT("Row %s has no speaker."),
+			*InRow.NodeID.ToString()
+		);
+	}
+	else if (ImportedRows.Contains(InRow.NodeID))
+	{
+		RowError = FString::Printf(
+			TEXT("ID %s is used by an earlier row."),
+			*InRow.NodeID.ToString()
+		);
+	}
+	else
+	{
+		ExistingNode = Graph->GetNode(InRow.NodeID);
+		if (ExistingNode && !ExistingNode->IsA<UGraphNodeDialogueSpeech>())
+		{
+			RowError = FString::Printf(
+				TEXT("ID %s belongs to a node which is not a speech."),
+				*InRow.NodeID.ToString()
+			);
+		}
+	}
+
+	if (!RowError.IsEmpty())
+	{
+		AddError(OutResult, InLineNumber, RowError);
+		OutResult.NumSkipped++;
+		return;
+	}
+
+	//Add any speaker roles the dialogue is missing
+	UDialogueSpeakerSocket* Speaker = Dialogue->AddSpeakerRole(InRow.Speaker);
+	check(Speaker);
+
+	FImportedRow ImportedRow;
+	ImportedRow.LineNumber = InLineNumber;
+
+	//Update the speech in place, or create it
+	if (UGraphNodeDialogueSpeech* ExistingSpeech =
+		Cast<UGraphNodeDialogueSpeech>(ExistingNode))
+	{
+		ImportedRow.Speech = ExistingSpeech;
+		ImportedRow.bChanged =
+			UpdateSpeech(ExistingSpeech, InRow, Speaker, InLineNumber);
+	}
+	else
+	{
+		ImportedRow.Speech = CreateSpeech(InRow, Speaker, InLineNumber);
+		ImportedRow.bCreated = true;
+		OutResult.NumCreated++;
+	}
+
+	ImportedRows.Add(InRow.NodeID, ImportedRow);
+}
+
+bool FDialogueScriptImporter::UpdateSpeech(
+	UGraphNodeDialogueSpeech* InSpeech, const FDialogueScriptRow& InRow,
+	UDialogueSpeakerSocket* InSpeaker, int32 InLineNumber)
+{
+	check(InSpeech && InSpeaker);
+
+	//Only record the speech in the transaction if something changes
+	bool bChanged = false;
+	auto MarkChanged = [InSpeech, &bChanged]()
+	{
+		if (!bChanged)
+		{
+			InSpeech->Modify();
+			bChanged = true;
+		}
+	};
+
+	if (InSpeech->GetSpeaker() != InSpeaker)
+	{
+		MarkChanged();
+		InSpeech->SetSpeaker(InSpeaker);
+	}
+
+	const FText CurrentText = InSpeech->GetSpeechText();
+	if (!CurrentText.ToString().Equals(InRow.Text, ESearchCase::CaseSensitive))
+	{
+		MarkChanged();
+		InSpeech->SetSpeechText(MakeSpeechText(InRow.Text, CurrentText));
+	}
+
+	//Compare paths so unchanged audio is never loaded
+	if (FSoftObjectPath(InSpeech->GetSpeechAudio()) != FSoftObjectPath(InRow.Audio))
+	{
+		MarkChanged();
+		QueueAudio(InSpeech, InRow.Audio, InLineNumber);
+	}
+
+	//Options need a transition which allows several links
+	if (InRow.Links.Num() > 1
+		&& InSpeech->GetOutputConnectionLimit()
+			== EDialogueConnectionLimit::Single)
+	{
+		MarkChanged();
+		InSpeech->SetTransitionType(UInputDialogueTransition::StaticClass());
+	}
+
+	return bChanged;
+}
+
+UGraphNodeDialogueSpeech* FDialogueScriptImporter::CreateSpeech(
+	const FDialogueScriptRow& InRow, UDialogueSpeakerSocket* InSpeaker,
+	int32 InLineNumber)
+{
+	check(InSpeaker);
+
+	//Speeches followed by several nodes present them as options
+	TSubclassOf<UDialogueTransition> TransitionType = InRow.Links.Num() > 1
+		? UInputDialogueTransition::StaticClass()
+		: UAutoDialogueTransition::StaticClass();
+
+	UGraphNodeDialogueSpeech* NewSpeech =
+		UGraphNodeDialogueSpeech::MakeTemplate(
+			Graph,
+			InSpeaker,
+			TransitionType
+		);
+	NewSpeech->SetSpeechTitle(InRow.NodeID);
+	NewSpeech->SetSpeechText(MakeSpeechText(InRow.Text, FText::GetEmpty()));
+	QueueAudio(NewSpeech, InRow.Audio, InLineNumber);
+
+	//Fill columns top to bottom, then left to right
+	const FIntPoint Location = PlacementOrigin + FIntPoint(
+		(NumPlacedNodes / NODES_PER_COLUMN) * NODE_COLUMN_SPACING,
+		(NumPlacedNodes % NODES_PER_COLUMN) * NODE_ROW_SPACING
+	);
+	NumPlacedNodes++;
+
+	PlaceNode(NewSpeech, Location, InRow.NodeID);
+	return NewSpeech;
+}
+
+void FDialogueScriptImporter::PlaceNode(UGraphNodeDialogue* InNode,
+	FIntPoint InLocation, FName InID) const
+{
+	check(InNode);
+
+	//The graph was modified up front and is notified once at the end, so
+	//the node is added directly rather than through AddNode
+	InNode->SetFlags(RF_Transactional);
+	Graph->Nodes.Add(InNode);
+	InNode->CreateNewGuid();
+	InNode->PostPlacedNewNode();
+
+	//Set the node's ID, location and pins
+	InNode->InitNodeInDialogueGraph(Graph, InID);
+	InNode->NodePosX = InLocation.X;
+	InNode->NodePosY = InLocation.Y;
+	InNode->AllocateDefaultPins();
+}
+
+void FDialogueScriptImporter::ApplyConditions(FImportedRow& InRow,
+	const TArray<FString>& InConditions,
+	FDialogueScriptImportResult& OutResult)
+{
+	UGraphNodeDialogueSpeech* Speech = InRow.Speech;
+	UGraphNodeDialogueBranch* Gate = FindGate(Speech);
+
+	//A row without conditions no longer needs its gate, unless an else
+	//path has since been added to it by hand
+	if (InConditions.IsEmpty())
+	{
+		if (!Gate)
+		{
+			return;
+		}
+
+		TArray<UEdGraphPin*> GateOutputs = Gate->GetOutputPins();
+		if (GateOutputs.Num() > 1 && !GateOutputs[1]->LinkedTo.IsEmpty())
+		{
+			AddError(OutResult, InRow.LineNumber, FString::Printf(
+				TEXT("Gate %s was kept, as its else pin is linked."),
+				*Gate->GetID().ToString()
+			));
+			return;
+		}
+
+		RemoveGate(Speech, Gate);
+		InRow.bChanged = true;
+		return;
+	}
+
+	//Resolve the row's conditions
+	TArray<TPair<bool, UGraphNodeDialogue*>> RowConditions;
+	TArray<FString> RowKeys;
+	for (const FString& Condition : InConditions)
+	{
+		bool bQueryTrue = true;
+		FName TargetID;
+		if (!ParseCondition(Condition, bQueryTrue, TargetID))
+		{
+			AddError(OutResult, InRow.LineNumber, FString::Printf(
+				TEXT("Unsupported condition \"%s\". Expected [!]visited:NodeID."),
+				*Condition
+			));
+			continue;
+		}
+
+		UGraphNodeDialogue* Target = Graph->GetNode(TargetID);
+		if (!Target)
+		{
+			AddError(OutResult, InRow.LineNumber, FString::Printf(
+				TEXT("Condition refers to unknown node %s."),
+				*TargetID.ToString()
+			));
+			continue;
+		}
+
+		RowConditions.Emplace(bQueryTrue, Target);
+		RowKeys.Add(MakeConditionKey(bQueryTrue, Target->GetID()));
+	}
+
+	if (RowConditions.IsEmpty())
+	{
+		return;
+	}
+
+	//Leave the gate alone if it already matches the row
+	if (Gate)
+	{
+		TArray<FString> GateKeys;
+		for (UDialogueGraphCondition* Condition : Gate->GetGraphConditions())
+		{
+			GateKeys.Add(GetConditionKey(Condition));
+		}
+
+		if (GateKeys == RowKeys)
+		{
+			return;
+		}
+
+		Gate->Modify();
+	}
+	else
+	{
+		//Name the gate after its speech, which also marks it as the
+		//importer's own
+		Gate = UGraphNodeDialogueBranch::MakeTemplate(Graph);
+		PlaceNode(
+			Gate,
+			FIntPoint(Speech->NodePosX - GATE_OFFSET, Speech->NodePosY),
+			MakeGateID(Speech->GetID())
+		);
+
+		//Move the speech's parents onto the gate
+		UEdGraphPin* SpeechInput = Speech->GetInputPins()[0];
+		UEdGraphPin* GateInput = Gate->GetInputPins()[0];
+		Speech->Modify();
+
+		const TArray<UEdGraphPin*> ParentPins = SpeechInput->LinkedTo;
+		for (UEdGraphPin* ParentPin : ParentPins)
+		{
+			ParentPin->GetOwningNode()->Modify();
+			SpeechInput->BreakLinkTo(ParentPin);
+			ParentPin->MakeLinkTo(GateInput);
+		}
+
+		Gate->GetOutputPins()[0]->MakeLinkTo(SpeechInput);
+	}
+
+	TArray<UDialogueGraphCondition*> GateConditions;
+	for (const TPair<bool, UGraphNodeDialogue*>& Condition : RowConditions)
+	{
+		GateConditions.Add(
+			MakeCondition(Condition.Key, Condition.Value, Gate)
+		);
+	}
+	Gate->SetGraphConditions(GateConditions);
+
+	InRow.bChanged = true;
+}
+
+void FDialogueScriptImporter::ApplyLinks(FImportedRow& InRow,
+	const TArray<FName>& InLinks,
+	FDialogueScriptImportResult& OutResult) const
+{
+	UGraphNodeDialogueSpeech* Speech = InRow.Speech;
+	TArray<UEdGraphPin*> OutputPins = Speech->GetOutputPins();
+	check(!OutputPins.IsEmpty());
+	UEdGraphPin* OutputPin = OutputPins[0];
+
+	//Find each linked node's input, going through its gate if it has one
+	TArray<UEdGraphPin*> TargetPins;
+	for (const FName LinkID : InLinks)
+	{
+		UGraphNodeDialogue* Target = Graph->GetNode(LinkID);
+		if (!Target)
+		{
+			AddError(OutResult, InRow.LineNumber, FString::Printf(
+				TEXT("Link to unknown node %s."),
+				*LinkID.ToString()
+			));
+			continue;
+		}
+
+		if (UGraphNodeDialogueBranch* Gate = FindGate(Target))
+		{
+			Target = Gate;
+		}
+
+		TArray<UEdGraphPin*> InputPins = Target->GetInputPins();
+		if (InputPins.IsEmpty())
+		{
+			AddError(OutResult, InRow.LineNumber, FString::Printf(
+				TEXT("Node %s cannot be linked to."),
+				*LinkID.ToString()
+			));
+			continue;
+		}
+
+		TargetPins.AddUnique(InputPins[0]);
+	}
+
+	//Links to nodes outside the script were made by hand, so only links
+	//to the script's own nodes are replaced
+	TArray<UEdGraphPin*> ScriptPins;
+	for (UEdGraphPin* LinkedPin : OutputPin->LinkedTo)
+	{
+		if (TargetPins.Contains(LinkedPin)
+			|| IsImportedNode(LinkedPin->GetOwningNode()))
+		{
+			ScriptPins.Add(LinkedPin);
+		}
+	}
+
+	//Leave the links alone if they already match the row, in order
+	if (ScriptPins == TargetPins)
+	{
+		return;
+	}
+
+	Speech->Modify();
+	for (UEdGraphPin* OldPin : ScriptPins)
+	{
+		OldPin->GetOwningNode()->Modify();
+		OutputPin->BreakLinkTo(OldPin);
+	}
+
+	for (UEdGraphPin* TargetPin : TargetPins)
+	{
+		TargetPin->GetOwningNode()->Modify();
+		OutputPin->MakeLinkTo(TargetPin);
+	}
+
+	InRow.bChanged = true;
+}
+
+void FDialogueScriptImporter::LinkEntryNode(FName InFirstRow) const
+{
+	UGraphNodeDialogue* FirstNode = Graph->GetNode(InFirstRow);
+	if (!FirstNode)
+	{
+		return;
+	}
+
+	if (UGraphNodeDialogueBranch* Gate = FindGate(FirstNode))
+	{
+		FirstNode = Gate;
+	}
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UGraphNodeDialogueEntry* EntryNode =
+			Cast<UGraphNodeDialogueEntry>(Node);
+		if (!EntryNode)
+		{
+			continue;
+		}
+
+		//Only link the entry if it leads nowhere yet
+		TArray<UEdGraphPin*> EntryOutputs = EntryNode->GetOutputPins();
+		TArray<UEdGraphPin*> FirstInputs = FirstNode->GetInputPins();
+		if (!EntryOutputs.IsEmpty()
+			&& EntryOutputs[0]->LinkedTo.IsEmpty()
+			&& !FirstInputs.IsEmpty())
+		{
+			EntryNode->Modify();
+			FirstNode->Modify();
+			EntryOutputs[0]->MakeLinkTo(FirstInputs[0]);
+		}
+
+		return;
+	}
+}
+
+UDialogueGraphCondition* FDialogueScriptImporter::MakeCondition(
+	bool bQueryTrue, UGraphNodeDialogue* InTarget, UObject* InOuter) const
+{
+	check(InTarget && InOuter);
+
+	//Point a socket at the target node
+	UDialogueNodeSocket* NewSocket = NewObject<UDialogueNodeSocket>(Dialogue);
+	NewSocket->SetGraphNode(InTarget);
+	NewSocket->SetDisplayID(FText::FromName(InTarget->GetID()));
+
+	//Create the query and its condition
+	UDialogueGraphCondition* NewCondition =
+		NewObject<UDialogueGraphCondition>(InOuter);
+	UNodeVisitedQuery* NewQuery = NewObject<UNodeVisitedQuery>(NewCondition);
+	NewQuery->SetSocket(NewSocket);
+	NewCondition->Query = NewQuery;
+	NewCondition->RefreshCondition();
+
+	UDialogueConditionBool* BoolCondition =
+		Cast<UDialogueConditionBool>(NewCondition->GetCondition());
+	check(BoolCondition);
+	BoolCondition->SetQueryTrue(bQueryTrue);
+
+	return NewCondition;
+}
+
+void FDialogueScriptImporter::RemoveGate(UGraphNodeDialogueSpeech* InSpeech,
+	UGraphNodeDialogueBranch* InGate) const
+{
+	check(InSpeech && InGate);
+
+	//Move the gate's parents back onto the speech
+	UEdGraphPin* SpeechInput = InSpeech->GetInputPins()[0];
+	UEdGraphPin* GateInput = InGate->GetInputPins()[0];
+	InSpeech->Modify();
+	InGate->Modify();
+
+	const TArray<UEdGraphPin*> ParentPins = GateInput->LinkedTo;
+	for (UEdGraphPin* ParentPin : ParentPins)
+	{
+		ParentPin->GetOwningNode()->Modify();
+		GateInput->BreakLinkTo(ParentPin);
+		ParentPin->MakeLinkTo(SpeechInput);
+	}
+
+	InGate->GetSchema()->BreakNodeLinks(*InGate);
+	InGate->DestroyNode();
+}
+
+UGraphNodeDialogueBranch* FDialogueScriptImporter::FindGate(
+	UGraphNodeDialogue* InNode)
+{
+	check(InNode);
+
+	TArray<UEdGraphPin*> InputPins = InNode->GetInputPins();
+	if (InputPins.Num() != 1 || InputPins[0]->LinkedTo.Num() != 1)
+	{
+		return nullptr;
+	}
+
+	UEdGraphPin* ParentPin = InputPins[0]->LinkedTo[0];
+	UGraphNodeDialogueBranch* Branch =
+		Cast<UGraphNodeDialogueBranch>(ParentPin->GetOwningNode());
+	if (!Branch)
+	{
+		return nullptr;
+	}
+
+	//Must be linked from the branch's if pin
+	TArray<UEdGraphPin*> BranchOutputs = Branch->GetOutputPins();
+	if (BranchOutputs.IsEmpty() || BranchOutputs[0] != ParentPin)
+	{
+		return nullptr;
+	}
+
+	//Branches built by hand are never treated as gates
+	if (Branch->GetID() != MakeGateID(InNode->GetID()))
+	{
+		return nullptr;
+	}
+
+	return Branch;
+}
+
+FName FDialogueScriptImporter::MakeGateID(FName InSpeechID)
+{
+	return FName(InSpeechID.ToString() + TEXT("_Gate"));
+}
+
+bool FDialogueScriptImporter::ParseCondition(const FString& InCondition,
+	bool& bOutQueryTrue, FName& OutTargetID)
+{
+	FString Condition = InCondition.TrimStartAndEnd();
+	bOutQueryTrue = !Condition.RemoveFromStart(TEXT("!"));
+	Condition.TrimStartInline();
+
+	if (!Condition.RemoveFromStart(TEXT("visited:")))
+	{
+		return false;
+	}
+
+	OutTargetID = FName(*Condition.TrimStartAndEnd());
+	return !OutTargetID.IsNone();
+}
+
+FString FDialogueScriptImporter::MakeConditionKey(bool bQueryTrue,
+	FName InTargetID)
+{
+	return FString::Printf(
+		TEXT("%svisited:%s"),
+		bQueryTrue ? TEXT("") : TEXT("!"),
+		*InTargetID.ToString()
+	);
+}
+
+FString FDialogueScriptImporter::GetConditionKey(
+	UDialogueGraphCondition* InCondition)
+{
+	if (!InCondition)
+	{
+		return FString();
+	}
+
+	UNodeVisitedQuery* Query = 
+		ExactCast<UNodeVisitedQuery>(InCondition->GetQuery());
+	UDialogueConditionBool* Condition =
+		Cast<UDialogueConditionBool>(InCondition->GetCondition());
+	if (!Query || !Condition || !Query->GetSocket())
+	{
+		return FString();
+	}
+
+	UGraphNodeDialogue* Target =
+		Cast<UGraphNodeDialogue>(Query->GetSocket()->GetGraphNode());
+	if (!Target)
+	{
+		return FString();
+	}
+
+	return MakeConditionKey(Condition->GetQueryTrue(), Target->GetID());
+}
+
+FText FDialogueScriptImporter::MakeSpeechText(const FString& InText,
+	const FText& InPrevious)
+{
+	TOptional<FString> Namespace = FTextInspector::GetNamespace(InPrevious);
+	TOptional<FString> Key = FTextInspector::GetKey(InPrevious);
+
+	//New text gets a fresh key, as when entered in the details panel
+	if (!Key.IsSet() || Key.GetValue().IsEmpty())
+	{
+		Namespace = FString();
+		Key = FGuid::NewGuid().ToString();
+	}
+
+	return FText::ChangeKey(
+		Namespace.Get(FString()),
+		Key.GetValue(),
+		FText::FromString(InText)
+	);
+}
+
+void FDialogueScriptImporter::QueueAudio(UGraphNodeDialogueSpeech* InSpeech,
+	const FString& InPath, int32 InLineNumber)
+{
+	check(InSpeech);
+
+	if (InPath.IsEmpty())
+	{
+		InSpeech->SetSpeechAudio(nullptr);
+		return;
+	}
+
+	FPendingAudio& Audio = PendingAudio.AddDefaulted_GetRef();
+	Audio.Speech = InSpeech;
+	Audio.Path = FSoftObjectPath(InPath);
+	Audio.LineNumber = InLineNumber;
+}
+
+void FDialogueScriptImporter::LoadPendingAudio(
+	FDialogueScriptImportResult& OutResult)
+{
+	if (PendingAudio.IsEmpty())
+	{
+		return;
+	}
+
+	//Request every package first so they load together
+	TSet<FName> RequestedPackages;
+	for (const FPendingAudio& Audio : PendingAudio)
+	{
+		const FName PackageName = Audio.Path.GetLongPackageFName();
+		if (!PackageName.IsNone() && !Audio.Path.ResolveObject()
+			&& !RequestedPackages.Contains(PackageName))
+		{
+			RequestedPackages.Add(PackageName);
+			LoadPackageAsync(PackageName.ToString());
+		}
+	}
+
+	if (!RequestedPackages.IsEmpty())
+	{
+		FlushAsyncLoading();
+	}
+
+	for (const FPendingAudio& Audio : PendingAudio)
+	{
+		USoundBase* Sound = Cast<USoundBase>(Audio.Path.ResolveObject());
+		if (!Sound)
+		{
+			AddError(OutResult, Audio.LineNumber, FString::Printf(
+				TEXT("Could not load audio %s."),
+				*Audio.Path.ToString()
+			));
+		}
+
+		Audio.Speech->SetSpeechAudio(Sound);
+	}
+
+	PendingAudio.Reset();
+}
+
+bool FDialogueScriptImporter::IsImportedNode(UEdGraphNode* InNode) const
+{
+	if (InNode && InNode->IsA<UGraphNodeDialogueSpeech>())
+	{
+		return ImportedRows.Contains(
+			CastChecked<UGraphNodeDialogue>(InNode)->GetID()
+		);
+	}
+
+	//Gates count along with the speech they gate
+	UGraphNodeDialogueBranch* Branch = Cast<UGraphNodeDialogueBranch>(InNode);
+	TArray<UEdGraphPin*> BranchOutputs =
+		Branch ? Branch->GetOutputPins() : TArray<UEdGraphPin*>();
+	if (BranchOutputs.IsEmpty())
+	{
+		return false;
+	}
+
+	for (UEdGraphPin* LinkedPin : BranchOutputs[0]->LinkedTo)
+	{
+		UGraphNodeDialogue* Gated =
+			Cast<UGraphNodeDialogue>(LinkedPin->GetOwningNode());
+		if (Gated && FindGate(Gated) == Branch)
+		{
+			return ImportedRows.Contains(Gated->GetID());
+		}
+	}
+
+	return false;
+}
+
+void FDialogueScriptImporter::SplitList(const FString& InList,
+	TArray<FString>& OutValues)
+{
+	TArray<FString> Parts;
+	InList.ParseIntoArray(Parts, TEXT("|"), true);
+
+	for (FString& Part : Parts)
+	{
+		Part.TrimStartAndEndInline();
+		if (!Part.IsEmpty())
+		{
+			OutValues.Add(MoveTemp(Part));
+		}
+	}
+}
+
+bool FDialogueScriptImporter::SplitCsvRecord(const FString& InRecord,
+	TArray<FString>& OutFields)
+{
+	OutFields.Reset();
+
+	FString Field;
+	bool bInQuotes = false;
+	bool bWasQuoted = false;
+	const int32 Length = InRecord.Len();
+
+	for (int32 Index = 0; Index < Length; Index++)
+	{
+		const TCHAR Char = InRecord[Index];
+
+		if (bInQuotes)
+		{
+			if (Char != TEXT('"'))
+			{
+				Field.AppendChar(Char);
+			}
+			//Doubled quotes are an escaped quote
+			else if (Index + 1 < Length && InRecord[Index + 1] == TEXT('"'))
+			{
+				Field.AppendChar(Char);
+				Index++;
+			}
+			else
+			{
+				bInQuotes = false;
+			}
+		}
+		else if (Char == TEXT('"'))
+		{
+			bInQuotes = true;
+			bWasQuoted = true;
+		}
+		else if (Char == TEXT(','))
+		{
+			OutFields.Add(bWasQuoted ? Field : Field.TrimStartAndEnd());
+			Field.Reset();
+			bWasQuoted = false;
+		}
+		else
+		{
+			Field.AppendChar(Char);
+		}
+	}
+
+	OutFields.Add(bWasQuoted ? Field : Field.TrimStartAndEnd());
+	return !bInQuotes;
+}
+
+void FDialogueScriptImporter::AddError(FDialogueScriptImportResult& OutResult,
+	int32 InLineNumber, const FString& InError)
+{
+	//Keep the report readable when a whole script is malformed
+	if (OutResult.Errors.Num() < MAX_REPORTED_ERRORS)
+	{
+		OutResult.Errors.Add(
+			FString::Printf(TEXT("Line %d: %s"), InLineNumber, *InError)
+		);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
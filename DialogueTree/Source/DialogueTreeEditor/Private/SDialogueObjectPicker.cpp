@@ -3,7 +3,7 @@
 #include "SDialogueObjectPicker.h"
 //UE
 #include "Widgets/Input/SSearchBox.h"
-#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Views/STableRow.h"
 
 #define LOCTEXT_NAMESPACE "SDialogueObjectPicker"
 
@@ -22,6 +22,9 @@ void SDialogueObjectPicker::Construct(const FArguments& InArgs)
 	ParentButton = InArgs._ParentButton;
 	check(ParentButton.IsValid());
 
+	//Preprocess the names for searching 
+	InitCandidates();
+
 	//Set up filtered names array 
 	InitFilteredNames();
 
@@ -50,20 +53,41 @@ void SDialogueObjectPicker::InitCollection(const TArray<UObject*>& InCollection,
 	}
 }
 
-void SDialogueObjectPicker::InitFilteredNames()
+void SDialogueObjectPicker::InitCandidates()
 {
-	//Place all object names in collection into filter list
-	TSet<FName> NamesSet;
-	Collection.GetKeys(NamesSet);
-	FilteredNames = NamesSet.Array();
+	TArray<FName> Names;
+	Collection.GetKeys(Names);
 
-	//Sort names alphabetically
-	FilteredNames.Sort(
+	//Sort names alphabetically once, up front
+	Names.Sort(
 		[](FName Name1, FName Name2)
 		{
 			return Name1.LexicalLess(Name2);
 		}
 	);
+
+	Candidates.Empty(Names.Num());
+	for (int32 i = 0; i < Names.Num(); ++i)
+	{
+		TSharedPtr<FPickerCandidate> Candidate = 
+			MakeShared<FPickerCandidate>();
+		Candidate->Name = Names[i];
+		Candidate->SearchKey = NormalizeSearchText(
+			Names[i].ToString(), 
+			&Candidate->WordStarts
+		);
+		Candidate->CharMask = GetCharMask(Candidate->SearchKey);
+		Candidate->SortIndex = i;
+
+		Candidates.Add(Candidate);
+	}
+}
+
+void SDialogueObjectPicker::InitFilteredNames()
+{
+	//Place all candidates into filter list, already sorted
+	FilteredNames = Candidates;
+	LastQuery.Empty();
 }
 
 void SDialogueObjectPicker::BuildPicker()
@@ -88,12 +112,17 @@ void SDialogueObjectPicker::AddSearchBox(TSharedRef<SVerticalBox> MainBox)
 	FOnTextChanged OnTextChanged;
 	OnTextChanged.BindSP(this, &SDialogueObjectPicker::FilterCollection);
 
+	//Delegate to call for picking the best match on enter
+	FOnTextCommitted OnTextCommitted;
+	OnTextCommitted.BindSP(this, &SDialogueObjectPicker::OnSearchCommitted);
+
 	//Add the search box to the main widget
 	MainBox->AddSlot()
 	.AutoHeight()
 	[
 		SAssignNew(SearchBox, SSearchBox)
 		.OnTextChanged(OnTextChanged)
+		.OnTextCommitted(OnTextCommitted)
 	];
 }
 
@@ -108,7 +137,37 @@ void SDialogueObjectPicker::AddOptionsWidget(TSharedRef<SVerticalBox> MainBox)
 			SNew(SBox)
 			.MaxDesiredHeight(MAX_PICKER_HEIGHT)
 			[
-				SAssignNew(OptionsBox, SScrollBox)
+				SNew(SVerticalBox)
+
+				//Default entry for when nothing matches
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.f, OPTIONS_BOX_Y_PADDING)
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("EmptyOptionsText", "No valid items"))
+					.Font(GetFontStyle())
+					.Justification(TEXT_JUSTIFY)
+					.Visibility(
+						this, 
+						&SDialogueObjectPicker::GetEmptyTextVisibility
+					)
+				]
+
+				//Only the rows in view are ever built
+				+ SVerticalBox::Slot()
+				[
+					SAssignNew(
+						OptionsBox, 
+						SListView<TSharedPtr<FPickerCandidate>>
+					)
+					.ListItemsSource(&FilteredNames)
+					.SelectionMode(ESelectionMode::None)
+					.OnGenerateRow(
+						this, 
+						&SDialogueObjectPicker::OnGenerateOptionRow
+					)
+				]
 			]
 		]
 	];
@@ -121,70 +180,211 @@ void SDialogueObjectPicker::RefreshOptionsWidget()
 {
 	check(OptionsBox.IsValid());
 
-	//Empty the box
-	OptionsBox->ClearChildren();
+	OptionsBox->RequestListRefresh();
+	OptionsBox->ScrollToTop();
+}
 
-	//If no filtered names, present a default entry 
-	if (FilteredNames.IsEmpty())
-	{
-		OptionsBox->AddSlot()
-		.Padding(0.f, OPTIONS_BOX_Y_PADDING)
-		[
-			SNew(STextBlock)
-			.Text(LOCTEXT("EmptyOptionsText", "No valid items"))
-			.Font(GetFontStyle())
-			.Justification(TEXT_JUSTIFY)
-		];
+void SDialogueObjectPicker::FilterCollection(const FText& SearchText)
+{
+	const FString Query = NormalizeSearchText(SearchText.ToString());
 
+	if (Query.IsEmpty())
+	{
+		InitFilteredNames();
+		RefreshOptionsWidget();
 		return;
 	}
 
-	OptionsBox->AddSlot()
-	[
-		SNew(SSpacer)
-		.Size(FVector2D(OPTION_PADDING))
-	];
+	//A longer search can only match names the shorter one matched
+	const bool bNarrowing = !LastQuery.IsEmpty() 
+		&& Query.StartsWith(LastQuery, ESearchCase::CaseSensitive);
+	const TArray<TSharedPtr<FPickerCandidate>>& SearchPool = 
+		bNarrowing ? FilteredNames : Candidates;
+
+	TArray<TSharedPtr<FPickerCandidate>> Matches;
+	const uint64 QueryMask = GetCharMask(Query);
 
-	//Fill the box with option buttons 
-	for (FName OptionName : FilteredNames)
+	for (const TSharedPtr<FPickerCandidate>& Candidate : SearchPool)
 	{
-		OptionsBox->AddSlot()
-		.Padding(OPTION_PADDING, OPTION_PADDING / 2.f)
-		[
-			CreateOptionButton(OptionName)
-		];
+		//Skip names missing any of the searched characters 
+		if ((QueryMask & ~Candidate->CharMask) != 0)
+		{
+			continue;
+		}
+
+		Candidate->Score = ScoreCandidate(Query, *Candidate);
+		if (Candidate->Score > 0)
+		{
+			Matches.Add(Candidate);
+		}
 	}
+
+	//Best matches first, alphabetical among equals
+	Matches.Sort(
+		[](const TSharedPtr<FPickerCandidate>& A, 
+			const TSharedPtr<FPickerCandidate>& B)
+		{
+			if (A->Score != B->Score)
+			{
+				return A->Score > B->Score;
+			}
+			return A->SortIndex < B->SortIndex;
+		}
+	);
+
+	FilteredNames = MoveTemp(Matches);
+	LastQuery = Query;
+
+	RefreshOptionsWidget();
 }
 
-void SDialogueObjectPicker::FilterCollection(const FText& SearchText)
+void SDialogueObjectPicker::OnSearchCommitted(const FText& SearchText, 
+	ETextCommit::Type CommitType)
 {
-	FilteredNames.Empty();
+	if (CommitType == ETextCommit::OnEnter && !FilteredNames.IsEmpty())
+	{
+		BroadcastSelectedOption(FilteredNames[0]->Name);
+	}
+}
 
-	if (SearchText.IsEmptyOrWhitespace())
+FString SDialogueObjectPicker::NormalizeSearchText(const FString& InText, 
+	TArray<bool>* OutWordStarts)
+{
+	FString Normalized;
+	Normalized.Reserve(InText.Len());
+	if (OutWordStarts)
 	{
-		Collection.GetKeys(FilteredNames);
-		RefreshOptionsWidget();
-		return;
+		OutWordStarts->Empty(InText.Len());
 	}
 
-	FString SearchString = SearchText.ToString();
-	SearchString.RemoveSpacesInline();
+	TCHAR PrevChar = TEXT(' ');
+	for (const TCHAR Char : InText)
+	{
+		if (FChar::IsWhitespace(Char))
+		{
+			PrevChar = Char;
+			continue;
+		}
 
-	TArray<FName> Options;
-	Collection.GetKeys(Options);
+		if (OutWordStarts)
+		{
+			//Words begin after separators, at capitals and at numbers
+			const bool bWordStart = !FChar::IsAlnum(PrevChar)
+				|| (FChar::IsUpper(Char) && FChar::IsLower(PrevChar))
+				|| (FChar::IsDigit(Char) && !FChar::IsDigit(PrevChar));
+			OutWordStarts->Add(bWordStart);
+		}
+
+		Normalized.AppendChar(FChar::ToLower(Char));
+		PrevChar = Char;
+	}
+
+	return Normalized;
+}
+
+uint64 SDialogueObjectPicker::GetCharMask(const FString& InText)
+{
+	uint64 Mask = 0;
+	for (const TCHAR Char : InText)
+	{
+		if (Char >= TEXT('a') && Char <= TEXT('z'))
+		{
+			Mask |= 1ull << (Char - TEXT('a'));
+		}
+		else if (Char >= TEXT('0') && Char <= TEXT('9'))
+		{
+			Mask |= 1ull << (26 + Char - TEXT('0'));
+		}
+		else
+		{
+			//Everything else shares the remaining bits 
+			Mask |= 1ull << (36 + Char % 28);
+		}
+	}
+
+	return Mask;
+}
+
+int32 SDialogueObjectPicker::ScoreCandidate(const FString& InQuery, 
+	const FPickerCandidate& InCandidate)
+{
+	const FString& Key = InCandidate.SearchKey;
+	if (InQuery.Len() > Key.Len())
+	{
+		return 0;
+	}
 
-	for (FName Option : Options)
+	//Whole, leading and contained matches 
+	if (Key.Equals(InQuery, ESearchCase::CaseSensitive))
 	{
-		FString OptionString = Option.ToString();
-		OptionString.RemoveSpacesInline();
+		return EXACT_MATCH_SCORE;
+	}
 
-		if (OptionString.Contains(SearchString))
+	if (Key.StartsWith(InQuery, ESearchCase::CaseSensitive))
+	{
+		//Shorter names first
+		return PREFIX_MATCH_SCORE 
+			- FMath::Min(Key.Len() - InQuery.Len(), MAX_MATCH_PENALTY);
+	}
+
+	const int32 FoundIndex = Key.Find(InQuery, ESearchCase::CaseSensitive);
+	if (FoundIndex != INDEX_NONE)
+	{
+		const int32 WordBonus = 
+			InCandidate.WordStarts[FoundIndex] ? WORD_START_BONUS : 0;
+		//Matches at word starts first, then earlier matches
+		return SUBSTRING_MATCH_SCORE + WordBonus 
+			- FMath::Min(FoundIndex, MAX_MATCH_PENALTY);
+	}
+
+	//Characters in order, favoring word starts and runs
+	int32 Score = 1;
+	int32 KeyIndex = 0;
+	int32 LastMatchIndex = INDEX_NONE;
+
+	for (const TCHAR QueryChar : InQuery)
+	{
+		while (KeyIndex < Key.Len() && Key[KeyIndex] != QueryChar)
+		{
+			++KeyIndex;
+		}
+
+		if (KeyIndex == Key.Len())
+		{
+			return 0;
+		}
+
+		Score += InCandidate.WordStarts[KeyIndex] ? WORD_START_BONUS : 1;
+		if (LastMatchIndex != INDEX_NONE && KeyIndex == LastMatchIndex + 1)
 		{
-			FilteredNames.Add(Option);
+			Score += CONSECUTIVE_BONUS;
 		}
+
+		LastMatchIndex = KeyIndex;
+		++KeyIndex;
 	}
 
-	RefreshOptionsWidget();
+	return FMath::Min(Score, SUBSTRING_MATCH_SCORE - MAX_MATCH_PENALTY - 1);
+}
+
+TSharedRef<ITableRow> SDialogueObjectPicker::OnGenerateOptionRow(
+	TSharedPtr<FPickerCandidate> InCandidate,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	check(InCandidate.IsValid());
+
+	return SNew(STableRow<TSharedPtr<FPickerCandidate>>, OwnerTable)
+		.ShowSelection(false)
+		.Padding(FMargin(OPTION_PADDING, OPTION_PADDING / 2.f))
+		[
+			CreateOptionButton(InCandidate->Name)
+		];
+}
+
+EVisibility SDialogueObjectPicker::GetEmptyTextVisibility() const
+{
+	return FilteredNames.IsEmpty() ? EVisibility::Visible 
+		: EVisibility::Collapsed;
 }
 
 FReply SDialogueObjectPicker::BroadcastSelectedOption(FName SelectionName)
@@ -0,0 +1,623 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Search/DialogueSearchIndex.h"
+//UE
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+//Plugin
+#include "Dialogue.h"
+#include "Graph/DialogueEdGraph.h"
+#include "Graph/Nodes/GraphNodeDialogue.h"
+
+//Init the index to be empty
+TUniquePtr<FDialogueSearchIndex> FDialogueSearchIndex::Instance = nullptr;
+
+FArchive& operator<<(FArchive& Ar, FDialogueSearchEntry& Entry)
+{
+	uint8 Field = static_cast<uint8>(Entry.Field);
+	Ar << Entry.NodeID;
+	Ar << Field;
+	Ar << Entry.Text;
+	Entry.Field = static_cast<EDialogueSearchField>(Field);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar,
+	FDialogueSearchIndex::FIndexedDialogue& Doc)
+{
+	Ar << Doc.AssetPath;
+	Ar << Doc.SavedTime;
+	Ar << Doc.Entries;
+	return Ar;
+}
+
+void FDialogueSearchIndex::Initialize()
+{
+	//Check if already initialized or if there is no editor to search in
+	if (Instance.IsValid() || IsRunningCommandlet())
+	{
+		return;
+	}
+
+	Instance = MakeUnique<FDialogueSearchIndex>();
+	Instance->LoadCache();
+	Instance->RegisterListeners();
+}
+
+void FDialogueSearchIndex::Shutdown()
+{
+	if (Instance.IsValid())
+	{
+		Instance->UnregisterListeners();
+		if (Instance->bCacheDirty)
+		{
+			Instance->SaveCache();
+		}
+		Instance.Reset();
+	}
+}
+
+FDialogueSearchIndex* FDialogueSearchIndex::Get()
+{
+	return Instance.Get();
+}
+
+FDialogueSearchIndex::~FDialogueSearchIndex()
+{
+	UnregisterListeners();
+}
+
+void FDialogueSearchIndex::Search(const FString& InQuery,
+	TArray<FDialogueSearchResult>& OutResults, int32 MaxResults) const
+{
+	OutResults.Empty();
+
+	TArray<FString> QueryTokens;
+	Tokenize(InQuery, QueryTokens);
+	if (QueryTokens.IsEmpty())
+	{
+		return;
+	}
+
+	//Rebuild the sorted word list if words were added or removed
+	if (bSortedTokensDirty)
+	{
+		Postings.GetKeys(SortedTokens);
+		SortedTokens.Sort();
+		bSortedTokensDirty = false;
+	}
+
+	//Intersect the entries matching each query word
+	TSet<FPosting> Matches;
+	for (int32 i = 0; i < QueryTokens.Num(); ++i)
+	{
+		const FString& QueryToken = QueryTokens[i];
+		TSet<FPosting> TokenMatches;
+
+		//Every indexed word with the query word as a prefix is adjacent
+		int32 TokenIndex = Algo::LowerBound(SortedTokens, QueryToken);
+		while (SortedTokens.IsValidIndex(TokenIndex)
+			&& SortedTokens[TokenIndex].StartsWith(
+				QueryToken, ESearchCase::CaseSensitive))
+		{
+			TokenMatches.Append(Postings.FindChecked(
+				SortedTokens[TokenIndex]
+			));
+			++TokenIndex;
+		}
+
+		Matches = i == 0 ? MoveTemp(TokenMatches)
+			: Matches.Intersect(TokenMatches);
+		if (Matches.IsEmpty())
+		{
+			return;
+		}
+	}
+
+	//Gather the matching entries
+	for (const FPosting& Match : Matches)
+	{
+		const FIndexedDialogue& Doc = Documents.FindChecked(
+			Match.PackageName
+		);
+
+		FDialogueSearchResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.PackageName = Match.PackageName;
+		Result.AssetPath = Doc.AssetPath;
+		Result.Entry = Doc.Entries[Match.EntryIndex];
+	}
+
+	OutResults.Sort(
+		[](const FDialogueSearchResult& A, const FDialogueSearchResult& B)
+		{
+			if (A.AssetPath != B.AssetPath)
+			{
+				return A.AssetPath < B.AssetPath;
+			}
+			return A.Entry.NodeID.LexicalLess(B.Entry.NodeID);
+		}
+	);
+
+	if (OutResults.Num() > MaxResults)
+	{
+		OutResults.SetNum(MaxResults);
+	}
+}
+
+int32 FDialogueSearchIndex::GetNumPending() const
+{
+	return PendingPackages.Num() + LoadingPackages.Num();
+}
+
+int32 FDialogueSearchIndex::GetNumIndexed() const
+{
+	return Documents.Num();
+}
+
+FSimpleMulticastDelegate& FDialogueSearchIndex::OnIndexChanged()
+{
+	return IndexChangedEvent;
+}
+
+void FDialogueSearchIndex::Tokenize(const FString& InText,
+	TArray<FString>& OutTokens)
+{
+	FString Token;
+	for (const TCHAR Char : InText)
+	{
+		if (FChar::IsAlnum(Char))
+		{
+			Token.AppendChar(FChar::ToLower(Char));
+		}
+		else if (!Token.IsEmpty())
+		{
+			OutTokens.AddUnique(MoveTemp(Token));
+			Token.Reset();
+		}
+	}
+
+	if (!Token.IsEmpty())
+	{
+		OutTokens.AddUnique(MoveTemp(Token));
+	}
+}
+
+FString FDialogueSearchIndex::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("DialogueTree")
+		/ TEXT("SearchIndex.bin");
+}
+
+FDateTime FDialogueSearchIndex::GetPackageTimestamp(FName InPackageName)
+{
+	FString Filename;
+	if (FPackageName::TryConvertLongPackageNameToFilename(
+		InPackageName.ToString(),
+		Filename,
+		FPackageName::GetAssetPackageExtension()))
+	{
+		return IFileManager::Get().GetTimeStamp(*Filename);
+	}
+
+	return FDateTime::MinValue();
+}
+
+void FDialogueSearchIndex::RegisterListeners()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(
+			"AssetRegistry"
+		).Get();
+
+	//Wait for the initial scan before comparing against the index
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(
+			this, &FDialogueSearchIndex::OnFilesLoaded
+		);
+	}
+	else
+	{
+		QueueOutdatedDialogues();
+	}
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(
+		this, &FDialogueSearchIndex::OnAssetAdded
+	);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(
+		this, &FDialogueSearchIndex::OnAssetRemoved
+	);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(
+		this, &FDialogueSearchIndex::OnAssetRenamed
+	);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(
+		this, &FDialogueSearchIndex::OnPackageSaved
+	);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FDialogueSearchIndex::Tick),
+		0.1f
+	);
+}
+
+void FDialogueSearchIndex::UnregisterListeners()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	if (PackageSavedHandle.IsValid())
+	{
+		UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+		PackageSavedHandle.Reset();
+	}
+
+	if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::GetModuleChecked<FAssetRegistryModule>(
+				"AssetRegistry"
+			).Get();
+
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	FilesLoadedHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+}
+
+void FDialogueSearchIndex::QueueOutdatedDialogues()
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::GetModuleChecked<FAssetRegistryModule>(
+			"AssetRegistry"
+		).Get();
+
+	TArray<FAssetData> DialogueAssets;
+	AssetRegistry.GetAssetsByClass(
+		UDialogue::StaticClass()->GetClassPathName(),
+		DialogueAssets,
+		true
+	);
+
+	//Queue any dialogue which is new or was saved since it was indexed
+	TSet<FName> FoundPackages;
+	for (const FAssetData& Asset : DialogueAssets)
+	{
+		FoundPackages.Add(Asset.PackageName);
+
+		const FIndexedDialogue* Doc = Documents.Find(Asset.PackageName);
+		if (Doc == nullptr
+			|| Doc->SavedTime != GetPackageTimestamp(Asset.PackageName))
+		{
+			QueuePackage(Asset.PackageName);
+		}
+	}
+
+	//Drop any dialogue which no longer exists
+	TArray<FName> IndexedPackages;
+	Documents.GetKeys(IndexedPackages);
+	for (const FName& PackageName : IndexedPackages)
+	{
+		if (!FoundPackages.Contains(PackageName))
+		{
+			RemoveDocument(PackageName);
+		}
+	}
+}
+
+void FDialogueSearchIndex::QueuePackage(FName InPackageName)
+{
+	if (!LoadingPackages.Contains(InPackageName))
+	{
+		PendingPackages.AddUnique(InPackageName);
+	}
+}
+
+bool FDialogueSearchIndex::Tick(float DeltaTime)
+{
+	//Start loading queued dialogues, a few at a time
+	while (!PendingPackages.IsEmpty()
+		&& LoadingPackages.Num() < MAX_CONCURRENT_LOADS)
+	{
+		const FName PackageName = PendingPackages.Pop();
+		LoadingPackages.Add(PackageName);
+
+		LoadPackageAsync(
+			PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateLambda(
+				[](const FName& InPackageName, UPackage* InPackage,
+					EAsyncLoadingResult::Type InResult)
+				{
+					//The index may have shut down during the load
+					if (FDialogueSearchIndex* Index = Get())
+					{
+						Index->OnPackageLoaded(InPackageName, InPackage);
+					}
+				}
+			)
+		);
+	}
+
+	//Notify listeners and store the index once caught up
+	if (bIndexChanged)
+	{
+		bIndexChanged = false;
+		IndexChangedEvent.Broadcast();
+	}
+
+	if (bCacheDirty && GetNumPending() == 0)
+	{
+		SaveCache();
+	}
+
+	return true;
+}
+
+void FDialogueSearchIndex::OnPackageLoaded(const FName& InPackageName,
+	UPackage* InPackage)
+{
+	UDialogue* Dialogue = nullptr;
+	if (InPackage)
+	{
+		ForEachObjectWithPackage(InPackage,
+			[&Dialogue](UObject* InObject)
+			{
+				Dialogue = Cast<UDialogue>(InObject);
+				return Dialogue == nullptr;
+			},
+			false
+		);
+	}
+
+	LoadingPackages.Remove(InPackageName);
+
+	if (Dialogue == nullptr)
+	{
+		RemoveDocument(InPackageName);
+		return;
+	}
+
+	//The graph is a subobject of the dialogue, so it loaded with it
+	IndexDialogue(Dialogue);
+}
+
+void FDialogueSearchIndex::IndexDialogue(const UDialogue* InDialogue)
+{
+	check(InDialogue);
+
+	const FName PackageName = InDialogue->GetPackage()->GetFName();
+
+	FIndexedDialogue Doc;
+	Doc.AssetPath = FSoftObjectPath(InDialogue).ToString();
+	Doc.SavedTime = GetPackageTimestamp(PackageName);
+
+	UDialogueEdGraph* Graph =
+		Cast<UDialogueEdGraph>(InDialogue->GetEdGraphIfLoaded());
+	if (Graph)
+	{
+		for (UGraphNodeDialogue* Node : Graph->GetAllNodes())
+		{
+			if (Node)
+			{
+				Node->GetSearchEntries(Doc.Entries);
+			}
+		}
+	}
+
+	RemoveDocument(PackageName);
+	AddDocument(PackageName, MoveTemp(Doc));
+}
+
+void FDialogueSearchIndex::AddDocument(FName InPackageName,
+	FIndexedDialogue&& InDoc)
+{
+	FIndexedDialogue& Doc = Documents.Add(InPackageName, MoveTemp(InDoc));
+
+	TArray<FString> Tokens;
+	for (int32 i = 0; i < Doc.Entries.Num(); ++i)
+	{
+		Tokens.Reset();
+		Tokenize(Doc.Entries[i].Text, Tokens);
+
+		for (const FString& Token : Tokens)
+		{
+			TArray<FPosting>* TokenPostings = Postings.Find(Token);
+			if (TokenPostings == nullptr)
+			{
+				TokenPostings = &Postings.Add(Token);
+				bSortedTokensDirty = true;
+			}
+
+			TokenPostings->Add({ InPackageName, i });
+		}
+	}
+
+	bCacheDirty = true;
+	bIndexChanged = true;
+}
+
+void FDialogueSearchIndex::RemoveDocument(FName InPackageName)
+{
+	FIndexedDialogue Doc;
+	if (!Documents.RemoveAndCopyValue(InPackageName, Doc))
+	{
+		return;
+	}
+
+	//Only the words used by the dialogue can hold its postings
+	TSet<FString> Tokens;
+	TArray<FString> EntryTokens;
+	for (const FDialogueSearchEntry& Entry : Doc.Entries)
+	{
+		EntryTokens.Reset();
+		Tokenize(Entry.Text, EntryTokens);
+		Tokens.Append(EntryTokens);
+	}
+
+	for (const FString& Token : Tokens)
+	{
+		TArray<FPosting>* TokenPostings = Postings.Find(Token);
+		if (TokenPostings == nullptr)
+		{
+			continue;
+		}
+
+		TokenPostings->RemoveAllSwap(
+			[InPackageName](const FPosting& Posting)
+			{
+				return Posting.PackageName == InPackageName;
+			}
+		);
+
+		if (TokenPostings->IsEmpty())
+		{
+			Postings.Remove(Token);
+			bSortedTokensDirty = true;
+		}
+	}
+
+	bCacheDirty = true;
+	bIndexChanged = true;
+}
+
+void FDialogueSearchIndex::SaveCache()
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	int32 Version = CACHE_VERSION;
+	Writer << Version;
+	Writer << Documents;
+
+	FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilename());
+	bCacheDirty = false;
+}
+
+void FDialogueSearchIndex::LoadCache()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetCacheFilename(),
+		FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	//Out of date caches are rebuilt from scratch
+	int32 Version = 0;
+	Reader << Version;
+	if (Version != CACHE_VERSION)
+	{
+		return;
+	}
+
+	TMap<FName, FIndexedDialogue> CachedDocuments;
+	Reader << CachedDocuments;
+	if (Reader.IsError())
+	{
+		return;
+	}
+
+	for (TPair<FName, FIndexedDialogue>& Cached : CachedDocuments)
+	{
+		AddDocument(Cached.Key, MoveTemp(Cached.Value));
+	}
+
+	bCacheDirty = false;
+}
+
+void FDialogueSearchIndex::OnFilesLoaded()
+{
+	QueueOutdatedDialogues();
+}
+
+void FDialogueSearchIndex::OnAssetAdded(const FAssetData& InAssetData)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::GetModuleChecked<FAssetRegistryModule>(
+			"AssetRegistry"
+		).Get();
+
+	//Assets found by the initial scan are handled once it finishes
+	if (AssetRegistry.IsLoadingAssets()
+		|| !InAssetData.IsInstanceOf(UDialogue::StaticClass()))
+	{
+		return;
+	}
+
+	const FIndexedDialogue* Doc = Documents.Find(InAssetData.PackageName);
+	if (Doc == nullptr
+		|| Doc->SavedTime != GetPackageTimestamp(InAssetData.PackageName))
+	{
+		QueuePackage(InAssetData.PackageName);
+	}
+}
+
+void FDialogueSearchIndex::OnAssetRemoved(const FAssetData& InAssetData)
+{
+	if (InAssetData.IsInstanceOf(UDialogue::StaticClass()))
+	{
+		PendingPackages.Remove(InAssetData.PackageName);
+		RemoveDocument(InAssetData.PackageName);
+	}
+}
+
+void FDialogueSearchIndex::OnAssetRenamed(const FAssetData& InAssetData,
+	const FString& InOldObjectPath)
+{
+	if (InAssetData.IsInstanceOf(UDialogue::StaticClass()))
+	{
+		const FName OldPackageName = FName(
+			FPackageName::ObjectPathToPackageName(InOldObjectPath)
+		);
+		PendingPackages.Remove(OldPackageName);
+		RemoveDocument(OldPackageName);
+		QueuePackage(InAssetData.PackageName);
+	}
+}
+
+void FDialogueSearchIndex::OnPackageSaved(const FString& InFilename,
+	UPackage* InPackage, FObjectPostSaveContext InSaveContext)
+{
+	if (InPackage == nullptr || InSaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	UDialogue* Dialogue = nullptr;
+	ForEachObjectWithPackage(InPackage,
+		[&Dialogue](UObject* InObject)
+		{
+			Dialogue = Cast<UDialogue>(InObject);
+			return Dialogue == nullptr;
+		},
+		false
+	);
+
+	if (Dialogue == nullptr)
+	{
+		return;
+	}
+
+	PendingPackages.Remove(InPackage->GetFName());
+	IndexDialogue(Dialogue);
+}
@@ -0,0 +1,236 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Search/SDialogueSearch.h"
+//UE
+#include "Editor.h"
+#include "Misc/PackageName.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueEditor.h"
+
+#define LOCTEXT_NAMESPACE "SDialogueSearch"
+
+const FName SDialogueSearch::TabID = FName(TEXT("DialogueSearchTab"));
+
+void SDialogueSearch::Construct(const FArguments& InArgs)
+{
+	//Refresh results as the index fills in
+	if (FDialogueSearchIndex* Index = FDialogueSearchIndex::Get())
+	{
+		IndexChangedHandle = Index->OnIndexChanged().AddSP(
+			this, &SDialogueSearch::RefreshResults
+		);
+	}
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		//Search box
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.f)
+		[
+			SNew(SSearchBox)
+			.HintText(LOCTEXT(
+				"SearchHint",
+				"Search speech, speakers, events and conditions..."
+			))
+			.OnTextChanged(this, &SDialogueSearch::OnSearchTextChanged)
+		]
+
+		//Status
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.f, 0.f, 4.f, 4.f)
+		[
+			SNew(STextBlock)
+			.Text(this, &SDialogueSearch::GetStatusText)
+		]
+
+		//Results
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SAssignNew(
+				ResultsView,
+				SListView<TSharedPtr<FDialogueSearchResult>>
+			)
+			.ListItemsSource(&Results)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SDialogueSearch::OnGenerateRow)
+			.OnMouseButtonDoubleClick(
+				this,
+				&SDialogueSearch::OnResultDoubleClicked
+			)
+		]
+	];
+}
+
+SDialogueSearch::~SDialogueSearch()
+{
+	if (FDialogueSearchIndex* Index = FDialogueSearchIndex::Get())
+	{
+		Index->OnIndexChanged().Remove(IndexChangedHandle);
+	}
+}
+
+void SDialogueSearch::OnSearchTextChanged(const FText& InText)
+{
+	SearchText = InText.ToString();
+	RefreshResults();
+}
+
+void SDialogueSearch::RefreshResults()
+{
+	Results.Empty();
+
+	FDialogueSearchIndex* Index = FDialogueSearchIndex::Get();
+	if (Index && !SearchText.IsEmpty())
+	{
+		TArray<FDialogueSearchResult> FoundResults;
+		Index->Search(SearchText, FoundResults);
+
+		Results.Reserve(FoundResults.Num());
+		for (FDialogueSearchResult& Result : FoundResults)
+		{
+			Results.Add(MakeShared<FDialogueSearchResult>(MoveTemp(Result)));
+		}
+	}
+
+	if (ResultsView.IsValid())
+	{
+		ResultsView->RequestListRefresh();
+	}
+}
+
+TSharedRef<ITableRow> SDialogueSearch::OnGenerateRow(
+	TSharedPtr<FDialogueSearchResult> InResult,
+	const TSharedRef<STableViewBase>& OwnerTable) const
+{
+	check(InResult.IsValid());
+
+	const FText DialogueName = FText::FromString(
+		FPackageName::GetShortName(InResult->PackageName)
+	);
+
+	return SNew(STableRow<TSharedPtr<FDialogueSearchResult>>, OwnerTable)
+		.Padding(FMargin(4.f, 2.f))
+		[
+			SNew(SHorizontalBox)
+
+			//Dialogue and node
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.3f)
+			[
+				SNew(STextBlock)
+				.Text(FText::Format(
+					LOCTEXT("ResultLocation", "{0} : {1}"),
+					DialogueName,
+					FText::FromName(InResult->Entry.NodeID)
+				))
+			]
+
+			//Field
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.15f)
+			[
+				SNew(STextBlock)
+				.Text(GetFieldText(InResult->Entry.Field))
+			]
+
+			//Matching text
+			+ SHorizontalBox::Slot()
+			.FillWidth(0.55f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(InResult->Entry.Text))
+				.HighlightText(FText::FromString(SearchText))
+			]
+		];
+}
+
+void SDialogueSearch::OnResultDoubleClicked(
+	TSharedPtr<FDialogueSearchResult> InResult)
+{
+	if (!InResult.IsValid() || !GEditor)
+	{
+		return;
+	}
+
+	UDialogue* Dialogue = Cast<UDialogue>(
+		FSoftObjectPath(InResult->AssetPath).TryLoad()
+	);
+	if (!Dialogue)
+	{
+		return;
+	}
+
+	UAssetEditorSubsystem* AssetEditors =
+		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	AssetEditors->OpenEditorForAsset(Dialogue);
+
+	//Focus the node once the editor is up
+	IAssetEditorInstance* EditorInstance =
+		AssetEditors->FindEditorForAsset(Dialogue, true);
+	if (EditorInstance
+		&& EditorInstance->GetEditorName() == FName("FDialogueTreeEditor"))
+	{
+		static_cast<FDialogueEditor*>(EditorInstance)->JumpToNode(
+			InResult->Entry.NodeID
+		);
+	}
+}
+
+FText SDialogueSearch::GetStatusText() const
+{
+	FDialogueSearchIndex* Index = FDialogueSearchIndex::Get();
+	if (!Index)
+	{
+		return LOCTEXT("IndexUnavailable", "Search index unavailable.");
+	}
+
+	if (Index->GetNumPending() > 0)
+	{
+		return FText::Format(
+			LOCTEXT(
+				"IndexingStatus",
+				"Indexing dialogues... {0} remaining. {1} results."
+			),
+			Index->GetNumPending(),
+			Results.Num()
+		);
+	}
+
+	return FText::Format(
+		LOCTEXT("IndexedStatus", "{0} dialogues indexed. {1} results."),
+		Index->GetNumIndexed(),
+		Results.Num()
+	);
+}
+
+FText SDialogueSearch::GetFieldText(EDialogueSearchField InField)
+{
+	switch (InField)
+	{
+	case EDialogueSearchField::NodeID:
+		return LOCTEXT("NodeIDField", "Node");
+	case EDialogueSearchField::Speaker:
+		return LOCTEXT("SpeakerField", "Speaker");
+	case EDialogueSearchField::SpeechText:
+		return LOCTEXT("SpeechTextField", "Speech");
+	case EDialogueSearchField::EventClass:
+		return LOCTEXT("EventField", "Event");
+	case EDialogueSearchField::ConditionClass:
+		return LOCTEXT("ConditionField", "Condition");
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
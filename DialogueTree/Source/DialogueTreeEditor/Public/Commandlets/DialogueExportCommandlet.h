@@ -0,0 +1,34 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+//Generated
+#include "DialogueExportCommandlet.generated.h"
+
+/**
+* Exports every compiled dialogue in the project as plain text for 
+* localization and review. Run with -run=DialogueExport. 
+* 
+* Optional parameters: 
+* -Output=<Dir> - where files are written, defaults to Saved/DialogueExport.
+* -Paths=<Path,Path> - content paths to search, defaults to /Game.
+*/
+UCLASS()
+class DIALOGUETREEEDITOR_API UDialogueExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDialogueExportCommandlet();
+
+	/** UCommandlet Impl. */
+	virtual int32 Main(const FString& Params) override;
+	/** End UCommandlet */
+
+private:
+	/** How many dialogues to load before exporting and collecting garbage */
+	static const int32 LOAD_BATCH_SIZE;
+};
@@ -4,12 +4,16 @@
 
 //UE
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Misc/NotifyHook.h"
 #include "Toolkits/AssetEditorToolkit.h"
 #include "UObject/GCObject.h"
 
 class IDetailsView;
 class UDialogue;
+class FTransaction;
+struct FTransactionContext;
+enum class ETransactionStateEventType : uint8;
 
 /**
 * Manages core editor features and tabs for the dialogue graph. 
@@ -18,6 +22,9 @@ class DIALOGUETREEEDITOR_API FDialogueEditor : public FAssetEditorToolkit,
 	public FNotifyHook, public FGCObject
 {
 public:
+	/** Destructor */
+	virtual ~FDialogueEditor();
+
 	/**
 	* Initializes the editor. 
 	* 
@@ -82,11 +89,40 @@ public:
 	*/
 	bool CanPasteNodes() const;
 
+	/**
+	* Focuses the graph viewport on the node with the given ID. If the 
+	* viewport is still being built, the jump happens once it is.
+	* 
+	* @param InNodeID - FName, the ID of the node to jump to. 
+	*/
+	void JumpToNode(FName InNodeID);
+
 private: 
 	/**
-	* Creates the various widgets that make up the editor. 
+	* Builds the next of the editor's panels, replacing its loading 
+	* indicator. Ticked once per frame until every panel is built, so that
+	* opening a large dialogue doesn't stall on a single frame.
+	* 
+	* @param DeltaTime - float, time since the last tick.
+	* @return bool - true while panels are left to build.
 	*/
-	void CreateInternalWidgets();
+	bool BuildNextPanel(float DeltaTime);
+
+	/**
+	* Sets the content of a tab if it is currently open. 
+	* 
+	* @param InTabID - const FName&, the tab to update. 
+	* @param InContent - TSharedPtr<SWidget>, the new content.
+	*/
+	void SetLiveTabContent(const FName& InTabID, 
+		TSharedPtr<SWidget> InContent);
+
+	/**
+	* Creates the placeholder shown in a panel until it is built. 
+	* 
+	* @return TSharedRef<SWidget> - the loading widget. 
+	*/
+	TSharedRef<SWidget> CreateLoadingWidget() const;
 
 	/**
 	* Creates the graph/viewport widget. 
@@ -204,6 +240,66 @@ private:
 	*/
 	void OnCompile();
 
+	/**
+	* Asks for a CSV or JSON Lines script and imports it into the graph.
+	*/
+	void OnImportScript();
+
+	/**
+	* Checks if a script can be imported, which requires the graph to have
+	* finished loading. 
+	* 
+	* @return bool - whether a script can be imported. 
+	*/
+	bool CanImportScript() const;
+
+	/**
+	* Registers for changes to the editor's transaction buffer so that
+	* the undo memory used by this dialogue can be tracked. 
+	*/
+	void RegisterTransactionListeners();
+
+	/**
+	* Unregisters any transaction buffer listeners. 
+	*/
+	void UnregisterTransactionListeners();
+
+	/**
+	* Handles a change in the state of an editor transaction. 
+	* 
+	* @param InTransactionContext - const FTransactionContext&.
+	* @param InTransactionState - const ETransactionStateEventType.
+	*/
+	void OnTransactionStateChanged(
+		const FTransactionContext& InTransactionContext,
+		const ETransactionStateEventType InTransactionState);
+
+	/**
+	* Counts every transaction already in the undo buffer. Called once, 
+	* when the editor opens. 
+	*/
+	void CountExistingTransactions();
+
+	/**
+	* Adds a transaction to the dialogue's undo memory if it records 
+	* objects belonging to the dialogue being edited. 
+	* 
+	* @param InTransaction - const FTransaction&, the transaction.
+	*/
+	void CountTransaction(const FTransaction& InTransaction);
+
+	/**
+	* Drops counted transactions which have left the undo buffer. 
+	*/
+	void PruneCountedTransactions();
+
+	/**
+	* Gets the toolbar readout for the dialogue's undo memory. 
+	* 
+	* @return FText - the readout text. 
+	*/
+	FText GetTransactionBufferText() const;
+
 	// Commands
 	/**
 	* Registers the command list for the dialogue editor. 
@@ -298,4 +394,20 @@ private:
 
 	/** The list of UI commands for the editor */
 	TSharedPtr<FUICommandList> EditorCommands;
+
+	/** Node to jump to once the viewport has been built */
+	FName PendingJumpNodeID = NAME_None;
+
+	/** Ticker building the panels, valid until they are all built */
+	FTSTicker::FDelegateHandle BuildPanelsHandle;
+
+	/** Bytes of undo buffer used by transactions touching the dialogue */
+	SIZE_T TransactionBufferSize = 0;
+
+	/** Transactions touching the dialogue and their sizes, oldest first */
+	TArray<TPair<FGuid, SIZE_T>> CountedTransactions;
+
+	/** Handles for the transaction buffer listeners */
+	FDelegateHandle TransactionStateChangedHandle;
+	FDelegateHandle UndoBufferChangedHandle;
 };
\ No newline at end of file
@@ -39,6 +39,12 @@ private:
 	*/
 	void RegisterDetailsCustomizers();
 
+	/**
+	* Registers the dialogue search tab and starts the search index on 
+	* startup. 
+	*/
+	void RegisterSearch();
+
 	/**
 	* Unregisters the node factory on shutdown. 
 	*/
@@ -55,6 +61,12 @@ private:
 	*/
 	void UnregisterDetailsCustomizers();
 
+	/**
+	* Unregisters the dialogue search tab and stops the search index on
+	* shutdown. 
+	*/
+	void UnregisterSearch();
+
 private:
 	/** Asset category under which to situate the dialogue asset */
 	EAssetTypeCategories::Type DialogueAssetCategory;
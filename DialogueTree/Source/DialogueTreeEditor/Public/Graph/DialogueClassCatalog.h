@@ -0,0 +1,69 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+
+/**
+* Cache of the concrete classes deriving from the dialogue system's
+* extensible base classes (transitions, events, queries and so on). Lists
+* are gathered from the engine's derived class map the first time they
+* are asked for and dropped whenever code is reloaded or a Blueprint is
+* compiled or loaded, so context menus need not scan every loaded class.
+*/
+class DIALOGUETREEEDITOR_API FDialogueClassCatalog
+{
+public:
+	/**
+	* Begins listening for changes which invalidate the catalog. Static.
+	*/
+	static void Initialize();
+
+	/**
+	* Stops listening for changes and empties the catalog. Static.
+	*/
+	static void Shutdown();
+
+	/**
+	* Retrieves every concrete class deriving from the given class,
+	* including the class itself if concrete, sorted by name. Static.
+	*
+	* @param BaseClass - UClass*, the class to find subclasses of.
+	* @param OutClasses - TArray<UClass*>&, the found classes.
+	*/
+	static void GetClasses(UClass* BaseClass, TArray<UClass*>& OutClasses);
+
+	/**
+	* Empties the catalog so that it is rebuilt when next used. Static.
+	*/
+	static void Invalidate();
+
+private:
+	/**
+	* Gathers the concrete classes deriving from the given class. Static.
+	*
+	* @param BaseClass - UClass*, the class to find subclasses of.
+	* @param OutClasses - TArray<TWeakObjectPtr<UClass>>&, the found
+	* classes.
+	*/
+	static void BuildClassList(UClass* BaseClass,
+		TArray<TWeakObjectPtr<UClass>>& OutClasses);
+
+	/**
+	* Invalidates the catalog when a Blueprint is loaded. Static.
+	*
+	* @param InObject - UObject*, the loaded asset.
+	*/
+	static void OnAssetLoaded(UObject* InObject);
+
+private:
+	/** Cached subclasses for each base class asked about */
+	static TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<UClass>>>
+		CachedClasses;
+
+	/** Listener handles */
+	static FDelegateHandle ReloadCompleteHandle;
+	static FDelegateHandle BlueprintCompiledHandle;
+	static FDelegateHandle AssetLoadedHandle;
+};
@@ -21,6 +21,9 @@ class UGraphNodeDialogueBase;
 class UGraphNodeDialogueReroute;
 class UGraphNodeDialogueSpeech;
 
+/** Creates the node for a node creation action within the given graph */
+using FCreateTemplateNode = TFunction<UGraphNodeDialogue*(UEdGraph*)>;
+
 /** 
 * Struct defines data for actions that break pin links
 */
@@ -56,11 +59,27 @@ public:
 	FNewDialogueNodeAction(FText InNodeCategory, FText InMenuDesc,
 		FText InToolTip, UGraphNodeDialogue* InTemplateNode);
 
+	/** 
+	* Constructor for an action whose node is only created if the action 
+	* is actually performed. 
+	* 
+	* @param InNodeCategory - FText, Node category.  
+	* @param InMenuDesc - FText, Menu description.
+	* @param InToolTip - FText, Tooltip. 
+	* @param InTemplateFactory - FCreateTemplateNode, creates the node to
+	* spawn. 
+	*/
+	FNewDialogueNodeAction(FText InNodeCategory, FText InMenuDesc,
+		FText InToolTip, FCreateTemplateNode InTemplateFactory);
+
 private:
 	/** Node to build up and spawn */
 	UPROPERTY()
 	TObjectPtr<UGraphNodeDialogue> TemplateNode;
 
+	/** Creates the node to spawn, if not given up front */
+	FCreateTemplateNode TemplateFactory;
+
 public:
 	/** FEdGraphSchemaAction Implementation */
 	virtual UEdGraphNode* PerformAction(class UEdGraph* ParentGraph,
@@ -208,17 +227,16 @@ private:
 
 	/**
 	* Creates and sets up a New Speech Node Action for use in the context menu. 
+	* The speech node itself is only created if the action is chosen. 
 	* 
 	* @param Speaker - UDialogueSpeakerSocket*, the speaker for the node.
 	* @param TransitionType - TSubclassOf<UDialogueTransition>, the type of 
 	* transition for the node. 
-	* @param Outer - UObject*, the outer. 
 	* @return TSharedPtr<FNewDialogueNodeAction>, the node spawner action. 
 	*/
 	TSharedPtr<FNewDialogueNodeAction> MakeCreateSpeechNodeAction(
 		UDialogueSpeakerSocket* Speaker, 
-		TSubclassOf<UDialogueTransition> TransitionType, 
-		UObject* Outer) const;
+		TSubclassOf<UDialogueTransition> TransitionType) const;
 
 	/**
 	* Sets up context menu for conditional node creation.
@@ -20,6 +20,8 @@ public:
 
 public:
 	/** FConnectionDrawingPolicy Implementation */
+	virtual void Draw(TMap<TSharedRef<SWidget>, FArrangedWidget>& InPinGeometries,
+		FArrangedChildren& ArrangedNodes) override;
 	virtual void DrawPreviewConnector(const FGeometry& PinGeometry, 
 		const FVector2D& StartPoint, const FVector2D& EndPoint, 
 		UEdGraphPin* Pin) override;
@@ -61,6 +63,74 @@ private:
 	*/
 	FSplineShape GetSplineShape(FVector2D DeltaPos) const;
 
+	/** 
+	* Cached geometry for a single drawn connection. Stored relative to
+	* the start point, so panning the graph doesn't invalidate it.
+	*/
+	struct FSplineGeometry
+	{
+		FVector2D DeltaPos;
+		FVector2D Tangent;
+		FVector2D BoundsMin;
+		FVector2D BoundsMax;
+		float ZoomFactor = 0.f;
+		uint64 LastUsedFrame = 0;
+	};
+
+	/**
+	* Retrieves the spline geometry for a connection, recalculating it
+	* only if either endpoint has moved relative to the other or the
+	* zoom has changed since it was cached.
+	*
+	* @param StartPoint - const FVector2D&, the start of the spline.
+	* @param EndPoint - const FVector2D&, the end of the spline.
+	* @param Params - const FConnectionParams&, the connection's pins.
+	* @return const FSplineGeometry& - the spline geometry.
+	*/
+	const FSplineGeometry& GetSplineGeometry(const FVector2D& StartPoint,
+		const FVector2D& EndPoint, const FConnectionParams& Params);
+
+	/**
+	* Calculates the geometry for a spline between two points.
+	* 
+	* @param StartPoint - const FVector2D&, the start of the spline.
+	* @param EndPoint - const FVector2D&, the end of the spline.
+	* @param OutSpline - FSplineGeometry&, the geometry to fill. 
+	*/
+	void CalculateSplineGeometry(const FVector2D& StartPoint,
+		const FVector2D& EndPoint, FSplineGeometry& OutSpline) const;
+
+	/**
+	* Draws a single arrow at the given point. 
+	* 
+	* @param ArrowPoint - const FVector2D&, the arrow's top left corner. 
+	* @param ArrowColor - const FLinearColor&, the arrow's color. 
+	*/
+	void DrawArrow(const FVector2D& ArrowPoint, 
+		const FLinearColor& ArrowColor);
+
+	/**
+	* Removes cached splines for connections that haven't been drawn
+	* recently.
+	*/
+	static void PruneSplineCache();
+
+private:
+	/** The spline currently being drawn */
+	const FSplineGeometry* CurrentSpline = nullptr;
+
+	/** Geometry for connections without a pin pair, such as previews */
+	FSplineGeometry UncachedSpline;
+
+	/**
+	* Spline geometry per connection. Drawing policies are recreated
+	* every paint, so the cache is shared between instances. Entries
+	* are validated against the endpoints and zoom on every lookup, so
+	* a pin address reused by a new pin can't return stale geometry.
+	*/
+	static TMap<TPair<const UEdGraphPin*, const UEdGraphPin*>,
+		FSplineGeometry> SplineCache;
+
 private:
 	/** Radius of a standard pin */
 	float PinRadius;
@@ -86,4 +156,6 @@ private:
 
 	/** Constants */
 	const float ARROW_ANGLE = 1.5708f; //90 degrees in radians
+	const float SPLINE_CULL_PADDING = 8.f;
+	static constexpr uint64 SPLINE_CACHE_LIFETIME = 120; //Frames
 };
\ No newline at end of file
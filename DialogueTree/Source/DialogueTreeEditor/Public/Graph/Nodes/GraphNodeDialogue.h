@@ -13,6 +13,7 @@ DECLARE_DELEGATE(FOnUpdateNode);
 
 class UDialogueEdGraph;
 class UDialogueNode;
+struct FDialogueSearchEntry;
 
 /**
  * Abstract base node for all dialogue graph nodes that contain actual content.
@@ -89,8 +90,11 @@ public:
 	* to set up the node ID and cache the graph when adding a new node. 
 	* 
 	* @param OwningGraph - UEdGraph*, the owning graph. 
+	* @param InBaseID - FName, the ID to try first. If none, the node 
+	* type's base ID is used.
 	*/
-	void InitNodeInDialogueGraph(UEdGraph* OwningGraph);
+	void InitNodeInDialogueGraph(UEdGraph* OwningGraph, 
+		FName InBaseID = NAME_None);
 
 	/**
 	* Regenerates the node's ID. 
@@ -145,6 +149,16 @@ public:
 	*/
 	virtual void FinalizeAssetNode() {};
 
+	/**
+	* Virtual. Gathers the node's searchable content for the dialogue 
+	* search index. By default this is just the node's ID. 
+	* 
+	* @param OutEntries - TArray<FDialogueSearchEntry>&, the entries to
+	* add to. 
+	*/
+	virtual void GetSearchEntries(TArray<FDialogueSearchEntry>& OutEntries) 
+		const;
+
 	/**
 	* Links the asset node into the asset tree. 
 	* 
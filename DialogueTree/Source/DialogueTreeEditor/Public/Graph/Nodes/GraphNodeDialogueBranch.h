@@ -44,6 +44,8 @@ public:
 	virtual void CreateAssetNode(class UDialogue* InAsset) override;
 	virtual void FinalizeAssetNode() override;
 	virtual bool CanCompileNode() override;
+	virtual void GetSearchEntries(TArray<FDialogueSearchEntry>& OutEntries)
+		const override;
 	/** End UGraphNodeDialogue */
 
 	/**
@@ -63,6 +65,24 @@ public:
 	*/
 	TArray<FText> GetConditionDisplayTexts() const;
 
+	/**
+	* Retrieves the graph conditions attached to the node. 
+	* 
+	* @return const TArray<TObjectPtr<UDialogueGraphCondition>>& - the 
+	* graph conditions. 
+	*/
+	const TArray<TObjectPtr<UDialogueGraphCondition>>& GetGraphConditions()
+		const;
+
+	/**
+	* Replaces the graph conditions attached to the node. 
+	* 
+	* @param InConditions - const TArray<UDialogueGraphCondition*>&, the 
+	* new conditions. 
+	*/
+	void SetGraphConditions(
+		const TArray<UDialogueGraphCondition*>& InConditions);
+
 private:
 	/**
 	* Retrieves the dialogue node associated with the "true" branch of this
@@ -18,6 +18,15 @@ struct FGraphDialogueEvent
 
 	UPROPERTY(EditAnywhere, Instanced, Category = "Dialogue")
 	UDialogueEventBase* Event;
+
+	/** Name other events in the node use to wait on this one */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FName EventName;
+
+	/** Events which must finish before this one starts. Events with the
+	* same list start together; leave empty to start with the node. */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	TArray<FName> StartAfter;
 };
 
 /**
@@ -52,6 +61,8 @@ public:
 	virtual void FinalizeAssetNode() override;
 	virtual bool CanCompileNode() override;
 	virtual FName GetBaseID() const override;
+	virtual void GetSearchEntries(TArray<FDialogueSearchEntry>& OutEntries)
+		const override;
 	/** End UGraphNodeDialogue */
 
 	/**
@@ -71,6 +82,18 @@ public:
 private:
 	void FinalizeNodeSocket(UDialogueEventBase* InEvent);
 
+	/**
+	* Resolves each event's StartAfter names to the indices of the events it
+	* waits on. Null events are left out, matching the compiled node.
+	* 
+	* @param OutDependencies - TArray<TArray<int32>>&, for each compiled 
+	* event, the indices of the events it waits on. 
+	* @return bool - True if every name resolved and the events do not wait
+	* on each other in a loop; False otherwise. 
+	*/
+	bool ResolveEventDependencies(
+		TArray<TArray<int32>>& OutDependencies) const;
+
 private:
 	/** The list of user-defined events to play */
 	UPROPERTY(EditAnywhere, Category = "DialogueEvents")
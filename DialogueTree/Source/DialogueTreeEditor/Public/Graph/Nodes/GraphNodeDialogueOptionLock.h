@@ -35,6 +35,8 @@ public:
 	virtual void CreateAssetNode(class UDialogue* InAsset) override;
 	virtual void FinalizeAssetNode() override;
 	virtual bool CanCompileNode() override;
+	virtual void GetSearchEntries(TArray<FDialogueSearchEntry>& OutEntries)
+		const override;
 	/** End UGraphNodeDialogue */
 
 	/**
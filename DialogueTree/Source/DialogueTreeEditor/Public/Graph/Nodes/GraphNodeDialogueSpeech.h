@@ -58,6 +58,8 @@ public:
 	/** UGraphNodeDialogue Implementation */
 	virtual void CreateAssetNode(class UDialogue* InAsset) override;
 	virtual bool CanCompileNode() override;
+	virtual void GetSearchEntries(TArray<FDialogueSearchEntry>& OutEntries)
+		const override;
 	/** End UGraphNodeDialogue */
 
 public:
@@ -96,6 +98,35 @@ public:
 	*/
 	UDialogueSpeakerSocket* GetSpeaker() const;
 
+	/**
+	* Sets the speech's title, which serves as the base of its ID. Should be
+	* set before the node is placed in a graph. 
+	* 
+	* @param InTitle - FName, the new title.
+	*/
+	void SetSpeechTitle(FName InTitle);
+
+	/**
+	* Sets the speech's text content. 
+	* 
+	* @param InText - const FText&, the new speech text.
+	*/
+	void SetSpeechText(const FText& InText);
+
+	/**
+	* Retrieves the sound played as the speech's audio. 
+	* 
+	* @return USoundBase* - the speech audio. 
+	*/
+	USoundBase* GetSpeechAudio() const;
+
+	/**
+	* Sets the sound played as the speech's audio. 
+	* 
+	* @param InAudio - USoundBase*, the new speech audio. 
+	*/
+	void SetSpeechAudio(USoundBase* InAudio);
+
 private:
 	/**
 	* Behaviors for when the title of the speech changes. 
@@ -136,6 +167,12 @@ private:
 	UPROPERTY(EditAnywhere, Category = "SpeechContent")
 	float MinimumPlayTime = 0.f;
 
+	/** Seconds after the speech is spoken before it may be barked again, 
+	* or before it stops counting as recently spoken */
+	UPROPERTY(EditAnywhere, Category = "SpeechContent", 
+		meta = (ClampMin = 0))
+	float Cooldown = 0.f;
+
 	/** Whether the speech's content can be skipped or must be listened to */
 	UPROPERTY(EditAnywhere, Category = "SpeechContent")
 	bool bCanSkip = true;
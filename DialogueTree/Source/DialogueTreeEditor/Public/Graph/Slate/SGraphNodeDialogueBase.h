@@ -4,11 +4,26 @@
 
 //UE
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "SGraphNode.h"
 
 class UEdGraphNode;
 class UGraphNodeDialogue;
 
+/**
+* Level of detail tiers for drawing dialogue nodes based on the graph's
+* current zoom. 
+*/
+enum class EDialogueNodeLOD : uint8
+{
+	/** Full node content */
+	Full,
+	/** Header (title and color) only */
+	Title,
+	/** A flat box in the node's color */
+	Flat
+};
+
 /**
 * Base behaviors to govern how a node should display on the dialogue graph. 
 */
@@ -26,6 +41,8 @@ public:
 	/** SGraphNode Public Implementation */
 	virtual void UpdateGraphNode() override;
 	virtual void SetOwner(const TSharedRef<SGraphPanel>& OwnerPanel) override;
+	virtual void Tick(const FGeometry& AllottedGeometry, 
+		const double InCurrentTime, const float InDeltaTime) override;
 	/** End SGraphNode */
 
 protected:
@@ -89,7 +106,38 @@ protected:
 	*/
 	virtual float GetOutputPinYPadding() const;
 
+	/**
+	* Gets the level of detail the node should currently be drawn at,
+	* based on the owning graph panel's zoom. 
+	* 
+	* @return EDialogueNodeLOD - the current detail tier. 
+	*/
+	EDialogueNodeLOD GetNodeLOD() const;
+
 private:
+	/**
+	* Builds the node's layout and pins right away if this frame's build
+	* budget allows, otherwise queues them to be built on a later frame.
+	* Opening a large graph creates every node widget at once, so this
+	* spreads the bulk of that work across frames.
+	*/
+	void RequestLayoutBuild();
+
+	/**
+	* Builds queued node layouts until this frame's budget is spent.
+	*
+	* @param DeltaTime - float, time since the last tick.
+	* @return bool - true while queued layouts are left to build.
+	*/
+	static bool BuildQueuedLayouts(float DeltaTime);
+
+	/**
+	* Counts a layout build against this frame's budget.
+	*
+	* @return bool - true if the budget allowed the build, false if spent.
+	*/
+	static bool ConsumeLayoutBudget();
+
 	/**
 	* Assembles the header, content area and error widget together. 
 	* 
@@ -97,6 +145,70 @@ private:
 	*/
 	TSharedRef<SWidget> AssembleNodeContent();
 
+	/**
+	* Builds the node's header into its container. Deferred until the
+	* node is first drawn on screen, so that opening a large graph doesn't
+	* build headers for every node. Does not resize the node.
+	*/
+	void BuildHeader();
+
+	/**
+	* Builds the node's content area into its container. Deferred until
+	* the node is drawn at full detail, so that no text is laid out for
+	* nodes viewed from far away. Does not resize the node.
+	*/
+	void BuildContentArea();
+
+	/**
+	* Builds any deferred widgets appropriate for the given detail tier,
+	* resizing the node once nothing is left to build.
+	* 
+	* @param InLOD - EDialogueNodeLOD, the current detail tier. 
+	*/
+	void BuildPendingWidgets(EDialogueNodeLOD InLOD);
+
+	/**
+	* Resizes the dialogue node to match the widget's desired size. 
+	*/
+	void ResizeToDesiredSize();
+
+	/**
+	* Checks if the node was drawn on the last frame. Nodes outside the 
+	* panel's view are culled and never ticked. 
+	* 
+	* @return bool - true if recently drawn, false otherwise. 
+	*/
+	bool WasRecentlyDrawn() const;
+
+	/**
+	* Visibility of the header and error widgets. Collapsed when 
+	* drawing a flat box. 
+	*/
+	EVisibility GetHeaderVisibility() const;
+
+	/**
+	* Visibility of the content area. Collapsed below full detail.
+	*/
+	EVisibility GetContentVisibility() const;
+
+	/**
+	* Visibility of the flat box drawn when zoomed far out.
+	*/
+	EVisibility GetFlatBoxVisibility() const;
+
+	/**
+	* Minimum width for the node. Until built, and below full detail, 
+	* this holds the node at its last full detail width so that it acts
+	* as a placeholder and the graph layout doesn't shift.
+	*/
+	FOptionalSize GetMinNodeWidth() const;
+
+	/**
+	* Minimum height for the node. Below full detail this holds the 
+	* node at its last full detail height.
+	*/
+	FOptionalSize GetMinNodeHeight() const;
+
 protected: 
 	/** Cached dialogue node this is representing */
 	TObjectPtr<UGraphNodeDialogue> DialogueNode;
@@ -107,12 +219,44 @@ protected:
 	/** Holds Output Pins. Equivalent of SGraphNode's RightNodeBox. */
 	TSharedPtr<SHorizontalBox> OutputPinBox;
 
+private:
+	/** Container the node's header is built into */
+	TSharedPtr<SBox> HeaderBox;
+
+	/** Container the node's content area is built into */
+	TSharedPtr<SBox> ContentAreaBox;
+
+	/** If the layout and pins are queued to be built */
+	bool bLayoutPending = false;
+
+	/** If the header still needs to be built */
+	bool bHeaderPending = true;
+
+	/** If the content area still needs to be built */
+	bool bContentAreaPending = true;
+
+	/** The frame the node was last ticked (and so drawn) on */
+	uint64 LastDrawnFrame = 0;
+
+	/** Nodes waiting for their layout to be built, shared by all graphs */
+	static TArray<TWeakPtr<SGraphNodeDialogueBase>> QueuedLayouts;
+
+	/** Ticker building queued layouts, valid while any are queued */
+	static FTSTicker::FDelegateHandle QueuedLayoutsHandle;
+
+	/** The frame the layout budget was last counted on */
+	static uint64 LayoutBudgetFrame;
+
+	/** Layouts built so far on the budget's frame */
+	static int32 LayoutsBuiltThisFrame;
+
 private:
 	/** Constants */
 	const FVector2D DEFAULT_NODE_SIZE = FVector2D(75.f, 35.f);
 	const FVector2D PIN_BOX_PADDING = FVector2D(25.f, 0.f);
 	const FMargin TITLE_PADDING = FMargin(5.f, 5.f, 5.f, 2.5f);
 	const float BASE_PIN_PUSH_AMOUNT = -40.f;
+	static constexpr int32 LAYOUTS_PER_FRAME = 64;
 
 protected:
 	/** Constants */
@@ -0,0 +1,477 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class IFileHandle;
+class UDialogue;
+class UDialogueEdGraph;
+class UDialogueGraphCondition;
+class UDialogueSpeakerSocket;
+class UEdGraphNode;
+class UGraphNodeDialogue;
+class UGraphNodeDialogueBranch;
+class UGraphNodeDialogueSpeech;
+class USoundBase;
+
+/**
+* A single row read from a dialogue script.
+*/
+struct FDialogueScriptRow
+{
+	/** The ID of the speech node the row describes */
+	FName NodeID;
+
+	/** The name of the speaking role */
+	FName Speaker;
+
+	/** The text of the speech */
+	FString Text;
+
+	/** The object path of the speech's audio, if any */
+	FString Audio;
+
+	/** IDs of the nodes which follow the speech */
+	TArray<FName> Links;
+
+	/** Conditions gating the speech, each of the form [!]visited:NodeID */
+	TArray<FString> Conditions;
+};
+
+/**
+* Summary of a finished script import.
+*/
+struct FDialogueScriptImportResult
+{
+	/** The number of rows read from the script */
+	int32 NumRows = 0;
+
+	/** The number of speech nodes added to the graph */
+	int32 NumCreated = 0;
+
+	/** The number of existing speech nodes which were changed */
+	int32 NumUpdated = 0;
+
+	/** The number of existing speech nodes which were already up to date */
+	int32 NumUnchanged = 0;
+
+	/** The number of rows which could not be imported */
+	int32 NumSkipped = 0;
+
+	/** Descriptions of any problems found, by script line */
+	TArray<FString> Errors;
+};
+
+/**
+* Builds speech nodes into a dialogue graph from a CSV or JSON Lines script.
+* Each row gives a node ID, speaker, text, audio path, the IDs of the nodes
+* it links to and any node visited conditions, which are placed on a branch
+* in front of the speech. These gates are named after their speech, and
+* only branches named that way are changed or removed by re-imports.
+*
+* The script is streamed a line at a time, twice: first to create and
+* update the speeches, loading their audio in batches, then to gate and
+* link them once every node exists. Beyond the nodes themselves, only each
+* row's speech is kept for the whole import. Rows whose ID matches a speech
+* already in the graph update that speech in place, keeping its position
+* and any other edits, including links to nodes outside the script. The
+* dialogue is compiled once, when the import finishes.
+*/
+class DIALOGUETREEEDITOR_API FDialogueScriptImporter
+{
+public:
+	/**
+	* Creates an importer targeting the given graph.
+	*
+	* @param InGraph - UDialogueEdGraph*, the graph to import into.
+	*/
+	FDialogueScriptImporter(UDialogueEdGraph* InGraph);
+
+	/** Destructor */
+	~FDialogueScriptImporter();
+
+	/**
+	* Imports the script at the given path into the graph as a single
+	* undoable transaction, showing progress as it goes. Files ending in
+	* .csv are read as CSV with a header row, all others as JSON Lines.
+	*
+	* @param InFilePath - const FString&, the script to import.
+	* @param OutResult - FDialogueScriptImportResult&, summary of the
+	* import.
+	* @return bool - false if the script could not be read at all.
+	*/
+	bool ImportFile(const FString& InFilePath,
+		FDialogueScriptImportResult& OutResult);
+
+private:
+	/**
+	* What became of a row, kept so that later rows can find its speech.
+	*/
+	struct FImportedRow
+	{
+		/** The speech the row describes */
+		UGraphNodeDialogueSpeech* Speech = nullptr;
+
+		/** The script line the row began on */
+		int32 LineNumber = 0;
+
+		/** Whether the speech was added by this import */
+		bool bCreated = false;
+
+		/** Whether this import changed an existing speech */
+		bool bChanged = false;
+	};
+
+	/**
+	* Audio waiting to be loaded for a speech.
+	*/
+	struct FPendingAudio
+	{
+		/** The speech to give the audio */
+		UGraphNodeDialogueSpeech* Speech = nullptr;
+
+		/** The audio's object path */
+		FSoftObjectPath Path;
+
+		/** The script line of the speech's row */
+		int32 LineNumber = 0;
+	};
+
+private:
+	/**
+	* Opens the script for reading from the top, reading the CSV header if
+	* need be.
+	*
+	* @param InFilePath - const FString&, the script.
+	* @param OutError - FString&, the reason for failure, if any.
+	* @return bool - whether the script is ready to read rows from.
+	*/
+	bool OpenScript(const FString& InFilePath, FString& OutError);
+
+	/**
+	* Closes the script, freeing its read buffers.
+	*/
+	void CloseScript();
+
+	/**
+	* Reads the next line of the file, without its line ending.
+	*
+	* @param OutLine - FString&, the line read.
+	* @return bool - false once the end of the file is reached.
+	*/
+	bool ReadLine(FString& OutLine);
+
+	/**
+	* Reads the next non-empty record of the script. CSV records continue
+	* across lines while inside a quoted field.
+	*
+	* @param OutRecord - FString&, the record read.
+	* @param OutLineNumber - int32&, the line the record began on.
+	* @return bool - false once the end of the file is reached.
+	*/
+	bool ReadRecord(FString& OutRecord, int32& OutLineNumber);
+
+	/**
+	* Reads the CSV header row and records the index of each column.
+	*
+	* @param OutError - FString&, the reason for failure, if any.
+	* @return bool - whether a usable header was found.
+	*/
+	bool ReadCsvHeader(FString& OutError);
+
+	/**
+	* Parses a record into a row.
+	*
+	* @param InRecord - const FString&, the record.
+	* @param OutRow - FDialogueScriptRow&, the parsed row.
+	* @param OutError - FString&, the reason for failure, if any.
+	* @return bool - whether the record was parsed.
+	*/
+	bool ParseRow(const FString& InRecord, FDialogueScriptRow& OutRow,
+		FString& OutError) const;
+
+	/**
+	* Parses a JSON Lines record into a row.
+	*
+	* @param InRecord - const FString&, the record.
+	* @param OutRow - FDialogueScriptRow&, the parsed row.
+	* @param OutError - FString&, the reason for failure, if any.
+	* @return bool - whether the record was parsed.
+	*/
+	bool ParseJsonRow(const FString& InRecord, FDialogueScriptRow& OutRow,
+		FString& OutError) const;
+
+	/**
+	* Creates or updates the speech described by a row.
+	*
+	* @param InRow - const FDialogueScriptRow&, the row.
+	* @param InLineNumber - int32, the script line the row began on.
+	* @param OutResult - FDialogueScriptImportResult&, the import summary.
+	*/
+	void ApplyRow(const FDialogueScriptRow& InRow, int32 InLineNumber,
+		FDialogueScriptImportResult& OutResult);
+
+	/**
+	* Updates the content of an existing speech to match a row.
+	*
+	* @param InSpeech - UGraphNodeDialogueSpeech*, the speech.
+	* @param InRow - const FDialogueScriptRow&, the row.
+	* @param InSpeaker - UDialogueSpeakerSocket*, the row's speaker.
+	* @param InLineNumber - int32, the script line the row began on.
+	* @return bool - whether anything was changed.
+	*/
+	bool UpdateSpeech(UGraphNodeDialogueSpeech* InSpeech,
+		const FDialogueScriptRow& InRow, UDialogueSpeakerSocket* InSpeaker,
+		int32 InLineNumber);
+
+	/**
+	* Creates a new speech from a row and adds it to the graph.
+	*
+	* @param InRow - const FDialogueScriptRow&, the row.
+	* @param InSpeaker - UDialogueSpeakerSocket*, the row's speaker.
+	* @param InLineNumber - int32, the script line the row began on.
+	* @return UGraphNodeDialogueSpeech* - the new speech.
+	*/
+	UGraphNodeDialogueSpeech* CreateSpeech(const FDialogueScriptRow& InRow,
+		UDialogueSpeakerSocket* InSpeaker, int32 InLineNumber);
+
+	/**
+	* Adds a newly created node to the graph without notifying it, so
+	* the whole import can be announced in one go.
+	*
+	* @param InNode - UGraphNodeDialogue*, the new node.
+	* @param InLocation - FIntPoint, where to put the node.
+	* @param InID - FName, the ID to give the node. A number is added if
+	* it is already taken.
+	*/
+	void PlaceNode(UGraphNodeDialogue* InNode, FIntPoint InLocation,
+		FName InID) const;
+
+	/**
+	* Places the gating branch in front of a row's speech and fills it with
+	* the row's conditions, or removes the gate if the row has none. Only
+	* gates made by the importer are changed or removed.
+	*
+	* @param InRow - FImportedRow&, the row.
+	* @param InConditions - const TArray<FString>&, the row's conditions.
+	* @param OutResult - FDialogueScriptImportResult&, the import summary.
+	*/
+	void ApplyConditions(FImportedRow& InRow,
+		const TArray<FString>& InConditions,
+		FDialogueScriptImportResult& OutResult);
+
+	/**
+	* Links a row's speech to the nodes which follow it. Links to nodes
+	* outside the script are kept.
+	*
+	* @param InRow - FImportedRow&, the row.
+	* @param InLinks - const TArray<FName>&, the IDs of the nodes which
+	* follow the speech.
+	* @param OutResult - FDialogueScriptImportResult&, the import summary.
+	*/
+	void ApplyLinks(FImportedRow& InRow, const TArray<FName>& InLinks,
+		FDialogueScriptImportResult& OutResult) const;
+
+	/**
+	* Checks whether a node is one of the script's speeches or their
+	* gates.
+	*
+	* @param InNode - UEdGraphNode*, the node.
+	* @return bool - whether the script describes the node.
+	*/
+	bool IsImportedNode(UEdGraphNode* InNode) const;
+
+	/**
+	* Links the graph's entry to the first imported row if the entry has
+	* nothing following it yet.
+	*
+	* @param InFirstRow - FName, the ID of the first imported row.
+	*/
+	void LinkEntryNode(FName InFirstRow) const;
+
+	/**
+	* Creates a graph condition checking whether a node was visited.
+	*
+	* @param bQueryTrue - bool, whether the node must have been visited.
+	* @param InTarget - UGraphNodeDialogue*, the node to check.
+	* @param InOuter - UObject*, the owner for the condition.
+	* @return UDialogueGraphCondition* - the new condition.
+	*/
+	UDialogueGraphCondition* MakeCondition(bool bQueryTrue,
+		UGraphNodeDialogue* InTarget, UObject* InOuter) const;
+
+	/**
+	* Removes the branch gating a speech, linking the branch's parents
+	* straight to the speech.
+	*
+	* @param InSpeech - UGraphNodeDialogueSpeech*, the gated speech.
+	* @param InGate - UGraphNodeDialogueBranch*, the gate.
+	*/
+	void RemoveGate(UGraphNodeDialogueSpeech* InSpeech,
+		UGraphNodeDialogueBranch* InGate) const;
+
+	/**
+	* Finds the branch the importer made to gate a node. This is a branch
+	* whose if pin is the node's only input and whose ID is the one made
+	* for the node's gate.
+	*
+	* @param InNode - UGraphNodeDialogue*, the gated node.
+	* @return UGraphNodeDialogueBranch* - the gate, nullptr if none.
+	*/
+	static UGraphNodeDialogueBranch* FindGate(UGraphNodeDialogue* InNode);
+
+	/**
+	* Gets the ID given to the gate of a speech.
+	*
+	* @param InSpeechID - FName, the ID of the gated speech.
+	* @return FName - the gate's ID.
+	*/
+	static FName MakeGateID(FName InSpeechID);
+
+	/**
+	* Parses a script condition of the form [!]visited:NodeID.
+	*
+	* @param InCondition - const FString&, the script condition.
+	* @param bOutQueryTrue - bool&, whether the node must have been visited.
+	* @param OutTargetID - FName&, the ID of the node to check.
+	* @return bool - whether the condition could be parsed.
+	*/
+	static bool ParseCondition(const FString& InCondition,
+		bool& bOutQueryTrue, FName& OutTargetID);
+
+	/**
+	* Gets the normalized script form of a visited condition, used to
+	* compare existing gates against their rows.
+	*
+	* @param bQueryTrue - bool, whether the node must have been visited.
+	* @param InTargetID - FName, the ID of the node to check.
+	* @return FString - the script form.
+	*/
+	static FString MakeConditionKey(bool bQueryTrue, FName InTargetID);
+
+	/**
+	* Gets the normalized script form of a graph condition.
+	*
+	* @param InCondition - UDialogueGraphCondition*, the condition.
+	* @return FString - the script form, empty if not a visited condition.
+	*/
+	static FString GetConditionKey(UDialogueGraphCondition* InCondition);
+
+	/**
+	* Creates the text for a speech, keeping the localization key of the
+	* text it replaces so existing translations stay attached.
+	*
+	* @param InText - const FString&, the new text.
+	* @param InPrevious - const FText&, the text being replaced.
+	* @return FText - the speech text.
+	*/
+	static FText MakeSpeechText(const FString& InText,
+		const FText& InPrevious);
+
+	/**
+	* Sets a speech's audio once the next batch is loaded, or clears it
+	* straight away if the row has none.
+	*
+	* @param InSpeech - UGraphNodeDialogueSpeech*, the speech.
+	* @param InPath - const FString&, the object path of the audio.
+	* @param InLineNumber - int32, the script line of the speech's row.
+	*/
+	void QueueAudio(UGraphNodeDialogueSpeech* InSpeech,
+		const FString& InPath, int32 InLineNumber);
+
+	/**
+	* Loads all queued audio together and gives it to its speeches.
+	*
+	* @param OutResult - FDialogueScriptImportResult&, the import summary.
+	*/
+	void LoadPendingAudio(FDialogueScriptImportResult& OutResult);
+
+	/**
+	* Splits a list of script values separated by '|'.
+	*
+	* @param InList - const FString&, the list.
+	* @param OutValues - TArray<FString>&, the trimmed, non-empty values.
+	*/
+	static void SplitList(const FString& InList, TArray<FString>& OutValues);
+
+	/**
+	* Splits a CSV record into its fields.
+	*
+	* @param InRecord - const FString&, the record.
+	* @param OutFields - TArray<FString>&, the unquoted fields.
+	* @return bool - false if a quoted field is left open.
+	*/
+	static bool SplitCsvRecord(const FString& InRecord,
+		TArray<FString>& OutFields);
+
+	/**
+	* Records a problem with a row.
+	*
+	* @param OutResult - FDialogueScriptImportResult&, the import summary.
+	* @param InLineNumber - int32, the script line the row began on.
+	* @param InError - const FString&, the problem.
+	*/
+	static void AddError(FDialogueScriptImportResult& OutResult,
+		int32 InLineNumber, const FString& InError);
+
+private:
+	/** The graph being imported into */
+	UDialogueEdGraph* Graph = nullptr;
+
+	/** The dialogue owning the graph */
+	UDialogue* Dialogue = nullptr;
+
+	/** The open script */
+	TUniquePtr<IFileHandle> File;
+
+	/** Whether the script is CSV rather than JSON Lines */
+	bool bIsCsv = false;
+
+	/** Index of each CSV column, keyed by column name */
+	TMap<FName, int32> CsvColumns;
+
+	/** The most recent chunk read from the file */
+	TArray<uint8> ReadBuffer;
+
+	/** The number of valid bytes in the read buffer */
+	int32 ReadBufferSize = 0;
+
+	/** The next unconsumed byte of the read buffer */
+	int32 ReadBufferPos = 0;
+
+	/** The bytes of the line currently being read */
+	TArray<uint8> LineBytes;
+
+	/** The number of bytes of the file consumed so far */
+	int64 BytesConsumed = 0;
+
+	/** The size of the file in bytes */
+	int64 FileSize = 0;
+
+	/** The number of lines read so far */
+	int32 LineNumber = 0;
+
+	/** Rows read from the script, keyed by node ID, in script order */
+	TMap<FName, FImportedRow> ImportedRows;
+
+	/** Audio waiting for the next batch load */
+	TArray<FPendingAudio> PendingAudio;
+
+	/** The number of speeches added to the graph so far */
+	int32 NumPlacedNodes = 0;
+
+	/** Where the first new speech is placed */
+	FIntPoint PlacementOrigin = FIntPoint::ZeroValue;
+
+	/** Constants */
+	static const int32 READ_CHUNK_SIZE = 64 * 1024;
+	static const int32 NODES_PER_COLUMN = 50;
+	static const int32 NODE_COLUMN_SPACING = 700;
+	static const int32 NODE_ROW_SPACING = 250;
+	static const int32 GATE_OFFSET = 350;
+	static const int32 MAX_REPORTED_ERRORS = 100;
+	static const int32 AUDIO_BATCH_SIZE = 256;
+};
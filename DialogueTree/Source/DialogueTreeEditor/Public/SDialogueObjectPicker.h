@@ -7,13 +7,39 @@
 #include "UObject/NoExportTypes.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/SWidget.h"
+#include "Widgets/Views/SListView.h"
 
+class ITableRow;
 class SComboButton;
-class SScrollBox;
+class STableViewBase;
 
 DECLARE_DELEGATE_RetVal_OneParam(FName, FGetObjectName, UObject*);
 DECLARE_DELEGATE_OneParam(FOnPickerSelect, UObject*);
 
+/**
+* A single pickable name, preprocessed for fast matching. 
+*/
+struct FPickerCandidate
+{
+	/** The name shown to the user */
+	FName Name;
+
+	/** Lowercase name with spaces removed, used for matching */
+	FString SearchKey;
+
+	/** Which characters of the search key begin a word */
+	TArray<bool> WordStarts;
+
+	/** Bit per letter/digit present in the search key, for quick rejects */
+	uint64 CharMask = 0;
+
+	/** Position of the name in alphabetical order */
+	int32 SortIndex = 0;
+
+	/** Score of the name against the current search */
+	int32 Score = 0;
+};
+
 class SDialogueObjectPicker : public SCompoundWidget
 {
 public:
@@ -51,6 +77,12 @@ private:
 	void InitCollection(const TArray<UObject*>& InCollection, 
 		FGetObjectName NameGetter);
 
+	/**
+	* Builds the presorted, preprocessed candidates for each name in the
+	* collection. 
+	*/
+	void InitCandidates();
+
 	/**
 	* Sets up the array of filtered names. 
 	*/
@@ -89,6 +121,65 @@ private:
 	*/
 	void FilterCollection(const FText& SearchText);
 
+	/**
+	* Picks the best match when the user presses enter in the search box.
+	* 
+	* @param SearchText - const FText&, the committed text. 
+	* @param CommitType - ETextCommit::Type, how the text was committed.
+	*/
+	void OnSearchCommitted(const FText& SearchText, 
+		ETextCommit::Type CommitType);
+
+	/**
+	* Lowercases text and strips spaces so it can be matched. Static. 
+	* 
+	* @param InText - const FString&, the text to normalize. 
+	* @param OutWordStarts - TArray<bool>*, if provided, filled with which 
+	* characters of the result begin a word. 
+	* @return FString - the normalized text. 
+	*/
+	static FString NormalizeSearchText(const FString& InText, 
+		TArray<bool>* OutWordStarts = nullptr);
+
+	/**
+	* Gets the bit mask of letters and digits present in text. Static. 
+	* 
+	* @param InText - const FString&, normalized text. 
+	* @return uint64 - the character mask. 
+	*/
+	static uint64 GetCharMask(const FString& InText);
+
+	/**
+	* Scores how well a candidate matches a search. Exact, prefix and 
+	* substring matches rank above matches whose characters are merely 
+	* in order, which favor word starts and consecutive characters. 
+	* Static. 
+	* 
+	* @param InQuery - const FString&, the normalized search. 
+	* @param InCandidate - const FPickerCandidate&, the candidate. 
+	* @return int32 - the score, zero if the candidate does not match. 
+	*/
+	static int32 ScoreCandidate(const FString& InQuery, 
+		const FPickerCandidate& InCandidate);
+
+	/**
+	* Creates a list row for a candidate. 
+	* 
+	* @param InCandidate - TSharedPtr<FPickerCandidate>, the candidate. 
+	* @param OwnerTable - const TSharedRef<STableViewBase>&, the list. 
+	* @return TSharedRef<ITableRow> - the created row. 
+	*/
+	TSharedRef<ITableRow> OnGenerateOptionRow(
+		TSharedPtr<FPickerCandidate> InCandidate,
+		const TSharedRef<STableViewBase>& OwnerTable);
+
+	/**
+	* Gets whether the "No valid items" message should show. 
+	* 
+	* @return EVisibility - visible if nothing matches. 
+	*/
+	EVisibility GetEmptyTextVisibility() const;
+
 	/**
 	* Sets the value of the target property to the object associated
 	* with the selected name. 
@@ -135,8 +226,14 @@ private:
 	/** The items being picked from */
 	TMap<FName, UObject*> Collection;
 
-	/** A list of item names, filtered */
-	TArray<FName> FilteredNames;
+	/** Every pickable name, in alphabetical order */
+	TArray<TSharedPtr<FPickerCandidate>> Candidates;
+
+	/** A list of item names, filtered and ranked */
+	TArray<TSharedPtr<FPickerCandidate>> FilteredNames;
+
+	/** The normalized search the filtered names were found with */
+	FString LastQuery;
 
 	/** The combo button that opens this picker */
 	TSharedPtr<SComboButton> ParentButton;
@@ -144,12 +241,20 @@ private:
 	/** Where the user enters search text */
 	TSharedPtr<SSearchBox> SearchBox;
 
-	/** The display for options to appear in */
-	TSharedPtr<SScrollBox> OptionsBox;
+	/** The display for options to appear in. Only visible rows exist */
+	TSharedPtr<SListView<TSharedPtr<FPickerCandidate>>> OptionsBox;
 
 	/** Constants */
 	const float MAX_PICKER_HEIGHT = 150.f;
 	const float OPTIONS_BOX_Y_PADDING = 20.f;
 	const float OPTION_PADDING = 2.f;
 	const ETextJustify::Type TEXT_JUSTIFY = ETextJustify::Center;
+
+	/** Match scoring. Each kind of match outranks all of the kinds below */
+	static const int32 EXACT_MATCH_SCORE = 4000;
+	static const int32 PREFIX_MATCH_SCORE = 3000;
+	static const int32 SUBSTRING_MATCH_SCORE = 2000;
+	static const int32 WORD_START_BONUS = 10;
+	static const int32 CONSECUTIVE_BONUS = 5;
+	static const int32 MAX_MATCH_PENALTY = 500;
 };
\ No newline at end of file
@@ -0,0 +1,317 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+struct FAssetData;
+class UDialogue;
+class UPackage;
+class FObjectPostSaveContext;
+
+/**
+* The kinds of dialogue content that can be searched.
+*/
+enum class EDialogueSearchField : uint8
+{
+	NodeID,
+	Speaker,
+	SpeechText,
+	EventClass,
+	ConditionClass
+};
+
+/**
+* A single searchable piece of text gathered from a dialogue graph node.
+*/
+struct FDialogueSearchEntry
+{
+	FDialogueSearchEntry() = default;
+	FDialogueSearchEntry(FName InNodeID, EDialogueSearchField InField,
+		const FString& InText)
+		: NodeID(InNodeID), Field(InField), Text(InText) {}
+
+	/** The ID of the node the text belongs to */
+	FName NodeID;
+
+	/** What the text represents */
+	EDialogueSearchField Field = EDialogueSearchField::NodeID;
+
+	/** The searchable text */
+	FString Text;
+
+	friend FArchive& operator<<(FArchive& Ar, FDialogueSearchEntry& Entry);
+};
+
+/**
+* A single match returned from the dialogue search index.
+*/
+struct FDialogueSearchResult
+{
+	/** The package of the dialogue containing the match */
+	FName PackageName;
+
+	/** The object path of the dialogue containing the match */
+	FString AssetPath;
+
+	/** The matching entry */
+	FDialogueSearchEntry Entry;
+};
+
+/**
+* Project wide index of the speech text, speakers, events and conditions
+* used by every dialogue asset. The index is kept on disk between editor
+* sessions and only dialogues which have changed since they were last
+* indexed are reloaded, a few at a time, in the background.
+*/
+class DIALOGUETREEEDITOR_API FDialogueSearchIndex
+{
+public:
+	/**
+	* Creates the index and begins watching the asset registry. Static.
+	*/
+	static void Initialize();
+
+	/**
+	* Saves and destroys the index. Static.
+	*/
+	static void Shutdown();
+
+	/**
+	* Retrieves the index. Static.
+	*
+	* @return FDialogueSearchIndex* - the index, nullptr if not initialized.
+	*/
+	static FDialogueSearchIndex* Get();
+
+public:
+	/** Destructor */
+	~FDialogueSearchIndex();
+
+	/**
+	* Finds all entries containing every word in the query. Each query word
+	* matches any indexed word it is a prefix of.
+	*
+	* @param InQuery - const FString&, the text to search for.
+	* @param OutResults - TArray<FDialogueSearchResult>&, the found matches.
+	* @param MaxResults - int32, the most results to return.
+	*/
+	void Search(const FString& InQuery,
+		TArray<FDialogueSearchResult>& OutResults,
+		int32 MaxResults = 1000) const;
+
+	/**
+	* Gets the number of dialogues waiting to be indexed.
+	*
+	* @return int32 - the number of dialogues left to index.
+	*/
+	int32 GetNumPending() const;
+
+	/**
+	* Gets the number of dialogues currently in the index.
+	*
+	* @return int32 - the number of indexed dialogues.
+	*/
+	int32 GetNumIndexed() const;
+
+	/**
+	* Event broadcast whenever the contents of the index change.
+	*
+	* @return FSimpleMulticastDelegate& - the event.
+	*/
+	FSimpleMulticastDelegate& OnIndexChanged();
+
+private:
+	/**
+	* A dialogue's record in the index.
+	*/
+	struct FIndexedDialogue
+	{
+		/** The object path of the dialogue */
+		FString AssetPath;
+
+		/** The dialogue file's timestamp when it was indexed */
+		FDateTime SavedTime;
+
+		/** All of the dialogue's searchable entries */
+		TArray<FDialogueSearchEntry> Entries;
+
+		friend FArchive& operator<<(FArchive& Ar, FIndexedDialogue& Doc);
+	};
+
+	/**
+	* Location of a single entry containing an indexed word.
+	*/
+	struct FPosting
+	{
+		/** The dialogue containing the entry */
+		FName PackageName;
+
+		/** The index of the entry within the dialogue */
+		int32 EntryIndex = INDEX_NONE;
+
+		bool operator==(const FPosting& Other) const
+		{
+			return PackageName == Other.PackageName
+				&& EntryIndex == Other.EntryIndex;
+		}
+
+		friend uint32 GetTypeHash(const FPosting& Posting)
+		{
+			return HashCombine(
+				GetTypeHash(Posting.PackageName),
+				GetTypeHash(Posting.EntryIndex)
+			);
+		}
+	};
+
+private:
+	/**
+	* Splits text into lowercase alphanumeric words. Static.
+	*
+	* @param InText - const FString&, the text to split.
+	* @param OutTokens - TArray<FString>&, the found words.
+	*/
+	static void Tokenize(const FString& InText, TArray<FString>& OutTokens);
+
+	/**
+	* Gets the path of the on disk index cache. Static.
+	*
+	* @return FString - the cache file path.
+	*/
+	static FString GetCacheFilename();
+
+	/**
+	* Gets the timestamp of a dialogue package's file. Static.
+	*
+	* @param InPackageName - FName, the package.
+	* @return FDateTime - the file's timestamp, FDateTime::MinValue() if
+	* not found.
+	*/
+	static FDateTime GetPackageTimestamp(FName InPackageName);
+
+	/**
+	* Binds to the asset registry and package save events.
+	*/
+	void RegisterListeners();
+
+	/**
+	* Unbinds from the asset registry and package save events.
+	*/
+	void UnregisterListeners();
+
+	/**
+	* Compares the registry's dialogues against the index, queueing any
+	* which are new or have changed and dropping any which are gone.
+	*/
+	void QueueOutdatedDialogues();
+
+	/**
+	* Queues a dialogue package to be indexed.
+	*
+	* @param InPackageName - FName, the package.
+	*/
+	void QueuePackage(FName InPackageName);
+
+	/**
+	* Starts background loads for queued dialogues.
+	*
+	* @param DeltaTime - float, time since the last tick.
+	* @return bool - true to keep ticking.
+	*/
+	bool Tick(float DeltaTime);
+
+	/**
+	* Called when a queued dialogue's package has finished loading.
+	*
+	* @param InPackageName - const FName&, the loaded package.
+	* @param InPackage - UPackage*, the package, nullptr if it failed.
+	*/
+	void OnPackageLoaded(const FName& InPackageName, UPackage* InPackage);
+
+	/**
+	* Replaces a dialogue's entries with the current contents of its graph.
+	*
+	* @param InDialogue - const UDialogue*, the dialogue to index.
+	*/
+	void IndexDialogue(const UDialogue* InDialogue);
+
+	/**
+	* Adds a dialogue's record and its postings to the index.
+	*
+	* @param InPackageName - FName, the dialogue's package.
+	* @param InDoc - FIndexedDialogue&&, the dialogue's record.
+	*/
+	void AddDocument(FName InPackageName, FIndexedDialogue&& InDoc);
+
+	/**
+	* Removes a dialogue's record and its postings from the index.
+	*
+	* @param InPackageName - FName, the dialogue's package.
+	*/
+	void RemoveDocument(FName InPackageName);
+
+	/**
+	* Writes the index to the on disk cache.
+	*/
+	void SaveCache();
+
+	/**
+	* Reads the index from the on disk cache, if present.
+	*/
+	void LoadCache();
+
+	/** Asset registry and package events */
+	void OnFilesLoaded();
+	void OnAssetAdded(const FAssetData& InAssetData);
+	void OnAssetRemoved(const FAssetData& InAssetData);
+	void OnAssetRenamed(const FAssetData& InAssetData,
+		const FString& InOldObjectPath);
+	void OnPackageSaved(const FString& InFilename, UPackage* InPackage,
+		FObjectPostSaveContext InSaveContext);
+
+private:
+	/** The singleton index */
+	static TUniquePtr<FDialogueSearchIndex> Instance;
+
+	/** Version of the on disk cache format */
+	static const int32 CACHE_VERSION = 1;
+
+	/** The most dialogues to load in the background at once */
+	static const int32 MAX_CONCURRENT_LOADS = 4;
+
+	/** Indexed dialogues by package name */
+	TMap<FName, FIndexedDialogue> Documents;
+
+	/** Entries containing each indexed word */
+	TMap<FString, TArray<FPosting>> Postings;
+
+	/** All indexed words in order, for prefix lookups. Built on demand */
+	mutable TArray<FString> SortedTokens;
+	mutable bool bSortedTokensDirty = true;
+
+	/** Dialogues waiting to be indexed */
+	TArray<FName> PendingPackages;
+
+	/** Dialogues currently loading in the background */
+	TSet<FName> LoadingPackages;
+
+	/** Whether the index has changed since it was last saved */
+	bool bCacheDirty = false;
+
+	/** Whether the index has changed since listeners were last notified */
+	bool bIndexChanged = false;
+
+	/** Broadcast whenever the index changes */
+	FSimpleMulticastDelegate IndexChangedEvent;
+
+	/** Listener handles */
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
@@ -0,0 +1,95 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+//Plugin
+#include "Search/DialogueSearchIndex.h"
+
+class ITableRow;
+class STableViewBase;
+
+/**
+* Panel for searching the text, speakers, events and conditions of every
+* dialogue in the project. Double clicking a result opens its dialogue and
+* focuses the matching node.
+*/
+class SDialogueSearch : public SCompoundWidget
+{
+public:
+	/** Slate Arguments */
+	SLATE_BEGIN_ARGS(SDialogueSearch) {}
+	SLATE_END_ARGS()
+
+	/** Slate Constructor */
+	void Construct(const FArguments& InArgs);
+
+	/** Destructor */
+	virtual ~SDialogueSearch();
+
+public:
+	/** The ID of the search tab */
+	static const FName TabID;
+
+private:
+	/**
+	* Updates the results whenever the search text changes.
+	*
+	* @param InText - const FText&, the new search text.
+	*/
+	void OnSearchTextChanged(const FText& InText);
+
+	/**
+	* Reruns the current search against the index.
+	*/
+	void RefreshResults();
+
+	/**
+	* Creates the row for a single search result.
+	*
+	* @param InResult - TSharedPtr<FDialogueSearchResult>, the result.
+	* @param OwnerTable - const TSharedRef<STableViewBase>&, the list.
+	* @return TSharedRef<ITableRow> - the created row.
+	*/
+	TSharedRef<ITableRow> OnGenerateRow(
+		TSharedPtr<FDialogueSearchResult> InResult,
+		const TSharedRef<STableViewBase>& OwnerTable) const;
+
+	/**
+	* Opens the result's dialogue and jumps to the matching node.
+	*
+	* @param InResult - TSharedPtr<FDialogueSearchResult>, the result.
+	*/
+	void OnResultDoubleClicked(TSharedPtr<FDialogueSearchResult> InResult);
+
+	/**
+	* Gets the text describing the state of the index and search.
+	*
+	* @return FText - the status text.
+	*/
+	FText GetStatusText() const;
+
+	/**
+	* Gets the display label for a search field. Static.
+	*
+	* @param InField - EDialogueSearchField, the field.
+	* @return FText - the label.
+	*/
+	static FText GetFieldText(EDialogueSearchField InField);
+
+private:
+	/** The current search text */
+	FString SearchText;
+
+	/** Results of the current search */
+	TArray<TSharedPtr<FDialogueSearchResult>> Results;
+
+	/** The list showing the results */
+	TSharedPtr<SListView<TSharedPtr<FDialogueSearchResult>>> ResultsView;
+
+	/** Handle for the index's change event */
+	FDelegateHandle IndexChangedHandle;
+};
@@ -14,6 +14,11 @@ void UDialogueCondition::SetQuery(UDialogueQuery* InQuery)
     );
 }
 
+UDialogueQuery* UDialogueCondition::GetQuery() const
+{
+    return nullptr;
+}
+
 void UDialogueCondition::SetDialogue(UDialogue* InDialogue)
 {
     UE_LOG(
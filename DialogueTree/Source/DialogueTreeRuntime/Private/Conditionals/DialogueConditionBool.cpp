@@ -29,6 +29,11 @@ void UDialogueConditionBool::SetQuery(UDialogueQuery* InQuery)
 	check(Query)
 }
 
+UDialogueQuery* UDialogueConditionBool::GetQuery() const
+{
+	return Query;
+}
+
 void UDialogueConditionBool::SetDialogue(UDialogue* InDialogue)
 {
 	check(InDialogue);
@@ -68,4 +73,14 @@ bool UDialogueConditionBool::IsValidCondition()
 	return false;
 }
 
+void UDialogueConditionBool::SetQueryTrue(bool bInQueryTrue)
+{
+	QueryTrue = bInQueryTrue;
+}
+
+bool UDialogueConditionBool::GetQueryTrue() const
+{
+	return QueryTrue;
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
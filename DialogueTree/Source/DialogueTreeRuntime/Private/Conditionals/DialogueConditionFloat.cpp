@@ -29,6 +29,11 @@ void UDialogueConditionFloat::SetQuery(UDialogueQuery* InQuery)
 	check(Query);
 }
 
+UDialogueQuery* UDialogueConditionFloat::GetQuery() const
+{
+	return Query;
+}
+
 void UDialogueConditionFloat::SetDialogue(UDialogue* InDialogue)
 {
 	check(InDialogue);
@@ -33,6 +33,11 @@ void UDialogueConditionInt::SetQuery(UDialogueQuery* InQuery)
     check(Query);
 }
 
+UDialogueQuery* UDialogueConditionInt::GetQuery() const
+{
+    return Query;
+}
+
 void UDialogueConditionInt::SetDialogue(UDialogue* InDialogue)
 {
     check(InDialogue);
@@ -0,0 +1,48 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/NodeSpokenRecentlyQuery.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueNodeSocket.h"
+#include "LogDialogueTree.h"
+
+#define LOCTEXT_NAMESPACE "NodeSpokenRecentlyQuery"
+
+bool UNodeSpokenRecentlyQuery::ExecuteQuery()
+{
+	if (!TargetNode->GetDialogueNode()) //Should not be possible, close dialogue
+	{
+		UE_LOG(
+			LogDialogueTree, 
+			Error, 
+			TEXT("Closing dialogue: Attempted to execute a Node Spoken "
+				"Recently Query on a nullptr")
+		);
+		
+		GetDialogue()->EndDialogue();
+		return false;
+	}
+
+	return GetDialogue()->WasNodeSpokenRecently(TargetNode->GetDialogueNode());
+}
+
+FText UNodeSpokenRecentlyQuery::GetGraphDescription_Implementation() const
+{
+	//Get the node's ID 
+	if (!TargetNode)
+	{
+		return LOCTEXT("Invalid node", "Invalid Node");
+	}
+	FText NodeID = TargetNode->GetDisplayID();
+
+	//Return the display text
+	FText BaseText =
+		LOCTEXT("BaseDisplayText", "{0} was spoken recently");
+	return FText::Format(
+		BaseText,
+		NodeID
+	);
+}
+
+#undef LOCTEXT_NAMESPACE
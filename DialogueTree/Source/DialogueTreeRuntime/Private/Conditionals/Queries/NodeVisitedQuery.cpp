@@ -75,4 +75,9 @@ UDialogueNodeSocket* UNodeVisitedQuery::GetSocket()
 	return TargetNode;
 }
 
+void UNodeVisitedQuery::SetSocket(UDialogueNodeSocket* InSocket)
+{
+	TargetNode = InSocket;
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
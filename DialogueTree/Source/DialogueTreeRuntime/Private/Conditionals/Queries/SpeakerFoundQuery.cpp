@@ -12,7 +12,7 @@ bool USpeakerFoundQuery::ExecuteQuery()
 {
 	check(Speaker);
 
-	return GetDialogue()->SpeakerIsPresent(Speaker->GetSpeakerName());
+	return Speaker->GetSpeakerComponent(GetDialogue()) != nullptr;
 }
 
 FText USpeakerFoundQuery::GetGraphDescription_Implementation() const
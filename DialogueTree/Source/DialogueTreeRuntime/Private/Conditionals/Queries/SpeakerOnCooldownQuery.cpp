@@ -0,0 +1,40 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/SpeakerOnCooldownQuery.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueSpeakerSocket.h"
+
+#define LOCTEXT_NAMESPACE "SpeakerOnCooldownQuery"
+
+bool USpeakerOnCooldownQuery::ExecuteQuery()
+{
+	check(Speaker);
+
+	return GetDialogue()->IsSpeakerOnCooldown(
+		Speaker->GetSpeakerComponent(GetDialogue())
+	);
+}
+
+FText USpeakerOnCooldownQuery::GetGraphDescription_Implementation() const
+{
+	//Get the speaker name from the arg texts
+	if (!Speaker)
+	{
+		return LOCTEXT("InvalidSpeaker", "Invalid Speaker for Query");
+	}
+
+	FText SpeakerNameText = FText::FromName(Speaker->GetSpeakerName());
+
+	//Construct and return the display text
+	FText BaseText = LOCTEXT("BaseText", "{0} on cooldown");
+	return FText::Format(BaseText, SpeakerNameText);
+}
+
+bool USpeakerOnCooldownQuery::IsValidQuery() const
+{
+	return Speaker && Speaker->IsValidSocket();
+}
+
+#undef LOCTEXT_NAMESPACE
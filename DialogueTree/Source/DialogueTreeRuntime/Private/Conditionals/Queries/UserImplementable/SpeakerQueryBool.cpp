@@ -10,12 +10,12 @@
 
 bool USpeakerQueryBool::ExecuteQuery()
 {
-    //Try to get the speaker component
-    UDialogueSpeakerComponent* SpeakerComponent =
-        Speaker->GetSpeakerComponent(GetDialogue());
+    //Try to get the speaker entry
+    const FSpeakerActorEntry& TargetSpeaker =
+        Speaker->GetSpeakerEntry(GetDialogue());
 
     //If not found, end the dialogue
-    if (!SpeakerComponent)
+    if (!TargetSpeaker.SpeakerComponent)
     {
         UE_LOG(
             LogDialogueTree,
@@ -27,16 +27,14 @@ bool USpeakerQueryBool::ExecuteQuery()
         return false;
     }
 
-    //Convert main speaker to entry struct
-    FSpeakerActorEntry TargetSpeaker = SpeakerComponent->ToSpeakerActorEntry();
-
     //Repeat with any additional speakers
     TArray<FSpeakerActorEntry> OtherSpeakers;
+    OtherSpeakers.Reserve(AdditionalSpeakers.Num());
     for (UDialogueSpeakerSocket* Socket : AdditionalSpeakers)
     {
-        UDialogueSpeakerComponent* SocketComponent =
-            Socket->GetSpeakerComponent(GetDialogue());
-        if (!SocketComponent)
+        const FSpeakerActorEntry& SocketEntry =
+            Socket->GetSpeakerEntry(GetDialogue());
+        if (!SocketEntry.SpeakerComponent)
         {
             UE_LOG(
                 LogDialogueTree,
@@ -46,8 +44,6 @@ bool USpeakerQueryBool::ExecuteQuery()
             return false;
         }
 
-        FSpeakerActorEntry SocketEntry =
-            SocketComponent->ToSpeakerActorEntry();
         OtherSpeakers.Add(SocketEntry);
     }
 
@@ -10,10 +10,10 @@
 
 double USpeakerQueryFloat::ExecuteQuery()
 {
-    //Try to get the speaker component
-    UDialogueSpeakerComponent* SpeakerComponent =
-        Speaker->GetSpeakerComponent(GetDialogue());
-    if (!SpeakerComponent)
+    //Try to get the speaker entry
+    const FSpeakerActorEntry& TargetSpeaker =
+        Speaker->GetSpeakerEntry(GetDialogue());
+    if (!TargetSpeaker.SpeakerComponent)
     {
         UE_LOG(
             LogDialogueTree,
@@ -25,16 +25,14 @@ double USpeakerQueryFloat::ExecuteQuery()
         return false;
     }
 
-    //Convert main speaker to entry struct
-    FSpeakerActorEntry TargetSpeaker = SpeakerComponent->ToSpeakerActorEntry();
-
     //Repeat with any additional speakers
     TArray<FSpeakerActorEntry> OtherSpeakers;
+    OtherSpeakers.Reserve(AdditionalSpeakers.Num());
     for (UDialogueSpeakerSocket* Socket : AdditionalSpeakers)
     {
-        UDialogueSpeakerComponent* SocketComponent =
-            Socket->GetSpeakerComponent(GetDialogue());
-        if (!SocketComponent)
+        const FSpeakerActorEntry& SocketEntry =
+            Socket->GetSpeakerEntry(GetDialogue());
+        if (!SocketEntry.SpeakerComponent)
         {
             UE_LOG(
                 LogDialogueTree,
@@ -44,8 +42,6 @@ double USpeakerQueryFloat::ExecuteQuery()
             return false;
         }
 
-        FSpeakerActorEntry SocketEntry =
-            SocketComponent->ToSpeakerActorEntry();
         OtherSpeakers.Add(SocketEntry);
     }
 
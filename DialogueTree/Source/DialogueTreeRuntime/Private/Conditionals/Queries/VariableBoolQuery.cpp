@@ -0,0 +1,49 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/VariableBoolQuery.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "VariableBoolQuery"
+
+void UVariableBoolQuery::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(EDialogueVariableType::Bool);
+}
+
+#if WITH_EDITOR
+void UVariableBoolQuery::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(EDialogueVariableType::Bool);
+}
+#endif
+
+bool UVariableBoolQuery::ExecuteQuery()
+{
+	const int32 Slot = Variable.GetSlot(EDialogueVariableType::Bool);
+	const FDialogueVariableBlock* Block = Variable.FindBlock(GetDialogue());
+	return Block && Block->GetBool(Slot);
+}
+
+FText UVariableBoolQuery::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("InvalidVariable", "Invalid Variable for Query");
+	}
+
+	return Variable.GetDisplayText();
+}
+
+bool UVariableBoolQuery::IsValidQuery() const
+{
+	return Variable.IsValidVariable();
+}
+
+#undef LOCTEXT_NAMESPACE
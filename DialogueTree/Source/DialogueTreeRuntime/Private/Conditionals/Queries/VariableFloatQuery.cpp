@@ -0,0 +1,54 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/VariableFloatQuery.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "VariableFloatQuery"
+
+void UVariableFloatQuery::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(EDialogueVariableType::Float);
+}
+
+#if WITH_EDITOR
+void UVariableFloatQuery::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(EDialogueVariableType::Float);
+}
+#endif
+
+double UVariableFloatQuery::ExecuteQuery()
+{
+	const int32 Slot = Variable.GetSlot(EDialogueVariableType::Float);
+	const FDialogueVariableBlock* Block = Variable.FindBlock(GetDialogue());
+	if (!Block)
+	{
+		return 0.0;
+	}
+
+	return Block->GetFloat(Slot);
+}
+
+FText UVariableFloatQuery::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("InvalidVariable", "Invalid Variable for Query");
+	}
+
+	return Variable.GetDisplayText();
+}
+
+bool UVariableFloatQuery::IsValidQuery() const
+{
+	return Variable.IsValidVariable();
+}
+
+#undef LOCTEXT_NAMESPACE
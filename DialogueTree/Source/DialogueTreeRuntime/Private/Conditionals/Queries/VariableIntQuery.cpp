@@ -0,0 +1,54 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/VariableIntQuery.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "VariableIntQuery"
+
+void UVariableIntQuery::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(EDialogueVariableType::Int);
+}
+
+#if WITH_EDITOR
+void UVariableIntQuery::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(EDialogueVariableType::Int);
+}
+#endif
+
+int32 UVariableIntQuery::ExecuteQuery()
+{
+	const int32 Slot = Variable.GetSlot(EDialogueVariableType::Int);
+	const FDialogueVariableBlock* Block = Variable.FindBlock(GetDialogue());
+	if (!Block)
+	{
+		return 0;
+	}
+
+	return Block->GetInt(Slot);
+}
+
+FText UVariableIntQuery::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("InvalidVariable", "Invalid Variable for Query");
+	}
+
+	return Variable.GetDisplayText();
+}
+
+bool UVariableIntQuery::IsValidQuery() const
+{
+	return Variable.IsValidVariable();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,55 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/VariableNameQuery.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "VariableNameQuery"
+
+void UVariableNameQuery::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(EDialogueVariableType::Name);
+}
+
+#if WITH_EDITOR
+void UVariableNameQuery::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(EDialogueVariableType::Name);
+}
+#endif
+
+bool UVariableNameQuery::ExecuteQuery()
+{
+	const int32 Slot = Variable.GetSlot(EDialogueVariableType::Name);
+	const FDialogueVariableBlock* Block = Variable.FindBlock(GetDialogue());
+	const FName CurrentValue = Block ? Block->GetName(Slot) : NAME_None;
+	return CurrentValue == Value;
+}
+
+FText UVariableNameQuery::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("InvalidVariable", "Invalid Variable for Query");
+	}
+
+	FText BaseText = LOCTEXT("BaseText", "{0} is {1}");
+	return FText::Format(
+		BaseText,
+		Variable.GetDisplayText(),
+		FText::FromName(Value)
+	);
+}
+
+bool UVariableNameQuery::IsValidQuery() const
+{
+	return Variable.IsValidVariable();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,54 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Conditionals/Queries/VariableTagQuery.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "VariableTagQuery"
+
+void UVariableTagQuery::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(EDialogueVariableType::Tag);
+}
+
+#if WITH_EDITOR
+void UVariableTagQuery::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(EDialogueVariableType::Tag);
+}
+#endif
+
+bool UVariableTagQuery::ExecuteQuery()
+{
+	const int32 Slot = Variable.GetSlot(EDialogueVariableType::Tag);
+	const FDialogueVariableBlock* Block = Variable.FindBlock(GetDialogue());
+	return Block && Block->GetTag(Slot).MatchesTag(Value);
+}
+
+FText UVariableTagQuery::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("InvalidVariable", "Invalid Variable for Query");
+	}
+
+	FText BaseText = LOCTEXT("BaseText", "{0} matches {1}");
+	return FText::Format(
+		BaseText,
+		Variable.GetDisplayText(),
+		FText::FromName(Value.GetTagName())
+	);
+}
+
+bool UVariableTagQuery::IsValidQuery() const
+{
+	return Variable.IsValidVariable() && Value.IsValid();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -4,13 +4,27 @@
 #include "Dialogue.h"
 //UE
 #include "EdGraph/EdGraph.h"
+#include "Internationalization/StringTable.h"
+#include "Internationalization/StringTableCore.h"
 #include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
 //Plugin
+#include "DialogueBarkSubsystem.h"
 #include "DialogueController.h"
+#include "DialogueLODSubsystem.h"
+#include "DialogueSettings.h"
 #include "DialogueSpeakerComponent.h"
 #include "DialogueSpeakerSocket.h"
 #include "LogDialogueTree.h"
+#include "Events/DialogueEventBase.h"
+#include "Nodes/DialogueBranchNode.h"
 #include "Nodes/DialogueEntryNode.h"
+#include "Nodes/DialogueJumpNode.h"
+#include "Nodes/DialogueOptionLockNode.h"
+#include "Nodes/DialogueSpeechNode.h"
 
 FColor FDefaultDialogueColors::PopColor()
 {
@@ -21,12 +35,205 @@ FColor FDefaultDialogueColors::PopColor()
 	return TargetColor;
 }
 
+const FName UDialogue::SpeakerRolesTag = FName(TEXT("SpeakerRoles"));
+const FName UDialogue::CompileStatusTag = FName(TEXT("CompileStatus"));
+const FName UDialogue::NumNodesTag = FName(TEXT("NumNodes"));
+const FName UDialogue::NumSpeechNodesTag = FName(TEXT("NumSpeechNodes"));
+const FName UDialogue::NumEventNodesTag = FName(TEXT("NumEventNodes"));
+const FName UDialogue::NumBranchNodesTag = FName(TEXT("NumBranchNodes"));
+const FName UDialogue::NumOptionLockNodesTag = 
+	FName(TEXT("NumOptionLockNodes"));
+const FName UDialogue::NumJumpNodesTag = FName(TEXT("NumJumpNodes"));
+const FName UDialogue::NumVoicedSpeechesTag = 
+	FName(TEXT("NumVoicedSpeeches"));
+const FName UDialogue::WordCountTag = FName(TEXT("WordCount"));
+const FName UDialogue::EventClassesTag = FName(TEXT("EventClasses"));
+const FName UDialogue::ReferencedAudioTag = FName(TEXT("ReferencedAudio"));
+
 UDialogue::UDialogue()
 {
 	//Add default speakers
 	AddDefaultSpeakers();
 }
 
+void UDialogue::PostLoad()
+{
+	Super::PostLoad();
+
+	//Dialogues compiled before speaker slots existed take their roles as is
+	if (SpeakerSlotNames.IsEmpty() 
+		&& CompileStatus == EDialogueCompileStatus::Compiled)
+	{
+		for (const TPair<FName, FSpeakerField>& Entry : SpeakerRoles)
+		{
+			AddSpeakerEntry(Entry.Key);
+		}
+	}
+}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+void UDialogue::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	TArray<FAssetRegistryTag> Tags;
+	GatherAssetRegistryTags(Tags);
+	for (FAssetRegistryTag& Tag : Tags)
+	{
+		Context.AddTag(MoveTemp(Tag));
+	}
+}
+#else
+void UDialogue::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+	GatherAssetRegistryTags(OutTags);
+}
+#endif
+
+void UDialogue::GatherAssetRegistryTags(
+	TArray<FAssetRegistryTag>& OutTags) const
+{
+	//Speaker roles 
+	TArray<FString> RoleNames;
+	for (const TPair<FName, FSpeakerField>& Role : SpeakerRoles)
+	{
+		RoleNames.Add(Role.Key.ToString());
+	}
+	RoleNames.Sort();
+
+	//Tally the compiled nodes by type 
+	int32 NumSpeechNodes = 0;
+	int32 NumEventNodes = 0;
+	int32 NumBranchNodes = 0;
+	int32 NumOptionLockNodes = 0;
+	int32 NumJumpNodes = 0;
+	int32 NumVoicedSpeeches = 0;
+	int32 WordCount = 0;
+	TSet<FString> EventClasses;
+	TSet<FString> AudioPaths;
+
+	for (const TPair<FName, TObjectPtr<UDialogueNode>>& Entry : DialogueNodes)
+	{
+		const UDialogueNode* Node = Entry.Value;
+		if (Node == nullptr)
+		{
+			continue;
+		}
+
+		if (const UDialogueEventNode* EventNode = 
+			Cast<UDialogueEventNode>(Node))
+		{
+			for (const UDialogueEventBase* Event : EventNode->GetEvents())
+			{
+				if (Event)
+				{
+					EventClasses.Add(Event->GetClass()->GetPathName());
+				}
+			}
+		}
+
+		if (const UDialogueSpeechNode* SpeechNode = 
+			Cast<UDialogueSpeechNode>(Node))
+		{
+			const FSpeechDetails& Details = SpeechNode->GetDetails();
+			if (Details.SpeechAudio)
+			{
+				AudioPaths.Add(Details.SpeechAudio->GetPathName());
+				++NumVoicedSpeeches;
+			}
+
+			TArray<FString> Words;
+			WordCount += Details.SpeechText.ToString().ParseIntoArrayWS(Words);
+			++NumSpeechNodes;
+		}
+		else if (Node->IsA<UDialogueEventNode>())
+		{
+			++NumEventNodes;
+		}
+		else if (Node->IsA<UDialogueBranchNode>())
+		{
+			++NumBranchNodes;
+		}
+		else if (Node->IsA<UDialogueOptionLockNode>())
+		{
+			++NumOptionLockNodes;
+		}
+		else if (Node->IsA<UDialogueJumpNode>())
+		{
+			++NumJumpNodes;
+		}
+	}
+
+	TArray<FString> SortedEventClasses = EventClasses.Array();
+	SortedEventClasses.Sort();
+	TArray<FString> SortedAudioPaths = AudioPaths.Array();
+	SortedAudioPaths.Sort();
+
+	OutTags.Add(FAssetRegistryTag(
+		SpeakerRolesTag, 
+		FString::Join(RoleNames, TEXT(",")), 
+		FAssetRegistryTag::TT_Alphabetical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		CompileStatusTag, 
+		StaticEnum<EDialogueCompileStatus>()->GetNameStringByValue(
+			static_cast<int64>(CompileStatus)
+		),
+		FAssetRegistryTag::TT_Alphabetical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumNodesTag, 
+		LexToString(DialogueNodes.Num()), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumSpeechNodesTag, 
+		LexToString(NumSpeechNodes), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumEventNodesTag, 
+		LexToString(NumEventNodes), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumBranchNodesTag, 
+		LexToString(NumBranchNodes), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumOptionLockNodesTag, 
+		LexToString(NumOptionLockNodes), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumJumpNodesTag, 
+		LexToString(NumJumpNodes), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		NumVoicedSpeechesTag, 
+		LexToString(NumVoicedSpeeches), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		WordCountTag, 
+		LexToString(WordCount), 
+		FAssetRegistryTag::TT_Numerical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		EventClassesTag, 
+		FString::Join(SortedEventClasses, TEXT(",")), 
+		FAssetRegistryTag::TT_Alphabetical
+	));
+	OutTags.Add(FAssetRegistryTag(
+		ReferencedAudioTag,
+		FString::Join(SortedAudioPaths, TEXT(",")),
+		FAssetRegistryTag::TT_Alphabetical
+	));
+}
+
 #if WITH_EDITOR
 
 void UDialogue::PostEditChangeProperty(
@@ -47,28 +254,77 @@ void UDialogue::PostEditChangeProperty(
 
 void UDialogue::SetSpeaker(FName InName, UDialogueSpeakerComponent* InSpeaker)
 {
-	if (Speakers.Contains(InName))
+	const int32 Slot = GetSpeakerSlot(InName);
+	if (!SpeakerSlots.IsValidIndex(Slot))
 	{
-		Speakers[InName] = InSpeaker;
+		return;
 	}
+
+	SpeakerSlots[Slot] = InSpeaker 
+		? InSpeaker->ToSpeakerActorEntry() 
+		: FSpeakerActorEntry();
 }
 
 UDialogueSpeakerComponent* UDialogue::GetSpeaker(FName InName) const
 {
-	if (Speakers.Contains(InName))
-	{
-		return Speakers[InName];
-	}
-
-	return nullptr;
+	return GetSpeakerInSlot(GetSpeakerSlot(InName));
 }
 
 void UDialogue::AddSpeakerEntry(FName InName)
 {
-	if (!Speakers.Contains(InName))
+	SpeakerSlotNames.AddUnique(InName);
+}
+
+int32 UDialogue::GetSpeakerSlot(FName InName) const
+{
+	return SpeakerSlotNames.IndexOfByKey(InName);
+}
+
+FName UDialogue::GetSpeakerSlotName(int32 InSlot) const
+{
+	return SpeakerSlotNames.IsValidIndex(InSlot) 
+		? SpeakerSlotNames[InSlot] 
+		: NAME_None;
+}
+
+const TArray<FName>& UDialogue::GetSpeakerSlotNames() const
+{
+	return SpeakerSlotNames;
+}
+
+UDialogueSpeakerComponent* UDialogue::GetSpeakerInSlot(int32 InSlot) const
+{
+	return SpeakerSlots.IsValidIndex(InSlot) 
+		? SpeakerSlots[InSlot].SpeakerComponent 
+		: nullptr;
+}
+
+const FSpeakerActorEntry& UDialogue::GetSpeakerEntryInSlot(int32 InSlot) 
+	const
+{
+	static const FSpeakerActorEntry EmptyEntry;
+	return SpeakerSlots.IsValidIndex(InSlot) 
+		? SpeakerSlots[InSlot] 
+		: EmptyEntry;
+}
+
+bool UDialogue::HasSpeakerComponent(
+	const UDialogueSpeakerComponent* InSpeaker) const
+{
+	if (!InSpeaker)
+	{
+		return false;
+	}
+
+	for (const FSpeakerActorEntry& Entry : SpeakerSlots)
 	{
-		Speakers.Add(InName, nullptr);
+		if (Entry.SpeakerComponent == InSpeaker)
+		{
+			return true;
+		}
 	}
+
+	return false;
 }
 
 void UDialogue::OpenDialogueAt(FName InNodeID, ADialogueController* InController, TMap<FName, UDialogueSpeakerComponent*> InSpeakers)
@@ -103,6 +359,27 @@ void UDialogue::OpenDialogueAt(FName InNodeID, ADialogueController* InController
 	//Fill the speakers with the provided values 
 	FillSpeakers(InSpeakers);
 
+	//Conversations take precedence over barks
+	if (UDialogueBarkSubsystem* BarkSubsystem =
+		InController->GetWorld()->GetSubsystem<UDialogueBarkSubsystem>())
+	{
+		for (const FSpeakerActorEntry& Entry : SpeakerSlots)
+		{
+			if (Entry.SpeakerComponent)
+			{
+				BarkSubsystem->StopBark(Entry.SpeakerComponent);
+			}
+		}
+	}
+
+	//Pick the level of detail before the first line plays
+	if (UDialogueLODSubsystem* LODSubsystem =
+		InController->GetWorld()->GetSubsystem<UDialogueLODSubsystem>())
+	{
+		LOD = LODSubsystem->GetDialogueLOD(this);
+		LODSubsystem->RegisterDialogue(this);
+	}
+
 	//Traverse the first node 
 	UDialogueNode* StartNode = DialogueNodes[InNodeID];
 	check(StartNode);
@@ -111,7 +388,38 @@ void UDialogue::OpenDialogueAt(FName InNodeID, ADialogueController* InController
 
 void UDialogue::ClearController()
 {
+	//Stop keeping the level of detail up to date
+	UDialogueLODSubsystem* LODSubsystem = DialogueController
+		? DialogueController->GetWorld()->GetSubsystem<UDialogueLODSubsystem>()
+		: nullptr;
+	if (LODSubsystem)
+	{
+		LODSubsystem->UnregisterDialogue(this);
+	}
+
 	DialogueController = nullptr;
+	LOD = EDialogueLOD::Full;
+}
+
+EDialogueLOD UDialogue::GetLOD() const
+{
+	return LOD;
+}
+
+void UDialogue::SetLOD(EDialogueLOD InLOD)
+{
+	if (InLOD == LOD)
+	{
+		return;
+	}
+
+	const EDialogueLOD OldLOD = LOD;
+	LOD = InLOD;
+
+	if (ActiveNode && DialogueController)
+	{
+		ActiveNode->OnLODChanged(OldLOD);
+	}
 }
 
 void UDialogue::EndDialogue() const
@@ -123,22 +431,29 @@ void UDialogue::EndDialogue() const
 	}
 }
 
-void UDialogue::DisplaySpeech(const FSpeechDetails& InDetails) const
+void UDialogue::DisplaySpeech(const FSpeechDetails& InDetails, 
+	int32 InSpeakerSlot) const
 {
-	if (!Speakers[InDetails.SpeakerName] || !DialogueController)
+	UDialogueSpeakerComponent* Speaker = GetSpeakerInSlot(InSpeakerSlot);
+	if (!Speaker || !DialogueController)
 	{
 		EndDialogue();
 		return;
 	}
 
-	DialogueController->DisplaySpeech(
-		InDetails,
-		Speakers[InDetails.SpeakerName]
-	);
-	DialogueController->OnDialogueSpeechDisplayed.Broadcast(InDetails);
+	DialogueController->NativeDisplaySpeech(InDetails, Speaker);
+}
+
+const IDialogueTextArgumentProvider* UDialogue::GetTextArgumentProvider() 
+	const
+{
+	return DialogueController 
+		? DialogueController->GetTextArgumentProvider() 
+		: nullptr;
 }
 
-void UDialogue::DisplayOptions(TArray<FDialogueOption> InOptions) const
+void UDialogue::DisplayOptions(TConstArrayView<FDialogueOption> InOptions) 
+	const
 {
 	if (!DialogueController)
 	{
@@ -150,13 +465,7 @@ void UDialogue::DisplayOptions(TArray<FDialogueOption> InOptions) const
 		return;
 	}
 
-	TArray<FSpeechDetails> AllDetails;
-	for (FDialogueOption Option : InOptions)
-	{
-		AllDetails.Add(Option.Details);
-	}
-
-	DialogueController->DisplayOptions(AllDetails);
+	DialogueController->NativeDisplayOptions(InOptions);
 }
 
 void UDialogue::SelectOption(int32 InOptionIndex) const
@@ -203,13 +512,18 @@ EDialogueCompileStatus UDialogue::GetCompileStatus() const
 	return CompileStatus;
 }
 
+uint32 UDialogue::GetCompileSerial() const
+{
+	return CompileSerial;
+}
+
 TMap<FName, UDialogueSpeakerComponent*> UDialogue::GetAllSpeakers() const
 {
-	//Have to manually copy to handle conversion from TObjectPtr
 	TMap<FName, UDialogueSpeakerComponent*> AllSpeakers;
-	for (auto& Speaker : Speakers)
+	AllSpeakers.Reserve(SpeakerSlotNames.Num());
+	for (int32 Slot = 0; Slot < SpeakerSlotNames.Num(); ++Slot)
 	{
-		AllSpeakers.Add(Speaker.Key, Speaker.Value);
+		AllSpeakers.Add(SpeakerSlotNames[Slot], GetSpeakerInSlot(Slot));
 	}
 	return AllSpeakers;
 }
@@ -256,6 +570,65 @@ void UDialogue::MarkNodeVisited(UDialogueNode* TargetNode, bool bVisited)
 	}
 }
 
+bool UDialogue::WasNodeSpokenRecently(UDialogueNode* TargetNode) const
+{
+	if (!DialogueController || !TargetNode
+		|| !DialogueNodes.Contains(TargetNode->GetNodeID()))
+	{
+		return false;
+	}
+
+	return DialogueController->WasLineSpokenRecently(
+		this,
+		TargetNode->GetNodeID()
+	);
+}
+
+void UDialogue::MarkSpeechSpoken(UDialogueSpeechNode* InNode)
+{
+	if (!DialogueController || !InNode)
+	{
+		return;
+	}
+
+	DialogueController->MarkLineSpoken(
+		this,
+		InNode->GetNodeID(),
+		InNode->GetCooldown()
+	);
+
+	if (UDialogueSpeakerComponent* Speaker = InNode->GetSpeaker())
+	{
+		DialogueController->StartSpeakerCooldown(
+			Speaker->GetDialogueName(),
+			Speaker->SpeakerCooldown
+		);
+	}
+}
+
+bool UDialogue::IsSpeakerOnCooldown(UDialogueSpeakerComponent* InSpeaker) 
+	const
+{
+	if (!DialogueController || !InSpeaker)
+	{
+		return false;
+	}
+
+	return DialogueController->IsSpeakerOnCooldown(
+		InSpeaker->GetDialogueName()
+	);
+}
+
+FDialogueVariableStore* UDialogue::GetVariables() const
+{
+	if (!DialogueController)
+	{
+		return nullptr;
+	}
+
+	return &DialogueController->GetVariables();
+}
+
 void UDialogue::ClearAllNodeVisits()
 {
 	if (!DialogueController)
@@ -285,6 +658,21 @@ UDialogueNode* UDialogue::GetRootNode() const
 	return RootNode;
 }
 
+const TMap<FName, TObjectPtr<UDialogueNode>>& UDialogue::GetNodes() const
+{
+	return DialogueNodes;
+}
+
+FText UDialogue::ResolveText(const FString& InKey) const
+{
+	if (InKey.IsEmpty() || !TextTable)
+	{
+		return FText::GetEmpty();
+	}
+
+	return FText::FromStringTable(TextTable->GetStringTableId(), InKey);
+}
+
 #if WITH_EDITOR
 
 UEdGraph* UDialogue::GetEdGraph() const
@@ -307,6 +695,28 @@ const TMap<FName, FSpeakerField>& UDialogue::GetSpeakerRoles() const
 	return SpeakerRoles;
 }
 
+UDialogueSpeakerSocket* UDialogue::AddSpeakerRole(FName InName)
+{
+	if (FSpeakerField* ExistingField = SpeakerRoles.Find(InName))
+	{
+		return ExistingField->SpeakerSocket;
+	}
+
+	Modify();
+
+	//Create the socket for the new role
+	UDialogueSpeakerSocket* NewSocket = 
+		NewObject<UDialogueSpeakerSocket>(this);
+	NewSocket->SetSpeakerName(InName);
+
+	FSpeakerField NewField;
+	NewField.SpeakerSocket = NewSocket;
+	NewField.GraphColor = DefaultSpeakerColors.PopColor();
+	SpeakerRoles.Add(InName, NewField);
+
+	return NewSocket;
+}
+
 void UDialogue::AddNode(UDialogueNode* InNode)
 {
 	if (InNode)
@@ -337,14 +747,32 @@ void UDialogue::ClearDialogue()
 {
 	RootNode = nullptr;
 	DialogueNodes.Empty();
-	Speakers.Empty();
+	SpeakerSlotNames.Empty();
+	SpeakerSlots.Empty();
 	CompileStatus = EDialogueCompileStatus::Uncompiled;
+	++CompileSerial;
 }
 
 void UDialogue::PreCompileDialogue()
 {
 	ClearDialogue();
 
+	//Reuse the string table so its ID stays registered, or drop it
+	if (GetDefault<UDialogueSettings>()->CompileTextToStringTables)
+	{
+		if (!TextTable)
+		{
+			TextTable = NewObject<UStringTable>(this, TEXT("TextTable"));
+		}
+
+		//The namespace is taken from the first text compiled
+		TextTable->GetMutableStringTable()->ClearSourceStrings();
+	}
+	else
+	{
+		TextTable = nullptr;
+	}
+
 	//Refresh the accessible speaker component entries from their roles
 	for (auto& Entry : SpeakerRoles)
 	{
@@ -357,6 +785,60 @@ void UDialogue::SetCompileStatus(EDialogueCompileStatus InStatus)
 	CompileStatus = InStatus;
 	MarkPackageDirty(); //need to save
 }
+
+FString UDialogue::CompileText(const FText& InText,
+	const FString& InFallbackKey)
+{
+	if (!TextTable || InText.IsEmpty())
+	{
+		return FString();
+	}
+
+	FStringTableRef Table = TextTable->GetMutableStringTable();
+
+	//Translations are found by namespace and key, so both must be kept
+	const FString TextNamespace = 
+		FTextInspector::GetNamespace(InText).Get(FString());
+	bool bTableEmpty = true;
+	Table->EnumerateSourceStrings(
+		[&bTableEmpty](const FString& InKey, const FString& InSourceString)
+		{
+			bTableEmpty = false;
+			return false;
+		}
+	);
+
+	if (bTableEmpty)
+	{
+		Table->SetNamespace(TextNamespace);
+	}
+	else if (!Table->GetNamespace().Equals(
+		TextNamespace, 
+		ESearchCase::CaseSensitive))
+	{
+		return FString();
+	}
+
+	//Prefer the text's own key, falling back to a stable one
+	const TOptional<FString> TextKey = FTextInspector::GetKey(InText);
+	const FString BaseKey = TextKey.IsSet() && !TextKey->IsEmpty()
+		? TextKey.GetValue()
+		: InFallbackKey;
+
+	//The same text may be shared by several nodes, e.g. after a paste
+	const FString SourceString = InText.ToString();
+	FString Key = BaseKey;
+	FString ExistingString;
+	int32 Suffix = 1;
+	while (Table->GetSourceString(Key, ExistingString)
+		&& !ExistingString.Equals(SourceString, ESearchCase::CaseSensitive))
+	{
+		Key = FString::Printf(TEXT("%s_%d"), *BaseKey, Suffix++);
+	}
+
+	Table->SetSourceString(Key, SourceString);
+	return Key;
+}
 #endif
 
 void UDialogue::AddDefaultSpeakers()
@@ -469,28 +951,23 @@ bool UDialogue::CanPlay(ADialogueController* InController,
 
 void UDialogue::FillSpeakers(TMap<FName, UDialogueSpeakerComponent*> InSpeakers)
 {
-	//Clear speakers 
-	for (auto& Entry : Speakers)
-	{
-		Entry.Value = nullptr;
-	}
+	//One entry per slot, resolved once for the whole conversation
+	SpeakerSlots.Reset(SpeakerSlotNames.Num());
+	SpeakerSlots.SetNum(SpeakerSlotNames.Num());
 
-	//Set speakers
-	for (auto& Entry : InSpeakers)
+	for (int32 Slot = 0; Slot < SpeakerSlotNames.Num(); ++Slot)
 	{
-		if (Speakers.Contains(Entry.Key) &&
-			Entry.Value != nullptr)
+		UDialogueSpeakerComponent** Found = 
+			InSpeakers.Find(SpeakerSlotNames[Slot]);
+
+		if (Found && *Found)
 		{
-			Speakers[Entry.Key] = Entry.Value;
+			SpeakerSlots[Slot] = (*Found)->ToSpeakerActorEntry();
 		}
-	}
-
-	//Verify that no speakers are missing 
-	for (auto& Entry : Speakers)
-	{
-		if (!Entry.Value)
+		else
 		{
-			DialogueController->HandleMissingSpeaker(Entry.Key);
+			//Verify that no speakers are missing 
+			DialogueController->HandleMissingSpeaker(SpeakerSlotNames[Slot]);
 		}
 	}
 }
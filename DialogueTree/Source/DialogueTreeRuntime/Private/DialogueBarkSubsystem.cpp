@@ -0,0 +1,389 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueBarkSubsystem.h"
+//UE
+#include "Engine/World.h"
+#include "Sound/SoundBase.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueController.h"
+#include "DialogueLODSubsystem.h"
+#include "DialogueManagerSubsystem.h"
+#include "DialogueSpeakerComponent.h"
+#include "LogDialogueTree.h"
+#include "Nodes/DialogueSpeechNode.h"
+
+const int32 UDialogueBarkSubsystem::MAX_BARK_CHAIN = 8;
+
+void UDialogueBarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UDialogueLODSubsystem* LODSubsystem =
+		GetWorld()->GetSubsystem<UDialogueLODSubsystem>();
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	//Release cooldowns which ran out since the last frame
+	ADialogueController* RecordController = GetRecordController();
+	if (RecordController)
+	{
+		RecordController->AdvanceCooldowns();
+	}
+
+	//Listeners may start or stop barks from within the loop. Ended barks
+	//are only removed afterwards and new ones wait for the next tick, so
+	//indices hold throughout.
+	bTickingBarks = true;
+	const int32 NumBarks = ActiveBarks.Num();
+	for (int32 BarkIndex = 0; BarkIndex < NumBarks; ++BarkIndex)
+	{
+		UpdateLOD(BarkIndex, LODSubsystem);
+
+		const FDialogueBark& Bark = ActiveBarks[BarkIndex];
+		if (!Bark.Speaker.IsValid() || Bark.EndTime > Now)
+		{
+			continue;
+		}
+
+		//Move on to the next line, or end the bark
+		UDialogueSpeechNode* NextNode = GetNextNode(Bark);
+		if (NextNode)
+		{
+			--ActiveBarks[BarkIndex].ChainRemaining;
+			SpeakNode(BarkIndex, NextNode);
+		}
+		else
+		{
+			EndBark(BarkIndex);
+		}
+	}
+	bTickingBarks = false;
+
+	//Drop barks which ended, or whose speaker went away
+	ActiveBarks.RemoveAllSwap(
+		[](const FDialogueBark& Bark)
+		{
+			return !Bark.Speaker.IsValid();
+		}
+	);
+}
+
+TStatId UDialogueBarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(
+		UDialogueBarkSubsystem,
+		STATGROUP_Tickables
+	);
+}
+
+bool UDialogueBarkSubsystem::PlayBark(UDialogue* InDialogue,
+	UDialogueSpeakerComponent* InSpeaker, FName InNodeID,
+	bool bFollowAutoTransitions, bool bMarkVisited)
+{
+	if (!InDialogue || !InSpeaker)
+	{
+		return false;
+	}
+
+	//Conversations take precedence over barks
+	if (InSpeaker->DialogueController
+		&& InSpeaker->DialogueController->SpeakerInCurrentDialogue(InSpeaker))
+	{
+		return false;
+	}
+
+	//Find the speech to bark
+	UDialogueNode* StartNode = nullptr;
+	if (InNodeID.IsNone())
+	{
+		UDialogueNode* RootNode = InDialogue->GetRootNode();
+		StartNode = RootNode ? RootNode->GetFirstChild() : nullptr;
+	}
+	else if (const TObjectPtr<UDialogueNode>* FoundNode =
+		InDialogue->GetNodes().Find(InNodeID))
+	{
+		StartNode = *FoundNode;
+	}
+
+	UDialogueSpeechNode* SpeechNode = Cast<UDialogueSpeechNode>(StartNode);
+	if (!SpeechNode)
+	{
+		UE_LOG(
+			LogDialogueTree,
+			Warning,
+			TEXT("Could not play bark: the target node is not a speech node.")
+		);
+		return false;
+	}
+
+	//Hold off on chatty speakers and repeated lines
+	ADialogueController* RecordController = GetRecordController();
+	if (RecordController)
+	{
+		const FName SpeakerName = InSpeaker->GetDialogueName();
+		const FName NodeID = SpeechNode->GetNodeID();
+		if (RecordController->IsSpeakerOnCooldown(SpeakerName)
+			|| RecordController->WasLineSpokenRecently(InDialogue, NodeID))
+		{
+			return false;
+		}
+	}
+
+	//Each speaker barks one thing at a time
+	int32 BarkIndex = FindBark(InSpeaker);
+	if (BarkIndex == INDEX_NONE)
+	{
+		BarkIndex = ActiveBarks.AddDefaulted();
+	}
+	else
+	{
+		//Cut off whatever the speaker was saying
+		InSpeaker->StopSpeechAudio();
+	}
+
+	FDialogueBark& Bark = ActiveBarks[BarkIndex];
+	if (const UDialogueLODSubsystem* LODSubsystem =
+		GetWorld()->GetSubsystem<UDialogueLODSubsystem>())
+	{
+		Bark.LOD = LODSubsystem->GetLODAt(
+			InSpeaker->GetComponentLocation(),
+			Bark.LOD
+		);
+	}
+	Bark.Dialogue = InDialogue;
+	Bark.Speaker = InSpeaker;
+	Bark.ChainRemaining = bFollowAutoTransitions ? MAX_BARK_CHAIN - 1 : 0;
+	Bark.bMarkVisited = bMarkVisited;
+	SpeakNode(BarkIndex, SpeechNode);
+
+	return true;
+}
+
+bool UDialogueBarkSubsystem::PlayResponse(
+	UDialogueResponseDatabase* InDatabase,
+	UDialogueSpeakerComponent* InSpeaker, FDialogueResponseQuery InQuery)
+{
+	if (!InDatabase || !InSpeaker)
+	{
+		return false;
+	}
+
+	if (InQuery.SpeakerName.IsNone())
+	{
+		InQuery.SpeakerName = InSpeaker->GetDialogueName();
+	}
+
+	//Pass over lines which would be refused as repeats
+	ADialogueController* RecordController = GetRecordController();
+	UDialogue* ResponseDialogue = nullptr;
+	FName ResponseNodeID;
+	const bool bFound = InDatabase->FindFilteredResponse(
+		InQuery,
+		[RecordController](const FDialogueResponseRule& Rule)
+		{
+			return !RecordController 
+				|| !RecordController->WasLineSpokenRecently(
+					Rule.Dialogue, 
+					Rule.NodeID
+				);
+		},
+		ResponseDialogue,
+		ResponseNodeID
+	);
+	if (!bFound)
+	{
+		return false;
+	}
+
+	return PlayBark(ResponseDialogue, InSpeaker, ResponseNodeID);
+}
+
+void UDialogueBarkSubsystem::StopBark(UDialogueSpeakerComponent* InSpeaker)
+{
+	const int32 BarkIndex = FindBark(InSpeaker);
+	if (BarkIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	InSpeaker->StopSpeechAudio();
+	EndBark(BarkIndex);
+}
+
+bool UDialogueBarkSubsystem::IsBarking(
+	const UDialogueSpeakerComponent* InSpeaker) const
+{
+	return FindBark(InSpeaker) != INDEX_NONE;
+}
+
+void UDialogueBarkSubsystem::SpeakNode(int32 InBarkIndex,
+	UDialogueSpeechNode* InNode)
+{
+	FDialogueBark& Bark = ActiveBarks[InBarkIndex];
+	check(Bark.Speaker.IsValid() && InNode);
+
+	//The line takes as long whether or not anyone hears it
+	Bark.Node = InNode;
+	Bark.StartTime = GetWorld()->GetTimeSeconds();
+	Bark.EndTime = Bark.StartTime + FMath::Max(
+		InNode->GetMinimumPlayTime(),
+		InNode->GetAudioDuration()
+	);
+
+	//Copy out what is needed, as what follows may start or stop barks
+	UDialogueSpeakerComponent* Speaker = Bark.Speaker.Get();
+	UDialogue* Dialogue = Bark.Dialogue.Get();
+	const bool bMarkVisited = Bark.bMarkVisited;
+	const bool bVirtual = Bark.LOD == EDialogueLOD::Virtual;
+
+	//Note the line so it is not repeated too soon
+	ADialogueController* RecordController = GetRecordController();
+	if (RecordController && Dialogue)
+	{
+		RecordController->MarkLineSpoken(
+			Dialogue,
+			InNode->GetNodeID(),
+			InNode->GetCooldown()
+		);
+		RecordController->StartSpeakerCooldown(
+			Speaker->GetDialogueName(),
+			Speaker->SpeakerCooldown
+		);
+
+		//Visits are only tracked on request
+		if (bMarkVisited)
+		{
+			RecordController->MarkNodeVisited(Dialogue, InNode->GetNodeID());
+		}
+	}
+
+	//Far off barks run on timing alone
+	if (!bVirtual)
+	{
+		PresentNode(Speaker, InNode, 0.f);
+	}
+}
+
+void UDialogueBarkSubsystem::PresentNode(UDialogueSpeakerComponent* InSpeaker,
+	const UDialogueSpeechNode* InNode, float InStartTime)
+{
+	check(InSpeaker && InNode);
+
+	const FSpeechDetails& Details = InNode->GetDetails();
+	InSpeaker->PlaySpeechFrom(Details, InStartTime);
+
+	OnBarkNative.Broadcast(InSpeaker, Details);
+
+	//Dynamic delegates copy their parameters even with nobody bound
+	if (OnBark.IsBound())
+	{
+		OnBark.Broadcast(InSpeaker, Details);
+	}
+}
+
+void UDialogueBarkSubsystem::UpdateLOD(int32 InBarkIndex,
+	const UDialogueLODSubsystem* InLODSubsystem)
+{
+	FDialogueBark& Bark = ActiveBarks[InBarkIndex];
+	UDialogueSpeakerComponent* Speaker = Bark.Speaker.Get();
+	const UDialogueSpeechNode* Node = Bark.Node.Get();
+	if (!InLODSubsystem || !Speaker || !Node)
+	{
+		return;
+	}
+
+	const EDialogueLOD NewLOD = InLODSubsystem->GetLODAt(
+		Speaker->GetComponentLocation(),
+		Bark.LOD
+	);
+	const bool bWasVirtual = Bark.LOD == EDialogueLOD::Virtual;
+	const bool bIsVirtual = NewLOD == EDialogueLOD::Virtual;
+	const double StartTime = Bark.StartTime;
+	Bark.LOD = NewLOD;
+
+	//Only going into or out of virtual changes what is playing. The bark
+	//is not touched from here on, as listeners may start or stop barks.
+	if (bIsVirtual && !bWasVirtual)
+	{
+		Speaker->StopSpeechAudio();
+		Speaker->ClearGameplayTags();
+	}
+	else if (bWasVirtual && !bIsVirtual)
+	{
+		PresentNode(
+			Speaker,
+			Node,
+			GetWorld()->GetTimeSeconds() - StartTime
+		);
+	}
+}
+
+UDialogueSpeechNode* UDialogueBarkSubsystem::GetNextNode(
+	const FDialogueBark& InBark) const
+{
+	const UDialogueSpeechNode* CurrentNode = InBark.Node.Get();
+	if (InBark.ChainRemaining <= 0 || !CurrentNode
+		|| !CurrentNode->GetIsAutoTransition())
+	{
+		return nullptr;
+	}
+
+	//Only lines by the same speaker can follow on
+	UDialogueSpeechNode* NextNode =
+		Cast<UDialogueSpeechNode>(CurrentNode->GetFirstChild());
+	if (!NextNode
+		|| NextNode->GetSpeakerSlot() != CurrentNode->GetSpeakerSlot())
+	{
+		return nullptr;
+	}
+
+	return NextNode;
+}
+
+int32 UDialogueBarkSubsystem::FindBark(
+	const UDialogueSpeakerComponent* InSpeaker) const
+{
+	//Ended barks have no speaker, so must not match a null one
+	if (!InSpeaker)
+	{
+		return INDEX_NONE;
+	}
+
+	return ActiveBarks.IndexOfByPredicate(
+		[InSpeaker](const FDialogueBark& Bark)
+		{
+			return Bark.Speaker.Get() == InSpeaker;
+		}
+	);
+}
+
+void UDialogueBarkSubsystem::EndBark(int32 InBarkIndex)
+{
+	//Remove first, as clearing tags notifies listeners. While ticking the
+	//bark is only emptied, and removed once the tick is done.
+	UDialogueSpeakerComponent* Speaker = 
+		ActiveBarks[InBarkIndex].Speaker.Get();
+	if (bTickingBarks)
+	{
+		ActiveBarks[InBarkIndex].Speaker.Reset();
+	}
+	else
+	{
+		ActiveBarks.RemoveAtSwap(InBarkIndex);
+	}
+
+	if (Speaker)
+	{
+		Speaker->ClearGameplayTags();
+	}
+}
+
+ADialogueController* UDialogueBarkSubsystem::GetRecordController() const
+{
+	UDialogueManagerSubsystem* DialogueSubsystem =
+		GetWorld()->GetSubsystem<UDialogueManagerSubsystem>();
+	return DialogueSubsystem
+		? DialogueSubsystem->GetCurrentController()
+		: nullptr;
+}
@@ -4,12 +4,15 @@
 #include "DialogueController.h"
 //Plugin
 #include "Dialogue.h"
+#include "DialogueSettings.h"
 #include "DialogueSpeakerComponent.h"
+#include "DialogueTextArgumentProvider.h"
 #include "LogDialogueTree.h"
 //Engine
 #include "GameFramework/Actor.h"
 #include "UObject/UObjectIterator.h"
 
+const double ADialogueController::COOLDOWN_TICK_LENGTH = 0.1;
 
 // Sets default values
 ADialogueController::ADialogueController()
@@ -249,12 +252,14 @@ void ADialogueController::EndDialogue()
 	if (CurrentDialogue)
 	{
 		//Clear any behavior flags from the speakers and stop speaking
-		for (auto& Entry : CurrentDialogue->GetAllSpeakers())
+		const int32 NumSlots = CurrentDialogue->GetSpeakerSlotNames().Num();
+		for (int32 Slot = 0; Slot < NumSlots; ++Slot)
 		{
-			if (Entry.Value)
+			if (UDialogueSpeakerComponent* Speaker = 
+				CurrentDialogue->GetSpeakerInSlot(Slot))
 			{
-				Entry.Value->Stop();
-				Entry.Value->ClearGameplayTags();
+				Speaker->StopSpeechAudio();
+				Speaker->ClearGameplayTags();
 			}
 		}
 
@@ -290,17 +295,59 @@ void ADialogueController::SetSpeaker(FName InName,
 
 FDialogueRecords ADialogueController::GetDialogueRecords() const
 {
-	return DialogueRecords;
+	FDialogueRecords ExportedRecords = DialogueRecords;
+
+	//Write out whatever cooldowns are still running
+	const uint64 CurrentTick = GetCooldownTick();
+	Cooldowns.Advance(CurrentTick);
+	Cooldowns.ForEach(
+		[&ExportedRecords, CurrentTick](const FDialogueCooldownKey& Key,
+			uint64 ExpiryTick)
+		{
+			if (ExpiryTick <= CurrentTick)
+			{
+				return;
+			}
+
+			FDialogueCooldownRecord& Record = 
+				ExportedRecords.Cooldowns.AddDefaulted_GetRef();
+			Record.DialogueFName = Key.DialogueName;
+			Record.ID = Key.ID;
+			Record.RemainingTime = 
+				(ExpiryTick - CurrentTick) * COOLDOWN_TICK_LENGTH;
+		}
+	);
+
+	Variables.ExportRecords(ExportedRecords.Variables);
+
+	return ExportedRecords;
 }
 
 void ADialogueController::ClearDialogueRecords()
 {
 	DialogueRecords.Records.Empty();
+	Cooldowns.Reset();
+	Variables.Reset();
 }
 
 void ADialogueController::ImportDialogueRecords(FDialogueRecords InRecords)
 {
 	DialogueRecords = InRecords;
+
+	//Cooldowns run on the wheel rather than from the records
+	Cooldowns.Reset();
+	Cooldowns.Advance(GetCooldownTick());
+	for (const FDialogueCooldownRecord& Record : DialogueRecords.Cooldowns)
+	{
+		StartCooldown({ Record.DialogueFName, Record.ID }, 
+			Record.RemainingTime);
+	}
+	DialogueRecords.Cooldowns.Empty();
+
+	//Likewise variables, which live in the store
+	Variables.Reset();
+	Variables.ImportRecords(DialogueRecords.Variables);
+	DialogueRecords.Variables.Empty();
 }
 
 bool ADialogueController::SpeakerInCurrentDialogue(UDialogueSpeakerComponent* TargetSpeaker) const
@@ -311,23 +358,7 @@ bool ADialogueController::SpeakerInCurrentDialogue(UDialogueSpeakerComponent* Ta
 		return false;
 	}
 
-	//Retrieve speakers
-	TMap<FName, UDialogueSpeakerComponent*> Speakers =
-		CurrentDialogue->GetAllSpeakers();
-	TArray<FName> SpeakerRoles;
-	Speakers.GetKeys(SpeakerRoles);
-
-	//If any one speaker matches the target, true
-	for (FName NextRole : SpeakerRoles)
-	{
-		if (Speakers[NextRole] == TargetSpeaker)
-		{
-			return true;
-		}
-	}
-
-	//No speakers matched the target, false
-	return false;
+	return CurrentDialogue->HasSpeakerComponent(TargetSpeaker);
 }
 
 void ADialogueController::MarkNodeVisited(UDialogue* TargetDialogue, FName TargetNodeID)
@@ -419,6 +450,223 @@ bool ADialogueController::WasNodeVisited(const UDialogue* TargetDialogue,
 	return TargetRecord.VisitedNodeIDs.Contains(TargetNodeID);
 }
 
+void ADialogueController::MarkLineSpoken(UDialogue* TargetDialogue,
+	FName TargetNodeID, float InCooldown)
+{
+	if (!TargetDialogue)
+	{
+		return;
+	}
+
+	FName TargetDialogueName = TargetDialogue->GetFName();
+
+	//Remember the line among the dialogue's most recent
+	const int32 RecentLineMemory = 
+		GetDefault<UDialogueSettings>()->RecentLineMemory;
+	if (RecentLineMemory > 0)
+	{
+		FDialogueNodeVisits& Record = 
+			DialogueRecords.Records.FindOrAdd(TargetDialogueName);
+		Record.DialogueFName = TargetDialogueName;
+		Record.RecentNodeIDs.Remove(TargetNodeID);
+		Record.RecentNodeIDs.Add(TargetNodeID);
+
+		const int32 Excess = Record.RecentNodeIDs.Num() - RecentLineMemory;
+		if (Excess > 0)
+		{
+			Record.RecentNodeIDs.RemoveAt(0, Excess);
+		}
+	}
+
+	StartCooldown({ TargetDialogueName, TargetNodeID }, InCooldown);
+}
+
+bool ADialogueController::IsLineOnCooldown(const UDialogue* TargetDialogue,
+	FName TargetNodeID) const
+{
+	if (!TargetDialogue)
+	{
+		return false;
+	}
+
+	return Cooldowns.IsActive(
+		{ TargetDialogue->GetFName(), TargetNodeID }, 
+		GetCooldownTick()
+	);
+}
+
+bool ADialogueController::WasLineSpokenRecently(
+	const UDialogue* TargetDialogue, FName TargetNodeID) const
+{
+	if (!TargetDialogue)
+	{
+		return false;
+	}
+
+	if (IsLineOnCooldown(TargetDialogue, TargetNodeID))
+	{
+		return true;
+	}
+
+	const FDialogueNodeVisits* Record = 
+		DialogueRecords.Records.Find(TargetDialogue->GetFName());
+	return Record && Record->RecentNodeIDs.Contains(TargetNodeID);
+}
+
+void ADialogueController::StartSpeakerCooldown(FName InSpeakerName,
+	float InCooldown)
+{
+	if (!InSpeakerName.IsNone())
+	{
+		StartCooldown({ NAME_None, InSpeakerName }, InCooldown);
+	}
+}
+
+bool ADialogueController::IsSpeakerOnCooldown(FName InSpeakerName) const
+{
+	return Cooldowns.IsActive({ NAME_None, InSpeakerName }, GetCooldownTick());
+}
+
+FDialogueVariableStore& ADialogueController::GetVariables()
+{
+	return Variables;
+}
+
+bool ADialogueController::GetVariableBool(EDialogueVariableScope InScope,
+	FName InOwner, FName InName) const
+{
+	const FDialogueVariableBlock* Block = Variables.FindBlock(InScope, InOwner);
+	if (!Block)
+	{
+		return false;
+	}
+
+	return Block->GetBool(FDialogueVariableRegistry::Get().FindSlot(
+		EDialogueVariableType::Bool,
+		InName
+	));
+}
+
+void ADialogueController::SetVariableBool(EDialogueVariableScope InScope,
+	FName InOwner, FName InName, bool InValue)
+{
+	Variables.FindOrAddBlock(InScope, InOwner).SetBool(
+		FDialogueVariableRegistry::Get().GetSlot(
+			EDialogueVariableType::Bool,
+			InName
+		),
+		InValue
+	);
+}
+
+int32 ADialogueController::GetVariableInt(EDialogueVariableScope InScope,
+	FName InOwner, FName InName) const
+{
+	const FDialogueVariableBlock* Block = Variables.FindBlock(InScope, InOwner);
+	if (!Block)
+	{
+		return 0;
+	}
+
+	return Block->GetInt(FDialogueVariableRegistry::Get().FindSlot(
+		EDialogueVariableType::Int,
+		InName
+	));
+}
+
+void ADialogueController::SetVariableInt(EDialogueVariableScope InScope,
+	FName InOwner, FName InName, int32 InValue)
+{
+	Variables.FindOrAddBlock(InScope, InOwner).SetInt(
+		FDialogueVariableRegistry::Get().GetSlot(
+			EDialogueVariableType::Int,
+			InName
+		),
+		InValue
+	);
+}
+
+float ADialogueController::GetVariableFloat(EDialogueVariableScope InScope,
+	FName InOwner, FName InName) const
+{
+	const FDialogueVariableBlock* Block = Variables.FindBlock(InScope, InOwner);
+	if (!Block)
+	{
+		return 0.f;
+	}
+
+	return Block->GetFloat(FDialogueVariableRegistry::Get().FindSlot(
+		EDialogueVariableType::Float,
+		InName
+	));
+}
+
+void ADialogueController::SetVariableFloat(EDialogueVariableScope InScope,
+	FName InOwner, FName InName, float InValue)
+{
+	Variables.FindOrAddBlock(InScope, InOwner).SetFloat(
+		FDialogueVariableRegistry::Get().GetSlot(
+			EDialogueVariableType::Float,
+			InName
+		),
+		InValue
+	);
+}
+
+FName ADialogueController::GetVariableName(EDialogueVariableScope InScope,
+	FName InOwner, FName InName) const
+{
+	const FDialogueVariableBlock* Block = Variables.FindBlock(InScope, InOwner);
+	if (!Block)
+	{
+		return NAME_None;
+	}
+
+	return Block->GetName(FDialogueVariableRegistry::Get().FindSlot(
+		EDialogueVariableType::Name,
+		InName
+	));
+}
+
+void ADialogueController::SetVariableName(EDialogueVariableScope InScope,
+	FName InOwner, FName InName, FName InValue)
+{
+	Variables.FindOrAddBlock(InScope, InOwner).SetName(
+		FDialogueVariableRegistry::Get().GetSlot(
+			EDialogueVariableType::Name,
+			InName
+		),
+		InValue
+	);
+}
+
+FGameplayTag ADialogueController::GetVariableTag(EDialogueVariableScope InScope,
+	FName InOwner, FName InName) const
+{
+	const FDialogueVariableBlock* Block = Variables.FindBlock(InScope, InOwner);
+	if (!Block)
+	{
+		return FGameplayTag();
+	}
+
+	return Block->GetTag(FDialogueVariableRegistry::Get().FindSlot(
+		EDialogueVariableType::Tag,
+		InName
+	));
+}
+
+void ADialogueController::SetVariableTag(EDialogueVariableScope InScope,
+	FName InOwner, FName InName, FGameplayTag InValue)
+{
+	Variables.FindOrAddBlock(InScope, InOwner).SetTag(
+		FDialogueVariableRegistry::Get().GetSlot(
+			EDialogueVariableType::Tag,
+			InName
+		),
+		InValue
+	);
+}
+
 void ADialogueController::SetResumeNode(UDialogue* InDialogue, FName InNodeID)
 {
 	if (!InDialogue || InNodeID.IsNone())
@@ -436,3 +684,98 @@ void ADialogueController::SetResumeNode(UDialogue* InDialogue, FName InNodeID)
 	//Set the record's resume node 
 	DialogueRecords.Records[RecordName].ResumeNodeID = InNodeID;
 }
+
+void ADialogueController::SetTextArgumentProvider(UObject* InProvider)
+{
+	if (InProvider && !Cast<IDialogueTextArgumentProvider>(InProvider))
+	{
+		UE_LOG(
+			LogDialogueTree,
+			Warning,
+			TEXT("Text argument provider %s does not implement IDialogueTextArgumentProvider."),
+			*InProvider->GetName()
+		);
+		return;
+	}
+
+	TextArgumentProvider = InProvider;
+}
+
+const IDialogueTextArgumentProvider* 
+	ADialogueController::GetTextArgumentProvider() const
+{
+	if (TextArgumentProvider)
+	{
+		return Cast<IDialogueTextArgumentProvider>(TextArgumentProvider);
+	}
+
+	return Cast<IDialogueTextArgumentProvider>(this);
+}
+
+void ADialogueController::NativeDisplaySpeech(
+	const FSpeechDetails& InSpeechDetails, 
+	UDialogueSpeakerComponent* InSpeaker)
+{
+	OnDialogueSpeechDisplayedNative.Broadcast(InSpeechDetails);
+
+	//Blueprint events and delegates take their own copy, so only pay for it
+	//when someone is listening
+	if (GetClass()->IsFunctionImplementedInScript(
+		GET_FUNCTION_NAME_CHECKED(ADialogueController, DisplaySpeech)))
+	{
+		DisplaySpeech(InSpeechDetails, InSpeaker);
+	}
+
+	if (OnDialogueSpeechDisplayed.IsBound())
+	{
+		OnDialogueSpeechDisplayed.Broadcast(InSpeechDetails);
+	}
+}
+
+void ADialogueController::NativeDisplayOptions(
+	TConstArrayView<FDialogueOption> InOptions)
+{
+	if (!GetClass()->IsFunctionImplementedInScript(
+		GET_FUNCTION_NAME_CHECKED(ADialogueController, DisplayOptions)))
+	{
+		return;
+	}
+
+	OptionDetailsBuffer.Reset(InOptions.Num());
+	for (const FDialogueOption& Option : InOptions)
+	{
+		OptionDetailsBuffer.Add(Option.Details);
+	}
+
+	DisplayOptions(OptionDetailsBuffer);
+}
+
+void ADialogueController::StartCooldown(const FDialogueCooldownKey& InKey,
+	float InCooldown)
+{
+	if (InCooldown <= 0.f)
+	{
+		return;
+	}
+
+	//Drop anything that has run out before filing the new cooldown
+	const uint64 CurrentTick = GetCooldownTick();
+	Cooldowns.Advance(CurrentTick);
+	Cooldowns.Schedule(
+		InKey, 
+		CurrentTick + FMath::CeilToInt64(InCooldown / COOLDOWN_TICK_LENGTH)
+	);
+}
+
+void ADialogueController::AdvanceCooldowns()
+{
+	Cooldowns.Advance(GetCooldownTick());
+}
+
+uint64 ADialogueController::GetCooldownTick() const
+{
+	const UWorld* World = GetWorld();
+	return World 
+		? FMath::FloorToInt64(World->GetTimeSeconds() / COOLDOWN_TICK_LENGTH)
+		: 0;
+}
@@ -0,0 +1,428 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueCrowdSubsystem.h"
+//UE
+#include "Engine/World.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueSpeakerComponent.h"
+#include "LogDialogueTree.h"
+#include "Nodes/DialogueSpeechNode.h"
+
+void UDialogueCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	AdvanceConversations();
+}
+
+TStatId UDialogueCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(
+		UDialogueCrowdSubsystem,
+		STATGROUP_Tickables
+	);
+}
+
+void UDialogueCrowdSubsystem::AdvanceConversations()
+{
+	//Whichever of the tick or a crowd processor comes first does the work
+	if (LastAdvancedFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastAdvancedFrame = GFrameCounter;
+
+	//Gather everything due this frame before advancing, since starting a
+	//line pushes a new deadline
+	ReadyConversations.Reset();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (!Deadlines.IsEmpty() && Deadlines.HeapTop().Deadline <= Now)
+	{
+		FDialogueCrowdDeadline Deadline;
+		Deadlines.HeapPop(Deadline);
+		ReadyConversations.Add(Deadline);
+	}
+
+	//Advance, skipping conversations which have since ended
+	for (const FDialogueCrowdDeadline& Ready : ReadyConversations)
+	{
+		if (!Conversations.IsValidIndex(Ready.Index)
+			|| Conversations[Ready.Index].Serial != Ready.Serial)
+		{
+			continue;
+		}
+
+		const FDialogueCrowdConversation& Conversation =
+			Conversations[Ready.Index];
+		const FDialogueCrowdScript& Script = Scripts[Conversation.Script];
+		const int32 NextLine = Script.NextLines[Conversation.Line];
+		if (NextLine == INDEX_NONE || IsScriptStale(Script))
+		{
+			EndConversation(Ready.Index);
+			continue;
+		}
+
+		//The previous speaker's line has run its course
+		const int32 OldSlot = Script.SpeakerSlots[Conversation.Line];
+		if (Conversation.BoundSpeakers.IsValidIndex(OldSlot)
+			&& Conversation.BoundSpeakers[OldSlot].IsValid())
+		{
+			Conversation.BoundSpeakers[OldSlot]->ClearGameplayTags();
+
+			//Clearing tags notifies listeners, who may end the conversation
+			if (!Conversations.IsValidIndex(Ready.Index)
+				|| Conversations[Ready.Index].Serial != Ready.Serial)
+			{
+				continue;
+			}
+		}
+
+		StartLine(Ready.Index, NextLine);
+	}
+}
+
+FDialogueCrowdHandle UDialogueCrowdSubsystem::StartConversation(
+	UDialogue* InDialogue, FName InNodeID)
+{
+	if (!InDialogue)
+	{
+		return FDialogueCrowdHandle();
+	}
+
+	const int32 ScriptIndex = FindOrCompileScript(InDialogue);
+	const FDialogueCrowdScript& Script = Scripts[ScriptIndex];
+
+	//Find the line to start at
+	if (InNodeID.IsNone())
+	{
+		const UDialogueNode* RootNode = InDialogue->GetRootNode();
+		const UDialogueNode* FirstNode =
+			RootNode ? RootNode->GetFirstChild() : nullptr;
+		InNodeID = FirstNode ? FirstNode->GetNodeID() : NAME_None;
+	}
+
+	const int32* FirstLine = Script.LineIndices.Find(InNodeID);
+	if (!FirstLine)
+	{
+		UE_LOG(
+			LogDialogueTree,
+			Warning,
+			TEXT("Could not start crowd conversation: the target node is not a speech node.")
+		);
+		return FDialogueCrowdHandle();
+	}
+
+	FDialogueCrowdHandle Handle;
+	Handle.Index = Conversations.Add(FDialogueCrowdConversation());
+	Handle.Serial = NextSerial++;
+
+	FDialogueCrowdConversation& Conversation = Conversations[Handle.Index];
+	Conversation.Script = ScriptIndex;
+	++Scripts[ScriptIndex].NumConversations;
+	Conversation.Serial = Handle.Serial;
+	Conversation.BoundSpeakers.SetNum(
+		InDialogue->GetSpeakerSlotNames().Num()
+	);
+
+	StartLine(Handle.Index, *FirstLine);
+	return Handle;
+}
+
+void UDialogueCrowdSubsystem::StopConversation(FDialogueCrowdHandle InHandle)
+{
+	if (FindConversation(InHandle))
+	{
+		EndConversation(InHandle.Index);
+	}
+}
+
+bool UDialogueCrowdSubsystem::IsConversationActive(
+	FDialogueCrowdHandle InHandle) const
+{
+	return FindConversation(InHandle) != nullptr;
+}
+
+FName UDialogueCrowdSubsystem::GetSpeakingRole(
+	FDialogueCrowdHandle InHandle) const
+{
+	const FDialogueCrowdConversation* Conversation =
+		FindConversation(InHandle);
+	if (!Conversation)
+	{
+		return NAME_None;
+	}
+
+	const FDialogueCrowdScript& Script = Scripts[Conversation->Script];
+	const UDialogue* Dialogue = Script.Dialogue.Get();
+	if (!Dialogue || IsScriptStale(Script))
+	{
+		return NAME_None;
+	}
+
+	return Dialogue->GetSpeakerSlotName(
+		Script.SpeakerSlots[Conversation->Line]
+	);
+}
+
+bool UDialogueCrowdSubsystem::BindSpeaker(FDialogueCrowdHandle InHandle,
+	FName InRole, UDialogueSpeakerComponent* InSpeaker)
+{
+	FDialogueCrowdConversation* Conversation = FindConversation(InHandle);
+	if (!Conversation || !InSpeaker)
+	{
+		return false;
+	}
+
+	const FDialogueCrowdScript& Script = Scripts[Conversation->Script];
+	const UDialogue* Dialogue = Script.Dialogue.Get();
+	const int32 Slot = Dialogue && !IsScriptStale(Script)
+		? Dialogue->GetSpeakerSlot(InRole)
+		: INDEX_NONE;
+	if (!Conversation->BoundSpeakers.IsValidIndex(Slot))
+	{
+		return false;
+	}
+
+	Conversation->BoundSpeakers[Slot] = InSpeaker;
+
+	//Join the line part way through if it is this role's
+	if (Script.SpeakerSlots[Conversation->Line] == Slot)
+	{
+		const double Elapsed =
+			GetWorld()->GetTimeSeconds() - Conversation->LineStartTime;
+		PresentLine(*Conversation, InSpeaker, Elapsed);
+	}
+
+	return true;
+}
+
+void UDialogueCrowdSubsystem::UnbindSpeaker(FDialogueCrowdHandle InHandle,
+	FName InRole)
+{
+	FDialogueCrowdConversation* Conversation = FindConversation(InHandle);
+	if (!Conversation)
+	{
+		return;
+	}
+
+	const UDialogue* Dialogue = Scripts[Conversation->Script].Dialogue.Get();
+	const int32 Slot = Dialogue ? Dialogue->GetSpeakerSlot(InRole) : INDEX_NONE;
+	if (!Conversation->BoundSpeakers.IsValidIndex(Slot))
+	{
+		return;
+	}
+
+	UDialogueSpeakerComponent* Speaker =
+		Conversation->BoundSpeakers[Slot].Get();
+	Conversation->BoundSpeakers[Slot].Reset();
+
+	if (Speaker)
+	{
+		Speaker->StopSpeechAudio();
+		Speaker->ClearGameplayTags();
+	}
+}
+
+int32 UDialogueCrowdSubsystem::FindOrCompileScript(UDialogue* InDialogue)
+{
+	check(InDialogue);
+
+	if (const int32* FoundIndex = ScriptIndices.Find(InDialogue))
+	{
+		if (!IsScriptStale(Scripts[*FoundIndex]))
+		{
+			return *FoundIndex;
+		}
+	}
+
+	//Compiling is rare, so take the chance to clear out old scripts
+	EvictStaleScripts();
+
+	const int32 ScriptIndex = Scripts.Add(FDialogueCrowdScript());
+	ScriptIndices.Add(InDialogue, ScriptIndex);
+
+	FDialogueCrowdScript& Script = Scripts[ScriptIndex];
+	Script.Dialogue = InDialogue;
+	Script.DialogueKey = InDialogue;
+	Script.CompileSerial = InDialogue->GetCompileSerial();
+
+	//Number every speech node
+	for (const TPair<FName, TObjectPtr<UDialogueNode>>& Entry
+		: InDialogue->GetNodes())
+	{
+		UDialogueSpeechNode* SpeechNode =
+			Cast<UDialogueSpeechNode>(Entry.Value);
+		if (!SpeechNode)
+		{
+			continue;
+		}
+
+		Script.LineIndices.Add(Entry.Key, Script.Nodes.Add(SpeechNode));
+		Script.SpeakerSlots.Add(SpeechNode->GetSpeakerSlot());
+		Script.Durations.Add(FMath::Max(
+			SpeechNode->GetMinimumPlayTime(),
+			SpeechNode->GetAudioDuration()
+		));
+	}
+
+	//Then link each line to the one after it. With nobody to choose, the
+	//first child is followed, and anything other than speech ends the
+	//conversation.
+	Script.NextLines.Init(INDEX_NONE, Script.Nodes.Num());
+	for (int32 Line = 0; Line < Script.Nodes.Num(); ++Line)
+	{
+		const UDialogueNode* NextNode = Script.Nodes[Line]->GetFirstChild();
+		const int32* NextLine = NextNode
+			? Script.LineIndices.Find(NextNode->GetNodeID())
+			: nullptr;
+		if (NextLine)
+		{
+			Script.NextLines[Line] = *NextLine;
+		}
+	}
+
+	return ScriptIndex;
+}
+
+bool UDialogueCrowdSubsystem::IsScriptStale(
+	const FDialogueCrowdScript& InScript)
+{
+	const UDialogue* Dialogue = InScript.Dialogue.Get();
+	return !Dialogue || Dialogue->GetCompileSerial() != InScript.CompileSerial;
+}
+
+void UDialogueCrowdSubsystem::EvictScript(int32 InScriptIndex)
+{
+	FDialogueCrowdScript& Script = Scripts[InScriptIndex];
+
+	//A newer script may have taken the dialogue's place
+	const int32* CachedIndex = ScriptIndices.Find(Script.DialogueKey);
+	if (CachedIndex && *CachedIndex == InScriptIndex)
+	{
+		ScriptIndices.Remove(Script.DialogueKey);
+	}
+
+	if (Script.NumConversations == 0)
+	{
+		Scripts.RemoveAt(InScriptIndex);
+	}
+}
+
+void UDialogueCrowdSubsystem::EvictStaleScripts()
+{
+	TArray<int32, TInlineAllocator<8>> StaleScripts;
+	for (auto It = Scripts.CreateConstIterator(); It; ++It)
+	{
+		if (IsScriptStale(*It))
+		{
+			StaleScripts.Add(It.GetIndex());
+		}
+	}
+
+	for (const int32 ScriptIndex : StaleScripts)
+	{
+		EvictScript(ScriptIndex);
+	}
+}
+
+FDialogueCrowdConversation* UDialogueCrowdSubsystem::FindConversation(
+	const FDialogueCrowdHandle& InHandle)
+{
+	if (!Conversations.IsValidIndex(InHandle.Index)
+		|| Conversations[InHandle.Index].Serial != InHandle.Serial)
+	{
+		return nullptr;
+	}
+
+	return &Conversations[InHandle.Index];
+}
+
+const FDialogueCrowdConversation* UDialogueCrowdSubsystem::FindConversation(
+	const FDialogueCrowdHandle& InHandle) const
+{
+	if (!Conversations.IsValidIndex(InHandle.Index)
+		|| Conversations[InHandle.Index].Serial != InHandle.Serial)
+	{
+		return nullptr;
+	}
+
+	return &Conversations[InHandle.Index];
+}
+
+void UDialogueCrowdSubsystem::StartLine(int32 InIndex, int32 InLine)
+{
+	FDialogueCrowdConversation& Conversation = Conversations[InIndex];
+	const FDialogueCrowdScript& Script = Scripts[Conversation.Script];
+
+	Conversation.Line = InLine;
+	Conversation.LineStartTime = GetWorld()->GetTimeSeconds();
+
+	FDialogueCrowdDeadline Deadline;
+	Deadline.Deadline = Conversation.LineStartTime + Script.Durations[InLine];
+	Deadline.Index = InIndex;
+	Deadline.Serial = Conversation.Serial;
+	Deadlines.HeapPush(Deadline);
+
+	//Only promoted agents are heard
+	const int32 Slot = Script.SpeakerSlots[InLine];
+	if (Conversation.BoundSpeakers.IsValidIndex(Slot)
+		&& Conversation.BoundSpeakers[Slot].IsValid())
+	{
+		PresentLine(Conversation, Conversation.BoundSpeakers[Slot].Get(), 0.f);
+	}
+}
+
+void UDialogueCrowdSubsystem::PresentLine(
+	const FDialogueCrowdConversation& InConversation,
+	UDialogueSpeakerComponent* InSpeaker, float InStartTime)
+{
+	check(InSpeaker);
+
+	const FDialogueCrowdScript& Script = Scripts[InConversation.Script];
+	const UDialogueSpeechNode* Node = Script.Nodes[InConversation.Line].Get();
+	if (!Node)
+	{
+		return;
+	}
+
+	const FSpeechDetails& Details = Node->GetDetails();
+	InSpeaker->PlaySpeechFrom(Details, InStartTime);
+
+	OnCrowdSpeechNative.Broadcast(InSpeaker, Details);
+
+	//Dynamic delegates copy their parameters even with nobody bound
+	if (OnCrowdSpeech.IsBound())
+	{
+		OnCrowdSpeech.Broadcast(InSpeaker, Details);
+	}
+}
+
+void UDialogueCrowdSubsystem::EndConversation(int32 InIndex)
+{
+	//Remove first, as clearing tags notifies listeners. Any deadline left
+	//behind is skipped by its serial.
+	const TArray<TWeakObjectPtr<UDialogueSpeakerComponent>,
+		TInlineAllocator<4>> BoundSpeakers =
+		MoveTemp(Conversations[InIndex].BoundSpeakers);
+	const int32 ScriptIndex = Conversations[InIndex].Script;
+	Conversations.RemoveAt(InIndex);
+
+	//The last conversation on an out of date script frees it
+	if (--Scripts[ScriptIndex].NumConversations == 0
+		&& IsScriptStale(Scripts[ScriptIndex]))
+	{
+		EvictScript(ScriptIndex);
+	}
+
+	for (const TWeakObjectPtr<UDialogueSpeakerComponent>& Speaker
+		: BoundSpeakers)
+	{
+		if (Speaker.IsValid())
+		{
+			Speaker->StopSpeechAudio();
+			Speaker->ClearGameplayTags();
+		}
+	}
+}
@@ -0,0 +1,152 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueLODSubsystem.h"
+//UE
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueSettings.h"
+#include "DialogueSpeakerComponent.h"
+
+const float UDialogueLODSubsystem::LOD_HYSTERESIS = 0.1f;
+
+void UDialogueLODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Changing level can end a dialogue, so unregistered entries are only
+	//cleared out here
+	Dialogues.RemoveAllSwap(
+		[](const TWeakObjectPtr<UDialogue>& Dialogue)
+		{
+			return !Dialogue.IsValid();
+		}
+	);
+
+	//With LOD turned off, such as from the settings mid-session, anything
+	//left in less detail goes back to full
+	if (!GetDefault<UDialogueSettings>()->UseConversationLOD)
+	{
+		bHasListener = false;
+		for (int32 Index = 0; Index < Dialogues.Num(); ++Index)
+		{
+			if (UDialogue* Dialogue = Dialogues[Index].Get())
+			{
+				Dialogue->SetLOD(EDialogueLOD::Full);
+			}
+		}
+		return;
+	}
+
+	//Find the listener once for everyone
+	const APlayerController* Player = GetWorld()->GetFirstPlayerController();
+	bHasListener = Player != nullptr;
+	if (Player)
+	{
+		FVector ListenerFront;
+		FVector ListenerRight;
+		Player->GetAudioListenerPosition(
+			ListenerLocation,
+			ListenerFront,
+			ListenerRight
+		);
+	}
+
+	for (int32 Index = 0; Index < Dialogues.Num(); ++Index)
+	{
+		if (UDialogue* Dialogue = Dialogues[Index].Get())
+		{
+			Dialogue->SetLOD(GetDialogueLOD(Dialogue));
+		}
+	}
+}
+
+TStatId UDialogueLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(
+		UDialogueLODSubsystem,
+		STATGROUP_Tickables
+	);
+}
+
+EDialogueLOD UDialogueLODSubsystem::GetLODAt(const FVector& InLocation,
+	EDialogueLOD InCurrentLOD) const
+{
+	const UDialogueSettings* Settings = GetDefault<UDialogueSettings>();
+	if (!Settings->UseConversationLOD || !bHasListener)
+	{
+		return EDialogueLOD::Full;
+	}
+
+	//Stretch the boundaries of levels already reached
+	const float Stretch = 1.f + LOD_HYSTERESIS;
+	const float ReducedDistance = Settings->LODReducedDistance
+		* (InCurrentLOD == EDialogueLOD::Full ? Stretch : 1.f);
+	const float VirtualDistance = Settings->LODVirtualDistance
+		* (InCurrentLOD != EDialogueLOD::Virtual ? Stretch : 1.f);
+
+	const double DistanceSquared =
+		FVector::DistSquared(ListenerLocation, InLocation);
+	if (DistanceSquared > FMath::Square(VirtualDistance))
+	{
+		return EDialogueLOD::Virtual;
+	}
+	if (DistanceSquared > FMath::Square(ReducedDistance))
+	{
+		return EDialogueLOD::Reduced;
+	}
+	return EDialogueLOD::Full;
+}
+
+EDialogueLOD UDialogueLODSubsystem::GetDialogueLOD(
+	const UDialogue* InDialogue) const
+{
+	check(InDialogue);
+
+	//A conversation is as detailed as its nearest speaker needs
+	bool bFoundSpeaker = false;
+	EDialogueLOD BestLOD = EDialogueLOD::Virtual;
+	const int32 NumSlots = InDialogue->GetSpeakerSlotNames().Num();
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		const UDialogueSpeakerComponent* Speaker =
+			InDialogue->GetSpeakerInSlot(Slot);
+		if (!Speaker)
+		{
+			continue;
+		}
+
+		bFoundSpeaker = true;
+		const EDialogueLOD SpeakerLOD = GetLODAt(
+			Speaker->GetComponentLocation(),
+			InDialogue->GetLOD()
+		);
+		if (SpeakerLOD < BestLOD)
+		{
+			BestLOD = SpeakerLOD;
+		}
+	}
+
+	return bFoundSpeaker ? BestLOD : EDialogueLOD::Full;
+}
+
+void UDialogueLODSubsystem::RegisterDialogue(UDialogue* InDialogue)
+{
+	check(InDialogue);
+
+	if (!Dialogues.Contains(InDialogue))
+	{
+		Dialogues.Add(InDialogue);
+	}
+}
+
+void UDialogueLODSubsystem::UnregisterDialogue(UDialogue* InDialogue)
+{
+	const int32 Index = Dialogues.IndexOfByKey(InDialogue);
+	if (Index != INDEX_NONE)
+	{
+		Dialogues[Index].Reset();
+	}
+}
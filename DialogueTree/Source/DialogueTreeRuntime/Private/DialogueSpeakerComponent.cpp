@@ -4,10 +4,14 @@
 #include "DialogueSpeakerComponent.h"
 //UE
 #include "Engine/World.h"
+#include "Sound/SoundBase.h"
 //Plugin
 #include "Dialogue.h"
 #include "DialogueController.h"
 #include "DialogueManagerSubsystem.h"
+#include "DialogueSettings.h"
+#include "DialogueTransitionScheduler.h"
+#include "DialogueVoiceSubsystem.h"
 #include "LogDialogueTree.h"
 
 UDialogueSpeakerComponent::UDialogueSpeakerComponent()
@@ -20,6 +24,12 @@ void UDialogueSpeakerComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	//Let waiting transitions know when speech finishes
+	OnAudioFinishedNative.AddUObject(
+		this, 
+		&UDialogueSpeakerComponent::OnSpeechAudioFinished
+	);
+
 	UDialogueManagerSubsystem* DialogueSubsystem = 
 		GetWorld()->GetSubsystem<UDialogueManagerSubsystem>();
 	check(DialogueSubsystem);
@@ -106,14 +116,94 @@ void UDialogueSpeakerComponent::TrySkipSpeech()
 void UDialogueSpeakerComponent::PlaySpeechAudioClip_Implementation(
 	USoundBase* InAudio)
 {
+	if (GetDefault<UDialogueSettings>()->PoolSpeechAudio)
+	{
+		if (UDialogueVoiceSubsystem* VoiceSubsystem = 
+			GetWorld()->GetSubsystem<UDialogueVoiceSubsystem>())
+		{
+			VoiceSubsystem->PlayVoice(this, InAudio, VoicePriority);
+			return;
+		}
+	}
+
 	SetSound(InAudio);
 	Play();
 }
 
-void UDialogueSpeakerComponent::SetCurrentGameplayTags(FGameplayTagContainer InTags)
+void UDialogueSpeakerComponent::PlaySpeechAudioFrom(USoundBase* InAudio,
+	float InStartTime)
 {
-	GameplayTags.Reset();
-	GameplayTags.AppendTags(InTags);
+	if (InStartTime <= 0.f)
+	{
+		PlaySpeechAudioClip(InAudio);
+		return;
+	}
+
+	if (GetDefault<UDialogueSettings>()->PoolSpeechAudio)
+	{
+		if (UDialogueVoiceSubsystem* VoiceSubsystem =
+			GetWorld()->GetSubsystem<UDialogueVoiceSubsystem>())
+		{
+			VoiceSubsystem->PlayVoice(
+				this,
+				InAudio,
+				VoicePriority,
+				InStartTime
+			);
+			return;
+		}
+	}
+
+	SetSound(InAudio);
+	Play(InStartTime);
+}
+
+void UDialogueSpeakerComponent::PlaySpeechFrom(
+	const FSpeechDetails& InDetails, float InStartTime)
+{
+	StopSpeechAudio();
+
+	//Audio picked up part way through may already be over
+	if (InDetails.SpeechAudio)
+	{
+		const float Duration = InDetails.SpeechAudio->GetDuration();
+		if (Duration >= INDEFINITELY_LOOPING_DURATION
+			|| InStartTime < Duration)
+		{
+			PlaySpeechAudioFrom(InDetails.SpeechAudio, InStartTime);
+		}
+	}
+
+	SetCurrentGameplayTags(InDetails.GameplayTags);
+}
+
+void UDialogueSpeakerComponent::StopSpeechAudio()
+{
+	Stop();
+
+	if (UDialogueVoiceSubsystem* VoiceSubsystem = 
+		GetWorld()->GetSubsystem<UDialogueVoiceSubsystem>())
+	{
+		VoiceSubsystem->StopVoice(this);
+	}
+}
+
+bool UDialogueSpeakerComponent::IsSpeechAudioPlaying() const
+{
+	if (IsPlaying())
+	{
+		return true;
+	}
+
+	const UDialogueVoiceSubsystem* VoiceSubsystem = 
+		GetWorld()->GetSubsystem<UDialogueVoiceSubsystem>();
+	return VoiceSubsystem && VoiceSubsystem->IsVoicePlaying(this);
+}
+
+void UDialogueSpeakerComponent::SetCurrentGameplayTags(
+	const FGameplayTagContainer& InTags)
+{
+	GameplayTags = InTags;
 	BroadcastCurrentGameplayTags();
 }
 
@@ -293,12 +383,39 @@ FSpeakerActorEntry UDialogueSpeakerComponent::ToSpeakerActorEntry()
 }
 
 void UDialogueSpeakerComponent::BroadcastSpeechSkipped(
-	FSpeechDetails SkippedSpeech)
+	const FSpeechDetails& SkippedSpeech)
 {
-	OnSpeechSkipped.Broadcast(SkippedSpeech);
+	OnSpeechSkippedNative.Broadcast(SkippedSpeech);
+
+	//Dynamic delegates copy their parameters even with nobody bound
+	if (OnSpeechSkipped.IsBound())
+	{
+		OnSpeechSkipped.Broadcast(SkippedSpeech);
+	}
+}
+
+void UDialogueSpeakerComponent::NotifyVoiceFinished()
+{
+	OnAudioFinished.Broadcast();
+	OnAudioFinishedNative.Broadcast(this);
 }
 
 void UDialogueSpeakerComponent::BroadcastCurrentGameplayTags()
 {
-	OnGameplayTagsChanged.Broadcast(GameplayTags);
+	OnGameplayTagsChangedNative.Broadcast(GameplayTags);
+
+	if (OnGameplayTagsChanged.IsBound())
+	{
+		OnGameplayTagsChanged.Broadcast(GameplayTags);
+	}
+}
+
+void UDialogueSpeakerComponent::OnSpeechAudioFinished(
+	UAudioComponent* InComponent)
+{
+	if (UDialogueTransitionScheduler* Scheduler = 
+		GetWorld()->GetSubsystem<UDialogueTransitionScheduler>())
+	{
+		Scheduler->QueueAudioFinished(this);
+	}
 }
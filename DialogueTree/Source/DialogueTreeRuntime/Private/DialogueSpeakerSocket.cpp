@@ -8,6 +8,7 @@
 void UDialogueSpeakerSocket::SetSpeakerName(FName InName)
 {
 	SpeakerName = InName;
+	CachedSlot = INDEX_NONE;
 }
 
 FName UDialogueSpeakerSocket::GetSpeakerName() const
@@ -23,7 +24,30 @@ UDialogueSpeakerComponent* UDialogueSpeakerSocket::GetSpeakerComponent(
 		return nullptr;
 	}
 
-	return InDialogue->GetSpeaker(SpeakerName);
+	return InDialogue->GetSpeakerInSlot(ResolveSlot(InDialogue));
+}
+
+const FSpeakerActorEntry& UDialogueSpeakerSocket::GetSpeakerEntry(
+	const UDialogue* InDialogue) const
+{
+	static const FSpeakerActorEntry EmptyEntry;
+	if (!InDialogue || SpeakerName.IsNone())
+	{
+		return EmptyEntry;
+	}
+
+	return InDialogue->GetSpeakerEntryInSlot(ResolveSlot(InDialogue));
+}
+
+int32 UDialogueSpeakerSocket::ResolveSlot(const UDialogue* InDialogue) const
+{
+	//Slots only move on recompile, so an FName compare validates the cache
+	if (InDialogue->GetSpeakerSlotName(CachedSlot) != SpeakerName)
+	{
+		CachedSlot = InDialogue->GetSpeakerSlot(SpeakerName);
+	}
+
+	return CachedSlot;
 }
 
 bool UDialogueSpeakerSocket::IsValidSocket() const
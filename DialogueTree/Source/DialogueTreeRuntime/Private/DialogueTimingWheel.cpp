@@ -0,0 +1,215 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueTimingWheel.h"
+
+const int32 FDialogueTimingWheel::SLOT_BITS = 6;
+const int32 FDialogueTimingWheel::NUM_SLOTS = 1 << SLOT_BITS;
+const int32 FDialogueTimingWheel::NUM_LEVELS = 4;
+
+FDialogueTimingWheel::FDialogueTimingWheel()
+{
+	Reset();
+}
+
+void FDialogueTimingWheel::Schedule(const FDialogueCooldownKey& InKey,
+	uint64 InExpiryTick)
+{
+	//Already over, so there is nothing to track
+	if (InExpiryTick <= CurrentTick)
+	{
+		Cancel(InKey);
+		return;
+	}
+
+	int32 EntryIndex = INDEX_NONE;
+	if (const int32* FoundIndex = Lookup.Find(InKey))
+	{
+		EntryIndex = *FoundIndex;
+		Unlink(EntryIndex);
+	}
+	else
+	{
+		EntryIndex = Entries.Add(FEntry());
+		Entries[EntryIndex].Key = InKey;
+		Lookup.Add(InKey, EntryIndex);
+	}
+
+	Entries[EntryIndex].ExpiryTick = InExpiryTick;
+	Place(EntryIndex);
+}
+
+void FDialogueTimingWheel::Cancel(const FDialogueCooldownKey& InKey)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (Lookup.RemoveAndCopyValue(InKey, EntryIndex))
+	{
+		Unlink(EntryIndex);
+		Entries.RemoveAt(EntryIndex);
+	}
+}
+
+void FDialogueTimingWheel::Advance(uint64 InTick)
+{
+	const uint64 SlotMask = NUM_SLOTS - 1;
+	while (CurrentTick < InTick)
+	{
+		//Nothing left to expire, so skip straight there
+		if (Lookup.IsEmpty())
+		{
+			CurrentTick = InTick;
+			return;
+		}
+
+		//Each turn of the bottom level brings round a slot above it
+		if (((CurrentTick + 1) & SlotMask) == 0)
+		{
+			++CurrentTick;
+			Cascade();
+			ExpireSlot(0);
+			continue;
+		}
+
+		//Otherwise jump to the next occupied slot due this turn, if any
+		const uint64 LastTick = FMath::Min(CurrentTick | SlotMask, InTick);
+		const uint64 DueSlots = OccupiedSlots[0]
+			& (~uint64(0) << ((CurrentTick + 1) & SlotMask))
+			& (~uint64(0) >> (SlotMask - (LastTick & SlotMask)));
+		if (DueSlots == 0)
+		{
+			CurrentTick = LastTick;
+			continue;
+		}
+
+		const int32 Slot = FMath::CountTrailingZeros64(DueSlots);
+		CurrentTick = (CurrentTick & ~SlotMask) | Slot;
+		ExpireSlot(Slot);
+	}
+}
+
+bool FDialogueTimingWheel::IsActive(const FDialogueCooldownKey& InKey,
+	uint64 InTick) const
+{
+	const int32* EntryIndex = Lookup.Find(InKey);
+	return EntryIndex && Entries[*EntryIndex].ExpiryTick > InTick;
+}
+
+void FDialogueTimingWheel::ForEach(
+	TFunctionRef<void(const FDialogueCooldownKey&, uint64)> InVisitor) const
+{
+	for (const FEntry& Entry : Entries)
+	{
+		InVisitor(Entry.Key, Entry.ExpiryTick);
+	}
+}
+
+void FDialogueTimingWheel::Reset()
+{
+	Entries.Empty();
+	Lookup.Empty();
+	SlotHeads.Init(INDEX_NONE, NUM_LEVELS * NUM_SLOTS);
+	OccupiedSlots.Init(0, NUM_LEVELS);
+	CurrentTick = 0;
+}
+
+void FDialogueTimingWheel::Place(int32 InEntryIndex)
+{
+	FEntry& Entry = Entries[InEntryIndex];
+
+	//Anything beyond the top level's reach is filed as far out as it goes,
+	//and refiled from its true expiry when that slot comes round
+	const uint64 MaxDelta = (uint64(1) << (SLOT_BITS * NUM_LEVELS)) - 1;
+	const uint64 Delta = FMath::Min(Entry.ExpiryTick - CurrentTick, MaxDelta);
+	const uint64 FiledTick = CurrentTick + Delta;
+
+	int32 Level = 0;
+	while (Level < NUM_LEVELS - 1 && (Delta >> (SLOT_BITS * (Level + 1))))
+	{
+		++Level;
+	}
+	const int32 Slot = (FiledTick >> (SLOT_BITS * Level)) & (NUM_SLOTS - 1);
+
+	//Push onto the front of the slot
+	Entry.SlotIndex = Level * NUM_SLOTS + Slot;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = SlotHeads[Entry.SlotIndex];
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = InEntryIndex;
+	}
+	SlotHeads[Entry.SlotIndex] = InEntryIndex;
+	OccupiedSlots[Level] |= uint64(1) << Slot;
+}
+
+void FDialogueTimingWheel::Unlink(int32 InEntryIndex)
+{
+	FEntry& Entry = Entries[InEntryIndex];
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SlotHeads[Entry.SlotIndex] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	//Clear the slot's bit once it empties
+	if (SlotHeads[Entry.SlotIndex] == INDEX_NONE)
+	{
+		OccupiedSlots[Entry.SlotIndex / NUM_SLOTS] &=
+			~(uint64(1) << (Entry.SlotIndex % NUM_SLOTS));
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+	Entry.SlotIndex = INDEX_NONE;
+}
+
+void FDialogueTimingWheel::Cascade()
+{
+	for (int32 Level = 1; Level < NUM_LEVELS; ++Level)
+	{
+		const int32 Slot =
+			(CurrentTick >> (SLOT_BITS * Level)) & (NUM_SLOTS - 1);
+
+		//Detach the slot, then file each entry again now it is nearer
+		const int32 SlotIndex = Level * NUM_SLOTS + Slot;
+		int32 EntryIndex = SlotHeads[SlotIndex];
+		SlotHeads[SlotIndex] = INDEX_NONE;
+		OccupiedSlots[Level] &= ~(uint64(1) << Slot);
+
+		while (EntryIndex != INDEX_NONE)
+		{
+			const int32 NextIndex = Entries[EntryIndex].Next;
+			Place(EntryIndex);
+			EntryIndex = NextIndex;
+		}
+
+		//Only carry on up if this level has also come full circle
+		if (Slot != 0)
+		{
+			break;
+		}
+	}
+}
+
+void FDialogueTimingWheel::ExpireSlot(int32 InSlot)
+{
+	int32 EntryIndex = SlotHeads[InSlot];
+	SlotHeads[InSlot] = INDEX_NONE;
+	OccupiedSlots[0] &= ~(uint64(1) << InSlot);
+
+	while (EntryIndex != INDEX_NONE)
+	{
+		const int32 NextIndex = Entries[EntryIndex].Next;
+		Lookup.Remove(Entries[EntryIndex].Key);
+		Entries.RemoveAt(EntryIndex);
+		EntryIndex = NextIndex;
+	}
+}
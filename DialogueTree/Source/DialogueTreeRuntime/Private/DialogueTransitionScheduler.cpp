@@ -0,0 +1,130 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueTransitionScheduler.h"
+//UE
+#include "Engine/World.h"
+//Plugin
+#include "DialogueSpeakerComponent.h"
+#include "Transitions/DialogueTransition.h"
+
+void UDialogueTransitionScheduler::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//Gather everything due this frame before dispatching, since
+	//transitioning out starts new waits
+	ReadyAudio.Reset();
+	ReadyMinPlayTime.Reset();
+
+	for (const TWeakObjectPtr<UDialogueSpeakerComponent>& Speaker
+		: FinishedSpeakers)
+	{
+		//A finish reported late for an earlier speech is ignored
+		if (!Speaker.IsValid() || Speaker->IsSpeechAudioPlaying())
+		{
+			continue;
+		}
+
+		FDialogueTransitionAudioWait Wait;
+		if (AudioWaits.RemoveAndCopyValue(Speaker, Wait))
+		{
+			ReadyAudio.Add(Wait);
+		}
+	}
+	FinishedSpeakers.Reset();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (!Deadlines.IsEmpty() && Deadlines.HeapTop().Deadline <= Now)
+	{
+		FDialogueTransitionDeadline Deadline;
+		Deadlines.HeapPop(Deadline);
+		if (Deadline.bAudio)
+		{
+			ReadyAudio.Add({ Deadline.Transition, Deadline.WaitID });
+		}
+		else
+		{
+			ReadyMinPlayTime.Add({ Deadline.Transition, Deadline.WaitID });
+		}
+	}
+
+	//Dispatch, skipping transitions which have since moved on
+	for (const FDialogueTransitionAudioWait& Ready : ReadyAudio)
+	{
+		UDialogueTransition* Transition = Ready.Transition.Get();
+		if (Transition && Transition->WaitID == Ready.WaitID
+			&& !Transition->bAudioFinished)
+		{
+			Transition->OnDonePlayingContent();
+		}
+	}
+
+	for (const FDialogueTransitionAudioWait& Ready : ReadyMinPlayTime)
+	{
+		UDialogueTransition* Transition = Ready.Transition.Get();
+		if (Transition && Transition->WaitID == Ready.WaitID
+			&& !Transition->bMinPlayTimeElapsed)
+		{
+			Transition->OnMinPlayTimeElapsed();
+		}
+	}
+}
+
+TStatId UDialogueTransitionScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(
+		UDialogueTransitionScheduler,
+		STATGROUP_Tickables
+	);
+}
+
+void UDialogueTransitionScheduler::ScheduleMinPlayTime(
+	UDialogueTransition* InTransition, uint32 InWaitID, float InDelay)
+{
+	PushDeadline(InTransition, InWaitID, InDelay, false);
+}
+
+void UDialogueTransitionScheduler::ScheduleAudioEnd(
+	UDialogueTransition* InTransition, uint32 InWaitID, float InDelay)
+{
+	PushDeadline(InTransition, InWaitID, InDelay, true);
+}
+
+void UDialogueTransitionScheduler::WaitForAudio(
+	UDialogueTransition* InTransition, uint32 InWaitID,
+	UDialogueSpeakerComponent* InSpeaker)
+{
+	check(InTransition && InSpeaker);
+
+	AudioWaits.Add(InSpeaker, { InTransition, InWaitID });
+}
+
+void UDialogueTransitionScheduler::CancelAudioWait(
+	UDialogueSpeakerComponent* InSpeaker)
+{
+	AudioWaits.Remove(InSpeaker);
+}
+
+void UDialogueTransitionScheduler::QueueAudioFinished(
+	UDialogueSpeakerComponent* InSpeaker)
+{
+	if (AudioWaits.Contains(InSpeaker))
+	{
+		FinishedSpeakers.Add(InSpeaker);
+	}
+}
+
+void UDialogueTransitionScheduler::PushDeadline(
+	UDialogueTransition* InTransition, uint32 InWaitID, float InDelay,
+	bool bInAudio)
+{
+	check(InTransition);
+
+	FDialogueTransitionDeadline Deadline;
+	Deadline.Deadline = GetWorld()->GetTimeSeconds() + InDelay;
+	Deadline.Transition = InTransition;
+	Deadline.WaitID = InWaitID;
+	Deadline.bAudio = bInAudio;
+	Deadlines.HeapPush(Deadline);
+}
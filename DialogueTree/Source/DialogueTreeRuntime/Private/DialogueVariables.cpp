@@ -0,0 +1,451 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueVariables.h"
+//Plugin
+#include "Dialogue.h"
+#include "DialogueSpeakerComponent.h"
+#include "DialogueSpeakerSocket.h"
+
+#define LOCTEXT_NAMESPACE "DialogueVariables"
+
+const int32 FDialogueVariableRegistry::NUM_VARIABLE_TYPES = 5;
+
+FDialogueVariableRegistry& FDialogueVariableRegistry::Get()
+{
+	static FDialogueVariableRegistry Registry;
+	return Registry;
+}
+
+int32 FDialogueVariableRegistry::GetSlot(EDialogueVariableType InType,
+	FName InName)
+{
+	if (InName.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	if (SlotsByName.IsEmpty())
+	{
+		SlotsByName.SetNum(NUM_VARIABLE_TYPES);
+		SlotNames.SetNum(NUM_VARIABLE_TYPES);
+	}
+
+	const int32 TypeIndex = static_cast<int32>(InType);
+	if (const int32* FoundSlot = SlotsByName[TypeIndex].Find(InName))
+	{
+		return *FoundSlot;
+	}
+
+	const int32 NewSlot = SlotNames[TypeIndex].Add(InName);
+	SlotsByName[TypeIndex].Add(InName, NewSlot);
+	return NewSlot;
+}
+
+int32 FDialogueVariableRegistry::FindSlot(EDialogueVariableType InType,
+	FName InName) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int32 TypeIndex = static_cast<int32>(InType);
+	if (!SlotsByName.IsValidIndex(TypeIndex))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* FoundSlot = SlotsByName[TypeIndex].Find(InName);
+	return FoundSlot ? *FoundSlot : INDEX_NONE;
+}
+
+FName FDialogueVariableRegistry::GetSlotName(EDialogueVariableType InType,
+	int32 InSlot) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int32 TypeIndex = static_cast<int32>(InType);
+	if (!SlotNames.IsValidIndex(TypeIndex)
+		|| !SlotNames[TypeIndex].IsValidIndex(InSlot))
+	{
+		return NAME_None;
+	}
+
+	return SlotNames[TypeIndex][InSlot];
+}
+
+bool FDialogueVariableBlock::GetBool(int32 InSlot) const
+{
+	return Bools.IsValidIndex(InSlot) && Bools[InSlot];
+}
+
+void FDialogueVariableBlock::SetBool(int32 InSlot, bool InValue)
+{
+	if (InSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (InSlot >= Bools.Num())
+	{
+		Bools.SetNum(InSlot + 1, false);
+	}
+	Bools[InSlot] = InValue;
+}
+
+int32 FDialogueVariableBlock::GetInt(int32 InSlot) const
+{
+	return Ints.IsValidIndex(InSlot) ? Ints[InSlot] : 0;
+}
+
+void FDialogueVariableBlock::SetInt(int32 InSlot, int32 InValue)
+{
+	if (InSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (InSlot >= Ints.Num())
+	{
+		Ints.SetNumZeroed(InSlot + 1);
+	}
+	Ints[InSlot] = InValue;
+}
+
+float FDialogueVariableBlock::GetFloat(int32 InSlot) const
+{
+	return Floats.IsValidIndex(InSlot) ? Floats[InSlot] : 0.f;
+}
+
+void FDialogueVariableBlock::SetFloat(int32 InSlot, float InValue)
+{
+	if (InSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (InSlot >= Floats.Num())
+	{
+		Floats.SetNumZeroed(InSlot + 1);
+	}
+	Floats[InSlot] = InValue;
+}
+
+FName FDialogueVariableBlock::GetName(int32 InSlot) const
+{
+	return Names.IsValidIndex(InSlot) ? Names[InSlot] : NAME_None;
+}
+
+void FDialogueVariableBlock::SetName(int32 InSlot, FName InValue)
+{
+	if (InSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (InSlot >= Names.Num())
+	{
+		Names.SetNum(InSlot + 1);
+	}
+	Names[InSlot] = InValue;
+}
+
+FGameplayTag FDialogueVariableBlock::GetTag(int32 InSlot) const
+{
+	return Tags.IsValidIndex(InSlot) ? Tags[InSlot] : FGameplayTag();
+}
+
+void FDialogueVariableBlock::SetTag(int32 InSlot, FGameplayTag InValue)
+{
+	if (InSlot == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (InSlot >= Tags.Num())
+	{
+		Tags.SetNum(InSlot + 1);
+	}
+	Tags[InSlot] = InValue;
+}
+
+const FDialogueVariableBlock* FDialogueVariableStore::FindBlock(
+	EDialogueVariableScope InScope, FName InOwner) const
+{
+	switch (InScope)
+	{
+	case EDialogueVariableScope::Dialogue:
+		return DialogueBlocks.Find(InOwner);
+	case EDialogueVariableScope::Speaker:
+		return SpeakerBlocks.Find(InOwner);
+	default:
+		return &GlobalBlock;
+	}
+}
+
+FDialogueVariableBlock& FDialogueVariableStore::FindOrAddBlock(
+	EDialogueVariableScope InScope, FName InOwner)
+{
+	switch (InScope)
+	{
+	case EDialogueVariableScope::Dialogue:
+		return DialogueBlocks.FindOrAdd(InOwner);
+	case EDialogueVariableScope::Speaker:
+		return SpeakerBlocks.FindOrAdd(InOwner);
+	default:
+		return GlobalBlock;
+	}
+}
+
+void FDialogueVariableStore::ExportRecords(
+	TArray<FDialogueVariableRecord>& OutRecords) const
+{
+	ExportBlock(
+		GlobalBlock,
+		EDialogueVariableScope::Global,
+		NAME_None,
+		OutRecords
+	);
+
+	for (const TPair<FName, FDialogueVariableBlock>& Entry : DialogueBlocks)
+	{
+		ExportBlock(
+			Entry.Value,
+			EDialogueVariableScope::Dialogue,
+			Entry.Key,
+			OutRecords
+		);
+	}
+
+	for (const TPair<FName, FDialogueVariableBlock>& Entry : SpeakerBlocks)
+	{
+		ExportBlock(
+			Entry.Value,
+			EDialogueVariableScope::Speaker,
+			Entry.Key,
+			OutRecords
+		);
+	}
+}
+
+void FDialogueVariableStore::ImportRecords(
+	const TArray<FDialogueVariableRecord>& InRecords)
+{
+	FDialogueVariableRegistry& Registry = FDialogueVariableRegistry::Get();
+	for (const FDialogueVariableRecord& Record : InRecords)
+	{
+		//Saves from elsewhere may hold types this build does not know
+		const int32 TypeIndex = static_cast<int32>(Record.Type);
+		if (TypeIndex >= FDialogueVariableRegistry::NUM_VARIABLE_TYPES)
+		{
+			continue;
+		}
+
+		const int32 Slot = Registry.GetSlot(Record.Type, Record.Name);
+		FDialogueVariableBlock& Block =
+			FindOrAddBlock(Record.Scope, Record.Owner);
+
+		switch (Record.Type)
+		{
+		case EDialogueVariableType::Bool:
+			Block.SetBool(Slot, Record.BoolValue);
+			break;
+		case EDialogueVariableType::Int:
+			Block.SetInt(Slot, Record.IntValue);
+			break;
+		case EDialogueVariableType::Float:
+			Block.SetFloat(Slot, Record.FloatValue);
+			break;
+		case EDialogueVariableType::Name:
+			Block.SetName(Slot, Record.NameValue);
+			break;
+		case EDialogueVariableType::Tag:
+			Block.SetTag(Slot, Record.TagValue);
+			break;
+		}
+	}
+}
+
+void FDialogueVariableStore::Reset()
+{
+	GlobalBlock = FDialogueVariableBlock();
+	DialogueBlocks.Empty();
+	SpeakerBlocks.Empty();
+}
+
+void FDialogueVariableStore::ExportBlock(
+	const FDialogueVariableBlock& InBlock, EDialogueVariableScope InScope,
+	FName InOwner, TArray<FDialogueVariableRecord>& OutRecords)
+{
+	const FDialogueVariableRegistry& Registry =
+		FDialogueVariableRegistry::Get();
+
+	//Defaults read the same as unset, so only the rest need writing
+	auto AddRecord = [&](EDialogueVariableType InType, int32 InSlot)
+		-> FDialogueVariableRecord&
+	{
+		FDialogueVariableRecord& Record = OutRecords.AddDefaulted_GetRef();
+		Record.Scope = InScope;
+		Record.Owner = InOwner;
+		Record.Name = Registry.GetSlotName(InType, InSlot);
+		Record.Type = InType;
+		return Record;
+	};
+
+	for (TConstSetBitIterator<> It(InBlock.Bools); It; ++It)
+	{
+		AddRecord(EDialogueVariableType::Bool, It.GetIndex()).BoolValue = true;
+	}
+
+	for (int32 Slot = 0; Slot < InBlock.Ints.Num(); ++Slot)
+	{
+		if (InBlock.Ints[Slot] != 0)
+		{
+			AddRecord(EDialogueVariableType::Int, Slot).IntValue =
+				InBlock.Ints[Slot];
+		}
+	}
+
+	for (int32 Slot = 0; Slot < InBlock.Floats.Num(); ++Slot)
+	{
+		if (InBlock.Floats[Slot] != 0.f)
+		{
+			AddRecord(EDialogueVariableType::Float, Slot).FloatValue =
+				InBlock.Floats[Slot];
+		}
+	}
+
+	for (int32 Slot = 0; Slot < InBlock.Names.Num(); ++Slot)
+	{
+		if (!InBlock.Names[Slot].IsNone())
+		{
+			AddRecord(EDialogueVariableType::Name, Slot).NameValue =
+				InBlock.Names[Slot];
+		}
+	}
+
+	for (int32 Slot = 0; Slot < InBlock.Tags.Num(); ++Slot)
+	{
+		if (InBlock.Tags[Slot].IsValid())
+		{
+			AddRecord(EDialogueVariableType::Tag, Slot).TagValue =
+				InBlock.Tags[Slot];
+		}
+	}
+}
+
+void FDialogueVariable::Resolve(EDialogueVariableType InType)
+{
+	Slot = FDialogueVariableRegistry::Get().GetSlot(InType, Name);
+}
+
+int32 FDialogueVariable::GetSlot(EDialogueVariableType InType)
+{
+	if (Slot == INDEX_NONE)
+	{
+		Resolve(InType);
+	}
+
+	return Slot;
+}
+
+const FDialogueVariableBlock* FDialogueVariable::FindBlock(
+	UDialogue* InDialogue) const
+{
+	const FDialogueVariableStore* Store =
+		InDialogue ? InDialogue->GetVariables() : nullptr;
+	FName Owner;
+	if (!Store || !GetOwner(InDialogue, Owner))
+	{
+		return nullptr;
+	}
+
+	return Store->FindBlock(Scope, Owner);
+}
+
+FDialogueVariableBlock* FDialogueVariable::FindOrAddBlock(
+	UDialogue* InDialogue) const
+{
+	FDialogueVariableStore* Store =
+		InDialogue ? InDialogue->GetVariables() : nullptr;
+	FName Owner;
+	if (!Store || !GetOwner(InDialogue, Owner))
+	{
+		return nullptr;
+	}
+
+	return &Store->FindOrAddBlock(Scope, Owner);
+}
+
+bool FDialogueVariable::IsValidVariable() const
+{
+	if (Name.IsNone())
+	{
+		return false;
+	}
+
+	if (Scope == EDialogueVariableScope::Speaker)
+	{
+		return Speaker && Speaker->IsValidSocket();
+	}
+
+	return true;
+}
+
+FText FDialogueVariable::GetDisplayText() const
+{
+	FText NameText = FText::FromName(Name);
+
+	switch (Scope)
+	{
+	case EDialogueVariableScope::Dialogue:
+		return FText::Format(
+			LOCTEXT("DialogueScopeText", "dialogue {0}"),
+			NameText
+		);
+	case EDialogueVariableScope::Speaker:
+	{
+		FText SpeakerText = Speaker
+			? FText::FromName(Speaker->GetSpeakerName())
+			: LOCTEXT("InvalidSpeaker", "Invalid Speaker");
+		return FText::Format(
+			LOCTEXT("SpeakerScopeText", "{0}'s {1}"),
+			SpeakerText,
+			NameText
+		);
+	}
+	default:
+		return NameText;
+	}
+}
+
+bool FDialogueVariable::GetOwner(UDialogue* InDialogue,
+	FName& OutOwner) const
+{
+	check(InDialogue);
+
+	switch (Scope)
+	{
+	case EDialogueVariableScope::Dialogue:
+		OutOwner = InDialogue->GetFName();
+		return true;
+	case EDialogueVariableScope::Speaker:
+	{
+		const UDialogueSpeakerComponent* SpeakerComponent = Speaker
+			? Speaker->GetSpeakerComponent(InDialogue)
+			: nullptr;
+		if (!SpeakerComponent)
+		{
+			return false;
+		}
+
+		OutOwner = SpeakerComponent->GetDialogueName();
+		return true;
+	}
+	default:
+		OutOwner = NAME_None;
+		return true;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,234 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueVoiceSubsystem.h"
+//UE
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Sound/SoundBase.h"
+//Plugin
+#include "DialogueSettings.h"
+#include "DialogueSpeakerComponent.h"
+
+void UDialogueVoiceSubsystem::Deinitialize()
+{
+	for (FDialogueVoiceChannel& Channel : Channels)
+	{
+		if (Channel.AudioComponent)
+		{
+			Channel.AudioComponent->OnAudioFinishedNative.RemoveAll(this);
+			Channel.AudioComponent->DestroyComponent();
+		}
+	}
+	Channels.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UDialogueVoiceSubsystem::PlayVoice(UDialogueSpeakerComponent* InSpeaker,
+	USoundBase* InSound, int32 InPriority, float InStartTime)
+{
+	check(InSpeaker);
+
+	//A speaker only ever holds one channel
+	StopVoice(InSpeaker);
+
+	if (!InSound)
+	{
+		return false;
+	}
+
+	const UDialogueSettings* Settings = GetDefault<UDialogueSettings>();
+	if (IsBeyondCullDistance(InSpeaker, Settings->VoiceCullDistance))
+	{
+		return false;
+	}
+
+	UDialogueSpeakerComponent* StolenFrom = nullptr;
+	const int32 ChannelIndex = AcquireChannel(
+		InPriority, 
+		Settings->MaxVoiceChannels, 
+		StolenFrom
+	);
+	if (ChannelIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FDialogueVoiceChannel& Channel = Channels[ChannelIndex];
+	Channel.Speaker = InSpeaker;
+	Channel.Priority = InPriority;
+	Channel.StartTime = GetWorld()->GetTimeSeconds();
+
+	//Play from the speaker, as the speaker would have
+	UAudioComponent* AudioComponent = Channel.AudioComponent;
+	AudioComponent->AttachToComponent(
+		InSpeaker,
+		FAttachmentTransformRules::SnapToTargetNotIncludingScale
+	);
+	AudioComponent->AttenuationSettings = InSpeaker->AttenuationSettings;
+	AudioComponent->bOverrideAttenuation = InSpeaker->bOverrideAttenuation;
+	AudioComponent->AttenuationOverrides = InSpeaker->AttenuationOverrides;
+	AudioComponent->ConcurrencySet = InSpeaker->ConcurrencySet;
+	AudioComponent->SoundClassOverride = InSpeaker->SoundClassOverride;
+	AudioComponent->VolumeMultiplier = InSpeaker->VolumeMultiplier;
+	AudioComponent->PitchMultiplier = InSpeaker->PitchMultiplier;
+	AudioComponent->SetSound(InSound);
+	AudioComponent->Play(InStartTime);
+
+	//Only now that the channel is set up can the old speaker react
+	if (StolenFrom)
+	{
+		StolenFrom->NotifyVoiceFinished();
+	}
+
+	return true;
+}
+
+void UDialogueVoiceSubsystem::StopVoice(UDialogueSpeakerComponent* InSpeaker)
+{
+	const int32 ChannelIndex = FindChannel(InSpeaker);
+	if (ChannelIndex != INDEX_NONE)
+	{
+		//The speaker asked for this, so it is not told the speech finished
+		Channels[ChannelIndex].AudioComponent->Stop();
+		ReleaseChannel(ChannelIndex);
+	}
+}
+
+bool UDialogueVoiceSubsystem::IsVoicePlaying(
+	const UDialogueSpeakerComponent* InSpeaker) const
+{
+	return FindChannel(InSpeaker) != INDEX_NONE;
+}
+
+bool UDialogueVoiceSubsystem::IsBeyondCullDistance(
+	const UDialogueSpeakerComponent* InSpeaker, float InCullDistance) const
+{
+	if (InCullDistance <= 0.f)
+	{
+		return false;
+	}
+
+	const APlayerController* Player = GetWorld()->GetFirstPlayerController();
+	if (!Player)
+	{
+		return false;
+	}
+
+	FVector ListenerLocation;
+	FVector ListenerFront;
+	FVector ListenerRight;
+	Player->GetAudioListenerPosition(
+		ListenerLocation,
+		ListenerFront,
+		ListenerRight
+	);
+
+	return FVector::DistSquared(
+		ListenerLocation,
+		InSpeaker->GetComponentLocation()
+	) > FMath::Square(InCullDistance);
+}
+
+int32 UDialogueVoiceSubsystem::AcquireChannel(int32 InPriority,
+	int32 InMaxChannels, UDialogueSpeakerComponent*& OutStolenFrom)
+{
+	//Reuse a free channel
+	int32 StealIndex = INDEX_NONE;
+	for (int32 ChannelIndex = 0; ChannelIndex < Channels.Num(); ++ChannelIndex)
+	{
+		const FDialogueVoiceChannel& Channel = Channels[ChannelIndex];
+		if (!Channel.Speaker.IsValid())
+		{
+			return ChannelIndex;
+		}
+
+		//Track the least important, oldest speech in case none are free
+		if (StealIndex == INDEX_NONE
+			|| Channel.Priority < Channels[StealIndex].Priority
+			|| (Channel.Priority == Channels[StealIndex].Priority
+				&& Channel.StartTime < Channels[StealIndex].StartTime))
+		{
+			StealIndex = ChannelIndex;
+		}
+	}
+
+	//Grow the pool up to the limit
+	if (Channels.Num() < FMath::Max(InMaxChannels, 1))
+	{
+		UAudioComponent* AudioComponent =
+			NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+		AudioComponent->bAutoActivate = false;
+		AudioComponent->bAutoDestroy = false;
+		AudioComponent->RegisterComponentWithWorld(GetWorld());
+		AudioComponent->OnAudioFinishedNative.AddUObject(
+			this,
+			&UDialogueVoiceSubsystem::OnChannelFinished
+		);
+
+		FDialogueVoiceChannel& NewChannel = Channels.AddDefaulted_GetRef();
+		NewChannel.AudioComponent = AudioComponent;
+		return Channels.Num() - 1;
+	}
+
+	//Steal from a less important speech
+	if (StealIndex != INDEX_NONE && Channels[StealIndex].Priority < InPriority)
+	{
+		Channels[StealIndex].AudioComponent->Stop();
+		OutStolenFrom = ReleaseChannel(StealIndex);
+		return StealIndex;
+	}
+
+	return INDEX_NONE;
+}
+
+int32 UDialogueVoiceSubsystem::FindChannel(
+	const UDialogueSpeakerComponent* InSpeaker) const
+{
+	return Channels.IndexOfByPredicate(
+		[InSpeaker](const FDialogueVoiceChannel& Channel)
+		{
+			return Channel.Speaker.Get() == InSpeaker;
+		}
+	);
+}
+
+UDialogueSpeakerComponent* UDialogueVoiceSubsystem::ReleaseChannel(
+	int32 InChannelIndex)
+{
+	FDialogueVoiceChannel& Channel = Channels[InChannelIndex];
+	UDialogueSpeakerComponent* Speaker = Channel.Speaker.Get();
+	Channel.Speaker.Reset();
+	Channel.Priority = 0;
+
+	return Speaker;
+}
+
+void UDialogueVoiceSubsystem::OnChannelFinished(
+	UAudioComponent* InAudioComponent)
+{
+	//A stopped speech may report in after its channel has been reused
+	if (InAudioComponent->IsPlaying())
+	{
+		return;
+	}
+
+	const int32 ChannelIndex = Channels.IndexOfByPredicate(
+		[InAudioComponent](const FDialogueVoiceChannel& Channel)
+		{
+			return Channel.AudioComponent == InAudioComponent;
+		}
+	);
+
+	if (ChannelIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UDialogueSpeakerComponent* Speaker = ReleaseChannel(ChannelIndex))
+	{
+		Speaker->NotifyVoiceFinished();
+	}
+}
@@ -14,11 +14,12 @@ void UDialogueEvent::PlayEvent()
 {
 	check(Dialogue && Speaker);
 
-	bBlocking = false;
-	UDialogueSpeakerComponent* SpeakerComponent =
-		Speaker->GetSpeakerComponent(Dialogue);
+	//Release any block left over from a previous play
+	StopBlocking();
+	const FSpeakerActorEntry& TargetSpeaker = 
+		Speaker->GetSpeakerEntry(Dialogue);
 
-	if (!SpeakerComponent)
+	if (!TargetSpeaker.SpeakerComponent)
 	{
 		UE_LOG(
 			LogDialogueTree, 
@@ -28,15 +29,13 @@ void UDialogueEvent::PlayEvent()
 		return;
 	}
 
-	
-	FSpeakerActorEntry TargetSpeaker = SpeakerComponent->ToSpeakerActorEntry();
-	
 	TArray<FSpeakerActorEntry> OtherSpeakers;
+	OtherSpeakers.Reserve(AdditionalSpeakers.Num());
 	for (UDialogueSpeakerSocket* Socket : AdditionalSpeakers)
 	{
-		UDialogueSpeakerComponent* SocketComponent = 
-			Socket->GetSpeakerComponent(Dialogue);
-		if (!SocketComponent)
+		const FSpeakerActorEntry& SocketEntry = 
+			Socket->GetSpeakerEntry(Dialogue);
+		if (!SocketEntry.SpeakerComponent)
 		{
 			UE_LOG(
 				LogDialogueTree,
@@ -46,8 +45,6 @@ void UDialogueEvent::PlayEvent()
 			return;
 		}
 
-		FSpeakerActorEntry SocketEntry = 
-			SocketComponent->ToSpeakerActorEntry();
 		OtherSpeakers.Add(SocketEntry);
 	}
 
@@ -2,6 +2,37 @@
 
 
 #include "Events/DialogueEventBase.h"
+//UE
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+void FDialogueEventHandle::Complete() const
+{
+	if (IsInGameThread())
+	{
+		if (UDialogueEventBase* TargetEvent = Event.Get())
+		{
+			TargetEvent->FinishAsync(RunID);
+		}
+		return;
+	}
+
+	//Completion always lands on the game thread
+	AsyncTask(ENamedThreads::GameThread,
+		[TargetEvent = Event, TargetRunID = RunID]()
+		{
+			if (UDialogueEventBase* PinnedEvent = TargetEvent.Get())
+			{
+				PinnedEvent->FinishAsync(TargetRunID);
+			}
+		}
+	);
+}
+
+bool FDialogueEventHandle::IsValid() const
+{
+	return !Event.IsExplicitlyNull();
+}
 
 bool UDialogueEventBase::HasAllRequirements() const
 {
@@ -18,21 +49,58 @@ bool UDialogueEventBase::GetIsBlocking() const
 	return bBlocking;
 }
 
+bool UDialogueEventBase::GetIsCosmetic() const
+{
+	return bCosmetic;
+}
+
 void UDialogueEventBase::StartBlocking()
 {
-	bBlocking = true;
+	BeginAsync();
 }
 
 void UDialogueEventBase::StopBlocking()
 {
-	//Set us to no longer block
+	if (!bBlocking)
+	{
+		return;
+	}
+
+	//Set us to no longer block and retire any handles to this run
 	bBlocking = false;
+	++CurrentRunID;
 
 	//Broadcast to all interested parties that we are not blocking
 	OnStoppedBlocking.ExecuteIfBound();
+}
+
+FDialogueEventHandle UDialogueEventBase::BeginAsync()
+{
+	check(IsInGameThread());
+
+	bBlocking = true;
+	return FDialogueEventHandle(this, CurrentRunID);
+}
 
-	//Clear the list of interested parties
-	OnStoppedBlocking.Unbind();
+void UDialogueEventBase::RunAsync(TUniqueFunction<void()>&& InWork)
+{
+	const FDialogueEventHandle Handle = BeginAsync();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Work = MoveTemp(InWork), Handle]()
+		{
+			Work();
+			Handle.Complete();
+		}
+	);
+}
+
+void UDialogueEventBase::FinishAsync(uint32 InRunID)
+{
+	if (InRunID == CurrentRunID)
+	{
+		StopBlocking();
+	}
 }
 
 void UDialogueEventBase::PlayEvent()
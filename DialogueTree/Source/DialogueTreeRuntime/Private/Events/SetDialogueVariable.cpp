@@ -0,0 +1,115 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Events/SetDialogueVariable.h"
+//Plugin
+#include "Dialogue.h"
+
+#define LOCTEXT_NAMESPACE "USetDialogueVariable"
+
+void USetDialogueVariable::PostLoad()
+{
+	Super::PostLoad();
+
+	Variable.Resolve(Type);
+}
+
+#if WITH_EDITOR
+void USetDialogueVariable::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Variable.Resolve(Type);
+}
+#endif
+
+void USetDialogueVariable::PlayEvent()
+{
+	const int32 Slot = Variable.GetSlot(Type);
+	FDialogueVariableBlock* Block = Variable.FindOrAddBlock(Dialogue);
+	if (!Block)
+	{
+		return;
+	}
+
+	switch (Type)
+	{
+	case EDialogueVariableType::Bool:
+		Block->SetBool(Slot, BoolValue);
+		break;
+	case EDialogueVariableType::Int:
+		Block->SetInt(
+			Slot,
+			AddToCurrent ? Block->GetInt(Slot) + IntValue : IntValue
+		);
+		break;
+	case EDialogueVariableType::Float:
+		Block->SetFloat(
+			Slot,
+			AddToCurrent ? Block->GetFloat(Slot) + FloatValue : FloatValue
+		);
+		break;
+	case EDialogueVariableType::Name:
+		Block->SetName(Slot, NameValue);
+		break;
+	case EDialogueVariableType::Tag:
+		Block->SetTag(Slot, TagValue);
+		break;
+	}
+}
+
+bool USetDialogueVariable::HasAllRequirements() const
+{
+	return Variable.IsValidVariable();
+}
+
+FText USetDialogueVariable::GetGraphDescription_Implementation() const
+{
+	if (!Variable.IsValidVariable())
+	{
+		return LOCTEXT("DefaultText", "Invalid Event");
+	}
+
+	FText ValueText;
+	switch (Type)
+	{
+	case EDialogueVariableType::Bool:
+		ValueText = BoolValue
+			? LOCTEXT("TrueText", "true")
+			: LOCTEXT("FalseText", "false");
+		break;
+	case EDialogueVariableType::Int:
+		ValueText = FText::AsNumber(IntValue);
+		break;
+	case EDialogueVariableType::Float:
+		ValueText = FText::AsNumber(FloatValue);
+		break;
+	case EDialogueVariableType::Name:
+		ValueText = FText::FromName(NameValue);
+		break;
+	case EDialogueVariableType::Tag:
+		ValueText = FText::FromName(TagValue.GetTagName());
+		break;
+	}
+
+	const bool bAdding = AddToCurrent
+		&& (Type == EDialogueVariableType::Int
+			|| Type == EDialogueVariableType::Float);
+	if (bAdding)
+	{
+		return FText::Format(
+			LOCTEXT("AddText", "Add {0} to {1}"),
+			ValueText,
+			Variable.GetDisplayText()
+		);
+	}
+
+	return FText::Format(
+		LOCTEXT("SetText", "Set {0} to {1}"),
+		Variable.GetDisplayText(),
+		ValueText
+	);
+}
+
+#undef LOCTEXT_NAMESPACE
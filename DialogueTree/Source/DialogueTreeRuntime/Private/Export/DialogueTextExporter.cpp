@@ -0,0 +1,200 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Export/DialogueTextExporter.h"
+//UE
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+//Plugin
+#include "Conditionals/DialogueCondition.h"
+#include "Conditionals/Queries/Base/DialogueQuery.h"
+#include "Dialogue.h"
+#include "Nodes/DialogueNode.h"
+
+const FString FDialogueTextExporter::FILE_EXTENSION = TEXT(".dialogue.txt");
+
+void FDialogueExportNode::AddField(const FString& InName,
+	const FString& InValue)
+{
+	Fields.Emplace(InName, InValue);
+}
+
+void FDialogueExportNode::AddText(const FString& InName, const FText& InText)
+{
+	AddField(InName, InText.ToString());
+
+	const TOptional<FString> TextKey = FTextInspector::GetKey(InText);
+	if (TextKey.IsSet())
+	{
+		AddField(InName + TEXT("Key"), TextKey.GetValue());
+	}
+}
+
+void FDialogueExportNode::AddCondition(UDialogueCondition* InCondition)
+{
+	if (!InCondition)
+	{
+		return;
+	}
+
+	//Queries may be Blueprint, so descriptions are read here, not formatted
+	UDialogueQuery* Query = InCondition->GetQuery();
+	const FText QueryText = Query
+		? Query->GetGraphDescription()
+		: FText::GetEmpty();
+
+	AddField(
+		TEXT("Condition"),
+		InCondition->GetGraphDescription(QueryText).ToString()
+	);
+}
+
+void FDialogueTextExporter::GatherExportData(const UDialogue* InDialogue,
+	FDialogueExportData& OutData)
+{
+	check(IsInGameThread());
+	check(InDialogue);
+
+	OutData.PackageName = InDialogue->GetOutermost()->GetName();
+	OutData.CompileStatus = StaticEnum<EDialogueCompileStatus>()
+		->GetNameStringByValue(
+			static_cast<int64>(InDialogue->GetCompileStatus())
+		);
+
+	const UDialogueNode* RootNode = InDialogue->GetRootNode();
+	OutData.RootNodeID = RootNode ? RootNode->GetNodeID() : NAME_None;
+
+	//Speakers, from the asset's roles since no speakers are bound offline
+	InDialogue->GetSpeakerRoles().GenerateKeyArray(OutData.Speakers);
+	OutData.Speakers.Sort(
+		[](const FName& A, const FName& B)
+		{
+			return A.ToString().Compare(B.ToString(),
+				ESearchCase::CaseSensitive) < 0;
+		}
+	);
+
+	//Nodes, sorted by ID so map order does not leak into the export
+	const TMap<FName, TObjectPtr<UDialogueNode>>& Nodes =
+		InDialogue->GetNodes();
+	OutData.Nodes.Reset(Nodes.Num());
+	for (const TPair<FName, TObjectPtr<UDialogueNode>>& Entry : Nodes)
+	{
+		if (Entry.Value)
+		{
+			Entry.Value->GetExportData(OutData.Nodes.AddDefaulted_GetRef());
+		}
+	}
+
+	OutData.Nodes.Sort(
+		[](const FDialogueExportNode& A, const FDialogueExportNode& B)
+		{
+			return A.NodeID.ToString().Compare(B.NodeID.ToString(),
+				ESearchCase::CaseSensitive) < 0;
+		}
+	);
+}
+
+FString FDialogueTextExporter::FormatExportData(
+	const FDialogueExportData& InData)
+{
+	TStringBuilder<4096> Builder;
+
+	//Header
+	Builder << TEXT("Dialogue: ") << EscapeValue(InData.PackageName)
+		<< TEXT("\n");
+	Builder << TEXT("Status: ") << InData.CompileStatus << TEXT("\n");
+	Builder << TEXT("Root: ") << InData.RootNodeID.ToString() << TEXT("\n");
+	for (const FName& Speaker : InData.Speakers)
+	{
+		Builder << TEXT("Speaker: ") << EscapeValue(Speaker.ToString())
+			<< TEXT("\n");
+	}
+
+	//Nodes
+	for (const FDialogueExportNode& Node : InData.Nodes)
+	{
+		Builder << TEXT("\n[") << Node.NodeID.ToString() << TEXT("]\n");
+		Builder << TEXT("Type: ") << Node.NodeType << TEXT("\n");
+
+		for (const FDialogueExportField& Field : Node.Fields)
+		{
+			Builder << Field.Name << TEXT(": ") << EscapeValue(Field.Value)
+				<< TEXT("\n");
+		}
+
+		for (const FName& Child : Node.Children)
+		{
+			Builder << TEXT("Child: ") << Child.ToString() << TEXT("\n");
+		}
+	}
+
+	return FString(Builder.ToView());
+}
+
+FString FDialogueTextExporter::GetExportFilePath(
+	const FString& InPackageName, const FString& InOutputDir)
+{
+	FString RelativePath = InPackageName;
+	RelativePath.RemoveFromStart(TEXT("/"));
+
+	return FPaths::Combine(InOutputDir, RelativePath) + FILE_EXTENSION;
+}
+
+int32 FDialogueTextExporter::ExportDialogues(
+	const TArray<UDialogue*>& InDialogues, const FString& InOutputDir)
+{
+	//Snapshot on the game thread
+	TArray<FDialogueExportData> Snapshots;
+	Snapshots.Reserve(InDialogues.Num());
+	for (const UDialogue* Dialogue : InDialogues)
+	{
+		if (Dialogue)
+		{
+			GatherExportData(Dialogue, Snapshots.AddDefaulted_GetRef());
+		}
+	}
+
+	//Format, compare and write in parallel
+	FThreadSafeCounter FilesWritten;
+	ParallelFor(Snapshots.Num(),
+		[&Snapshots, &InOutputDir, &FilesWritten](int32 Index)
+		{
+			const FDialogueExportData& Snapshot = Snapshots[Index];
+			const FString FilePath =
+				GetExportFilePath(Snapshot.PackageName, InOutputDir);
+			const FString ExportText = FormatExportData(Snapshot);
+
+			//Leave unchanged files alone to keep timestamps and diffs clean
+			FString ExistingText;
+			if (FFileHelper::LoadFileToString(ExistingText, *FilePath)
+				&& ExistingText.Equals(ExportText, ESearchCase::CaseSensitive))
+			{
+				return;
+			}
+
+			if (FFileHelper::SaveStringToFile(
+				ExportText,
+				*FilePath,
+				FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM
+			))
+			{
+				FilesWritten.Increment();
+			}
+		}
+	);
+
+	return FilesWritten.GetValue();
+}
+
+FString FDialogueTextExporter::EscapeValue(const FString& InValue)
+{
+	FString Escaped = InValue.Replace(TEXT("\\"), TEXT("\\\\"));
+	Escaped.ReplaceInline(TEXT("\r"), TEXT("\\r"));
+	Escaped.ReplaceInline(TEXT("\n"), TEXT("\\n"));
+	Escaped.ReplaceInline(TEXT("\t"), TEXT("\\t"));
+	return Escaped;
+}
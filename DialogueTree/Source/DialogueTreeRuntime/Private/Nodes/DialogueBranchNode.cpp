@@ -5,6 +5,7 @@
 //Plugin
 #include "Conditionals/DialogueCondition.h"
 #include "Dialogue.h"
+#include "Export/DialogueTextExporter.h"
 
 FDialogueOption UDialogueBranchNode::GetAsOption()
 {
@@ -48,6 +49,26 @@ void UDialogueBranchNode::EnterNode()
     GetDialogue()->TraverseNode(NextNode);
 }
 
+void UDialogueBranchNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+    Super::GetExportData(OutNode);
+
+    OutNode.AddField(TEXT("IfAny"), LexToString(bIfAny));
+    for (UDialogueCondition* Condition : Conditions)
+    {
+        OutNode.AddCondition(Condition);
+    }
+
+    if (TrueNode)
+    {
+        OutNode.AddField(TEXT("True"), TrueNode->GetNodeID().ToString());
+    }
+    if (FalseNode)
+    {
+        OutNode.AddField(TEXT("False"), FalseNode->GetNodeID().ToString());
+    }
+}
+
 void UDialogueBranchNode::InitBranchData(bool InIfAny, 
     UDialogueNode* InTrueNode, UDialogueNode* InFalseNode, 
     TArray<UDialogueCondition*>& InConditions)
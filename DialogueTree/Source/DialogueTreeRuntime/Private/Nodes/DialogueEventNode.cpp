@@ -5,6 +5,7 @@
 //Plugin
 #include "Dialogue.h"
 #include "Events/DialogueEventBase.h"
+#include "Export/DialogueTextExporter.h"
 
 void UDialogueEventNode::EnterNode()
 {
@@ -34,37 +35,128 @@ void UDialogueEventNode::Skip()
 	}
 }
 
+void UDialogueEventNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+	Super::GetExportData(OutNode);
+
+	for (const UDialogueEventBase* Event : Events)
+	{
+		if (Event)
+		{
+			OutNode.AddField(TEXT("Event"), Event->GetClass()->GetName());
+		}
+	}
+
+	//Dependencies as "waited on -> dependent" event indices
+	for (int32 EventIndex = 0; EventIndex < EventDependentOffsets.Num() - 1;
+		++EventIndex)
+	{
+		for (int32 Edge = EventDependentOffsets[EventIndex];
+			Edge < EventDependentOffsets[EventIndex + 1]; ++Edge)
+		{
+			OutNode.AddField(
+				TEXT("EventDependency"),
+				FString::Printf(
+					TEXT("%d -> %d"), 
+					EventIndex, 
+					EventDependents[Edge]
+				)
+			);
+		}
+	}
+}
+
 void UDialogueEventNode::SetEvents(TArray<UDialogueEventBase*>& InEvents)
 {
 	Events = InEvents;
+
+	EventDependencyCounts.Empty();
+	EventDependentOffsets.Empty();
+	EventDependents.Empty();
 }
 
-bool UDialogueEventNode::GetIsBlocking() const
+void UDialogueEventNode::SetEventDependencies(
+	const TArray<TArray<int32>>& InDependencies)
 {
-	for (UDialogueEventBase* Event : Events)
+	check(InDependencies.Num() == Events.Num());
+
+	EventDependencyCounts.Init(0, Events.Num());
+	EventDependentOffsets.Init(0, Events.Num() + 1);
+	EventDependents.Empty();
+
+	//Count each event's dependents to lay out the flattened list
+	bool bHasDependencies = false;
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+	{
+		for (int32 Dependency : InDependencies[EventIndex])
+		{
+			check(Events.IsValidIndex(Dependency));
+			++EventDependentOffsets[Dependency + 1];
+			++EventDependencyCounts[EventIndex];
+			bHasDependencies = true;
+		}
+	}
+
+	//Nodes whose events all start together need no schedule
+	if (!bHasDependencies)
 	{
-		if (Event->GetIsBlocking())
+		EventDependencyCounts.Empty();
+		EventDependentOffsets.Empty();
+		return;
+	}
+
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+	{
+		EventDependentOffsets[EventIndex + 1] += 
+			EventDependentOffsets[EventIndex];
+	}
+
+	//Fill in the dependents of each event
+	EventDependents.SetNumUninitialized(EventDependentOffsets.Last());
+	TArray<int32> NextSlot = EventDependentOffsets;
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+	{
+		for (int32 Dependency : InDependencies[EventIndex])
 		{
-			return true;
+			EventDependents[NextSlot[Dependency]++] = EventIndex;
 		}
 	}
+}
 
-	return false;
+bool UDialogueEventNode::GetIsBlocking() const
+{
+	return OutstandingEvents > 0;
+}
+
+const TArray<TObjectPtr<UDialogueEventBase>>& UDialogueEventNode::GetEvents() 
+	const
+{
+	return Events;
 }
 
 void UDialogueEventNode::PlayEvents()
 {
-	for (UDialogueEventBase* Event : Events)
+	OutstandingEvents = Events.Num();
+	RunningEvents.Init(false, Events.Num());
+	if (EventDependencyCounts.IsEmpty())
 	{
-		// Subscribe to the event's callback for stopping blocking
-		Event->OnStoppedBlocking.BindUFunction(
-			this,
-			"TransitionIfNotBlocking"
-		);
+		RemainingDependencies.Init(0, Events.Num());
+	}
+	else
+	{
+		RemainingDependencies = EventDependencyCounts;
+	}
 
-		// Play the event
-		Event->PlayEvent();
+	//Start every event with nothing to wait on
+	bSchedulingEvents = true;
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+	{
+		if (RemainingDependencies[EventIndex] == 0)
+		{
+			StartEvent(EventIndex);
+		}
 	}
+	bSchedulingEvents = false;
 }
 
 void UDialogueEventNode::TransitionIfNotBlocking() const
@@ -83,3 +175,83 @@ void UDialogueEventNode::TransitionIfNotBlocking() const
 		Dialogue->EndDialogue();
 	}
 }
+
+void UDialogueEventNode::StartEvent(int32 InIndex)
+{
+	UDialogueEventBase* Event = Events[InIndex];
+
+	//Nobody is close enough to see cosmetic events, so pass straight over
+	if (Event->GetIsCosmetic() && Dialogue->GetLOD() != EDialogueLOD::Full)
+	{
+		FinishEvent(InIndex);
+		return;
+	}
+
+	// Subscribe to the event's callback for stopping blocking once
+	if (!Event->OnStoppedBlocking.IsBound())
+	{
+		Event->OnStoppedBlocking.BindUObject(
+			this,
+			&UDialogueEventNode::OnEventStoppedBlocking,
+			InIndex
+		);
+	}
+
+	// Play the event; blocks released while playing are picked up below
+	Event->PlayEvent();
+
+	if (Event->GetIsBlocking())
+	{
+		RunningEvents[InIndex] = true;
+	}
+	else
+	{
+		FinishEvent(InIndex);
+	}
+}
+
+void UDialogueEventNode::FinishEvent(int32 InIndex)
+{
+	RunningEvents[InIndex] = false;
+	--OutstandingEvents;
+
+	if (EventDependentOffsets.IsEmpty())
+	{
+		return;
+	}
+
+	//Start dependents with nothing left to wait on
+	for (int32 Edge = EventDependentOffsets[InIndex];
+		Edge < EventDependentOffsets[InIndex + 1]; ++Edge)
+	{
+		const int32 Dependent = EventDependents[Edge];
+		if (--RemainingDependencies[Dependent] == 0)
+		{
+			StartEvent(Dependent);
+		}
+	}
+}
+
+void UDialogueEventNode::OnEventStoppedBlocking(int32 InIndex)
+{
+	if (!RunningEvents.IsValidIndex(InIndex) || !RunningEvents[InIndex])
+	{
+		return;
+	}
+
+	//Completions during scheduling are checked by whoever started it
+	if (bSchedulingEvents)
+	{
+		FinishEvent(InIndex);
+		return;
+	}
+
+	bSchedulingEvents = true;
+	FinishEvent(InIndex);
+	bSchedulingEvents = false;
+
+	if (OutstandingEvents == 0)
+	{
+		TransitionIfNotBlocking();
+	}
+}
@@ -4,6 +4,7 @@
 #include "Nodes/DialogueJumpNode.h"
 //Plugin
 #include "Dialogue.h"
+#include "Export/DialogueTextExporter.h"
 
 void UDialogueJumpNode::EnterNode()
 {
@@ -23,6 +24,16 @@ FDialogueOption UDialogueJumpNode::GetAsOption()
 	return FDialogueOption();
 }
 
+void UDialogueJumpNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+	Super::GetExportData(OutNode);
+
+	if (JumpTarget)
+	{
+		OutNode.AddField(TEXT("JumpTarget"), JumpTarget->GetNodeID().ToString());
+	}
+}
+
 void UDialogueJumpNode::SetJumpTarget(UDialogueNode* InTarget)
 {
 	check(InTarget);
@@ -4,6 +4,7 @@
 #include "Nodes/DialogueNode.h"
 //Plugin
 #include "Dialogue.h"
+#include "Export/DialogueTextExporter.h"
 
 UDialogue* UDialogueNode::GetDialogue() const
 {
@@ -41,11 +42,30 @@ TArray<UDialogueNode*> UDialogueNode::GetChildren() const
     return Children;
 }
 
+UDialogueNode* UDialogueNode::GetFirstChild() const
+{
+    return Children.IsEmpty() ? nullptr : Children[0].Get();
+}
+
 FDialogueOption UDialogueNode::GetAsOption()
 {
     return FDialogueOption();
 }
 
+void UDialogueNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+    OutNode.NodeID = NodeID;
+    OutNode.NodeType = GetClass()->GetName();
+
+    for (const UDialogueNode* Child : Children)
+    {
+        if (Child)
+        {
+            OutNode.Children.Add(Child->GetNodeID());
+        }
+    }
+}
+
 FName UDialogueNode::GetNodeID() const
 {
     return NodeID;
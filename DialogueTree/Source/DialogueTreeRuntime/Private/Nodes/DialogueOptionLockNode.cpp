@@ -5,6 +5,7 @@
 //Plugin
 #include "Conditionals/DialogueCondition.h"
 #include "Dialogue.h"
+#include "Export/DialogueTextExporter.h"
 
 FDialogueOption UDialogueOptionLockNode::GetAsOption()
 {
@@ -18,12 +19,12 @@ FDialogueOption UDialogueOptionLockNode::GetAsOption()
 	if (!PassesConditions())
 	{
 		Option.Details.bIsLocked = true;
-		Option.Details.OptionMessage = LockedMessage;
+		Option.Details.OptionMessage = GetLockedMessage();
 	}
 	else
 	{
 		Option.Details.bIsLocked = false;
-		Option.Details.OptionMessage = UnlockedMessage;
+		Option.Details.OptionMessage = GetUnlockedMessage();
 	}
 
 	return Option;
@@ -46,13 +47,32 @@ void UDialogueOptionLockNode::EnterNode()
 	Dialogue->TraverseNode(Children[0]);
 }
 
+void UDialogueOptionLockNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+	Super::GetExportData(OutNode);
+
+	OutNode.AddField(TEXT("IfAny"), LexToString(bIfAny));
+	for (UDialogueCondition* Condition : Conditions)
+	{
+		OutNode.AddCondition(Condition);
+	}
+
+	OutNode.AddText(TEXT("LockedMessage"), GetLockedMessage());
+	OutNode.AddText(TEXT("UnlockedMessage"), GetUnlockedMessage());
+}
+
 void UDialogueOptionLockNode::InitLockNodeData(bool InIfAny, 
 	TArray<UDialogueCondition*>& InConditions, const FText& LockedText, 
-	const FText& UnlockedText)
+	const FText& UnlockedText, const FString& LockedKey, 
+	const FString& UnlockedKey)
 {
 	bIfAny = InIfAny;
-	LockedMessage = LockedText;
-	UnlockedMessage = UnlockedText;
+
+	//Messages held by the string table need not be stored on the node
+	LockedMessageKey = LockedKey;
+	UnlockedMessageKey = UnlockedKey;
+	LockedMessage = LockedKey.IsEmpty() ? LockedText : FText::GetEmpty();
+	UnlockedMessage = UnlockedKey.IsEmpty() ? UnlockedText : FText::GetEmpty();
 
 	Conditions.Empty();
 	for (UDialogueCondition* Condition : InConditions)
@@ -61,6 +81,26 @@ void UDialogueOptionLockNode::InitLockNodeData(bool InIfAny,
 	}
 }
 
+FText UDialogueOptionLockNode::GetLockedMessage() const
+{
+	if (LockedMessageKey.IsEmpty() || !Dialogue)
+	{
+		return LockedMessage;
+	}
+
+	return Dialogue->ResolveText(LockedMessageKey);
+}
+
+FText UDialogueOptionLockNode::GetUnlockedMessage() const
+{
+	if (UnlockedMessageKey.IsEmpty() || !Dialogue)
+	{
+		return UnlockedMessage;
+	}
+
+	return Dialogue->ResolveText(UnlockedMessageKey);
+}
+
 bool UDialogueOptionLockNode::PassesConditions() const
 {
 	if (bIfAny)
@@ -2,29 +2,93 @@
 
 //Header
 #include "Nodes/DialogueSpeechNode.h"
+//UE
+#include "Sound/SoundBase.h"
 //Plugin
 #include "Dialogue.h"
 #include "DialogueSpeakerComponent.h"
+#include "DialogueTextArgumentProvider.h"
+#include "Export/DialogueTextExporter.h"
 #include "LogDialogueTree.h"
+#include "Transitions/AutoDialogueTransition.h"
 #include "Transitions/DialogueTransition.h"
 
 void UDialogueSpeechNode::InitSpeechData(FSpeechDetails& InDetails,
-	TSubclassOf<UDialogueTransition> TransitionType)
+	TSubclassOf<UDialogueTransition> TransitionType, const FString& InTextKey)
 {
 	check(TransitionType);
 	Details = InDetails;
+
+	//Text held by the string table need not be stored on the node
+	SpeechTextKey = InTextKey;
+	if (!SpeechTextKey.IsEmpty())
+	{
+		Details.SpeechText = FText::GetEmpty();
+	}
+	bSpeechFormatCached = false;
+
 	Transition = NewObject<UDialogueTransition>(this, TransitionType);
 	Transition->SetOwningNode(this);
 }
 
-FSpeechDetails UDialogueSpeechNode::GetDetails() const
+const FSpeechDetails& UDialogueSpeechNode::GetDetails() const
 {
-	return Details;
+	if (!Dialogue)
+	{
+		return Details;
+	}
+
+	if (!bSpeechFormatCached)
+	{
+		CacheSpeechFormat();
+	}
+
+	const IDialogueTextArgumentProvider* Provider = 
+		SpeechArgumentNames.IsEmpty() 
+		? nullptr 
+		: Dialogue->GetTextArgumentProvider();
+
+	//Plain inline text needs no resolving, so hand out the stored details
+	if (SpeechTextKey.IsEmpty() && !Provider)
+	{
+		return Details;
+	}
+
+	ResolvedDetails = Details;
+	if (!SpeechTextKey.IsEmpty())
+	{
+		ResolvedDetails.SpeechText = Dialogue->ResolveText(SpeechTextKey);
+	}
+
+	//Substitute arguments into the precompiled pattern
+	if (Provider)
+	{
+		FFormatNamedArguments Arguments;
+		Provider->GetTextArguments(SpeechArgumentNames, Arguments);
+		ResolvedDetails.SpeechText = FText::Format(SpeechFormat, Arguments);
+	}
+
+	return ResolvedDetails;
 }
 
 UDialogueSpeakerComponent* UDialogueSpeechNode::GetSpeaker() const
 {
-	return Dialogue->GetSpeaker(Details.SpeakerName);
+	return Dialogue->GetSpeakerInSlot(SpeakerSlot);
+}
+
+void UDialogueSpeechNode::SetSpeakerSlot(int32 InSlot)
+{
+	SpeakerSlot = InSlot;
+}
+
+int32 UDialogueSpeechNode::GetSpeakerSlot() const
+{
+	return SpeakerSlot;
+}
+
+bool UDialogueSpeechNode::GetIsAutoTransition() const
+{
+	return Transition && Transition->IsA<UAutoDialogueTransition>();
 }
 
 bool UDialogueSpeechNode::GetCanSkip() const
@@ -32,6 +96,39 @@ bool UDialogueSpeechNode::GetCanSkip() const
 	return Details.bCanSkip;
 }
 
+float UDialogueSpeechNode::GetCooldown() const
+{
+	return Details.Cooldown;
+}
+
+float UDialogueSpeechNode::GetMinimumPlayTime() const
+{
+	return Details.MinimumPlayTime;
+}
+
+float UDialogueSpeechNode::GetAudioDuration() const
+{
+	if (Details.bIgnoreContent || !Details.SpeechAudio)
+	{
+		return 0.f;
+	}
+
+	const float Duration = Details.SpeechAudio->GetDuration();
+	return Duration < INDEFINITELY_LOOPING_DURATION ? Duration : 0.f;
+}
+
+void UDialogueSpeechNode::PostLoad()
+{
+	Super::PostLoad();
+
+	//Nodes compiled before speaker slots existed resolve theirs once here
+	if (SpeakerSlot == INDEX_NONE && Dialogue)
+	{
+		Dialogue->ConditionalPostLoad();
+		SpeakerSlot = Dialogue->GetSpeakerSlot(Details.SpeakerName);
+	}
+}
+
 void UDialogueSpeechNode::SelectOption(int32 InOptionIndex)
 {
 	Transition->SelectOption(InOptionIndex);
@@ -43,7 +140,7 @@ void UDialogueSpeechNode::EnterNode()
 	PlayEvents();
 
 	//Verify speaker is actually present
-	if (!Dialogue->SpeakerIsPresent(Details.SpeakerName))
+	if (!GetSpeaker())
 	{
 		UE_LOG(
 			LogDialogueTree,
@@ -57,11 +154,17 @@ void UDialogueSpeechNode::EnterNode()
 
 	if (!Details.bIgnoreContent)
 	{
-		//Display the current speech
-		Dialogue->DisplaySpeech(Details);
+		Dialogue->MarkSpeechSpoken(this);
+
+		//Far off conversations run on timing alone
+		if (Dialogue->GetLOD() != EDialogueLOD::Virtual)
+		{
+			//Display the current speech
+			Dialogue->DisplaySpeech(GetDetails(), SpeakerSlot);
 
-		//Play any audio and set any flags for the speaker
-		StartAudio();
+			//Play any audio and set any flags for the speaker
+			StartAudio();
+		}
 	}
 	
 	//If no transition, throw an error and close the dialogue 
@@ -89,6 +192,83 @@ void UDialogueSpeechNode::Skip()
 	}
 }
 
+void UDialogueSpeechNode::OnLODChanged(EDialogueLOD InOldLOD)
+{
+	//Only going into or out of virtual changes what is playing
+	const bool bWasVirtual = InOldLOD == EDialogueLOD::Virtual;
+	const bool bIsVirtual = Dialogue->GetLOD() == EDialogueLOD::Virtual;
+	UDialogueSpeakerComponent* Speaker = GetSpeaker();
+	if (bWasVirtual == bIsVirtual || Details.bIgnoreContent || !Speaker
+		|| !Transition)
+	{
+		return;
+	}
+
+	if (bIsVirtual)
+	{
+		//Carry on in silence, holding to when the audio would have ended
+		Transition->VirtualizeAudio();
+		Speaker->StopSpeechAudio();
+		Speaker->ClearGameplayTags();
+	}
+	else
+	{
+		//Pick the speech up from where it would have got to
+		Dialogue->DisplaySpeech(GetDetails(), SpeakerSlot);
+		StartAudio(Transition->GetElapsedTime());
+	}
+}
+
+void UDialogueSpeechNode::GetExportData(FDialogueExportNode& OutNode) const
+{
+	Super::GetExportData(OutNode);
+
+	OutNode.AddField(TEXT("Speaker"), Details.SpeakerName.ToString());
+	OutNode.AddText(TEXT("Text"), GetDetails().SpeechText);
+
+	if (Details.SpeechAudio)
+	{
+		OutNode.AddField(TEXT("Audio"), Details.SpeechAudio->GetPathName());
+	}
+
+	OutNode.AddField(
+		TEXT("MinimumPlayTime"), 
+		FString::SanitizeFloat(Details.MinimumPlayTime)
+	);
+	if (Details.Cooldown > 0.f)
+	{
+		OutNode.AddField(
+			TEXT("Cooldown"), 
+			FString::SanitizeFloat(Details.Cooldown)
+		);
+	}
+	OutNode.AddField(TEXT("CanSkip"), LexToString(Details.bCanSkip));
+	OutNode.AddField(
+		TEXT("IgnoreContent"), 
+		LexToString(Details.bIgnoreContent)
+	);
+
+	//Sort tags so container order does not leak into the export
+	TArray<FString> TagNames;
+	for (const FGameplayTag& Tag : Details.GameplayTags)
+	{
+		TagNames.Add(Tag.ToString());
+	}
+	TagNames.Sort();
+	for (const FString& TagName : TagNames)
+	{
+		OutNode.AddField(TEXT("Tag"), TagName);
+	}
+
+	if (Transition)
+	{
+		OutNode.AddField(
+			TEXT("Transition"), 
+			Transition->GetClass()->GetName()
+		);
+	}
+}
+
 void UDialogueSpeechNode::TransitionIfNotBlocking() const
 {
 	Transition->CheckTransitionConditions();
@@ -96,24 +276,43 @@ void UDialogueSpeechNode::TransitionIfNotBlocking() const
 
 FDialogueOption UDialogueSpeechNode::GetAsOption()
 {
-	return FDialogueOption{ Details, this };
+	return FDialogueOption{ GetDetails(), this };
 }
 
-void UDialogueSpeechNode::StartAudio()
+void UDialogueSpeechNode::StartAudio(float InStartTime)
 {
-	UDialogueSpeakerComponent* Speaker = GetSpeaker();
-
-	if (Speaker)
+	if (UDialogueSpeakerComponent* Speaker = GetSpeaker())
 	{
-		//Play any audio
-		Speaker->Stop();
+		Speaker->PlaySpeechFrom(Details, InStartTime);
+	}
+}
 
-		if (Details.SpeechAudio)
-		{
-			Speaker->PlaySpeechAudioClip(Details.SpeechAudio);
-		}
+void UDialogueSpeechNode::CacheSpeechFormat() const
+{
+	bSpeechFormatCached = true;
+	SpeechArgumentNames.Reset();
+
+	const FText SpeechText = SpeechTextKey.IsEmpty() || !Dialogue
+		? Details.SpeechText
+		: Dialogue->ResolveText(SpeechTextKey);
+
+	//Scan the source string, which is the same whatever the culture
+	const FString* SourceString = FTextInspector::GetSourceString(SpeechText);
+
+	//Most speech has no arguments, so skip compiling a pattern for it
+	if (!SourceString || !SourceString->Contains(TEXT("{")))
+	{
+		SpeechFormat = FTextFormat();
+		return;
+	}
 
-		//Set any behavior flags
-		Speaker->SetCurrentGameplayTags(Details.GameplayTags);
+	const FTextFormat SourceFormat = FTextFormat::FromString(*SourceString);
+	if (SourceFormat.IsValid())
+	{
+		SourceFormat.GetFormatArgumentNames(SpeechArgumentNames);
 	}
-}
\ No newline at end of file
+
+	//Built from the text, the pattern recompiles itself if the culture
+	//changes
+	SpeechFormat = FTextFormat(SpeechText);
+}
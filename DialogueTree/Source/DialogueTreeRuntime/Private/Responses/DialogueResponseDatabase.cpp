@@ -0,0 +1,210 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "Responses/DialogueResponseDatabase.h"
+//Plugin
+#include "Dialogue.h"
+#include "LogDialogueTree.h"
+#include "Nodes/DialogueSpeechNode.h"
+
+int32 FDialogueResponseRule::GetSpecificity() const
+{
+	return RequiredFacts.Num()
+		+ Criteria.Num()
+		+ (SpeakerName.IsNone() ? 0 : 1);
+}
+
+void UDialogueResponseDatabase::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileRules();
+}
+
+#if WITH_EDITOR
+void UDialogueResponseDatabase::PostEditChangeProperty(
+	FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileRules();
+}
+#endif
+
+bool UDialogueResponseDatabase::FindResponse(
+	const FDialogueResponseQuery& InQuery, UDialogue*& OutDialogue,
+	FName& OutNodeID) const
+{
+	return FindFilteredResponse(
+		InQuery,
+		[](const FDialogueResponseRule&) { return true; },
+		OutDialogue,
+		OutNodeID
+	);
+}
+
+bool UDialogueResponseDatabase::FindFilteredResponse(
+	const FDialogueResponseQuery& InQuery,
+	TFunctionRef<bool(const FDialogueResponseRule&)> InFilter,
+	UDialogue*& OutDialogue, FName& OutNodeID) const
+{
+	OutDialogue = nullptr;
+	OutNodeID = NAME_None;
+
+	const FDialogueResponseBucket* Bucket = Buckets.Find(InQuery.Concept);
+	if (!Bucket)
+	{
+		return false;
+	}
+
+	//Mark every rule needing a fact the query lacks
+	CandidateRules.Init(false, Bucket->Rules.Num());
+	for (int32 FactIndex = 0; FactIndex < Bucket->FactTags.Num(); ++FactIndex)
+	{
+		if (!InQuery.Facts.HasTag(Bucket->FactTags[FactIndex]))
+		{
+			CandidateRules.CombineWithBitwiseOR(
+				Bucket->RulesRequiringFact[FactIndex],
+				EBitwiseOperatorFlags::MaintainSize
+			);
+		}
+	}
+
+	//And every rule meant for another speaker
+	for (int32 SpeakerIndex = 0; SpeakerIndex < Bucket->SpeakerNames.Num();
+		++SpeakerIndex)
+	{
+		if (Bucket->SpeakerNames[SpeakerIndex] != InQuery.SpeakerName)
+		{
+			CandidateRules.CombineWithBitwiseOR(
+				Bucket->RulesRequiringSpeaker[SpeakerIndex],
+				EBitwiseOperatorFlags::MaintainSize
+			);
+		}
+	}
+
+	//Whatever is left unmarked could match
+	CandidateRules.BitwiseNOT();
+
+	//Walk the survivors most specific first, picking by weight among the
+	//most specific that pass their numeric criteria and the filter
+	const FDialogueResponseRule* Chosen = nullptr;
+	int32 BestSpecificity = INDEX_NONE;
+	float TotalWeight = 0.f;
+	for (TConstSetBitIterator<> It(CandidateRules); It; ++It)
+	{
+		const FDialogueResponseRule& Rule = 
+			Rules[Bucket->Rules[It.GetIndex()]];
+		const int32 Specificity = Rule.GetSpecificity();
+		if (Specificity < BestSpecificity)
+		{
+			break;
+		}
+
+		if (!MatchesCriteria(Rule, InQuery) || !InFilter(Rule))
+		{
+			continue;
+		}
+
+		BestSpecificity = Specificity;
+		TotalWeight += Rule.Weight;
+		if (!Chosen || FMath::FRand() * TotalWeight < Rule.Weight)
+		{
+			Chosen = &Rule;
+		}
+	}
+
+	if (!Chosen)
+	{
+		return false;
+	}
+
+	OutDialogue = Chosen->Dialogue;
+	OutNodeID = Chosen->NodeID;
+	return true;
+}
+
+void UDialogueResponseDatabase::CompileRules()
+{
+	Buckets.Reset();
+
+	//Sort valid rules into buckets by concept
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FDialogueResponseRule& Rule = Rules[RuleIndex];
+		const TObjectPtr<UDialogueNode>* Node = Rule.Dialogue
+			? Rule.Dialogue->GetNodes().Find(Rule.NodeID)
+			: nullptr;
+		if (!Node || !Cast<UDialogueSpeechNode>(*Node))
+		{
+			UE_LOG(
+				LogDialogueTree,
+				Warning,
+				TEXT("Response rule %d in %s does not point to a speech node and will be ignored."),
+				RuleIndex,
+				*GetName()
+			);
+			continue;
+		}
+
+		Buckets.FindOrAdd(Rule.Concept).Rules.Add(RuleIndex);
+	}
+
+	for (TPair<FGameplayTag, FDialogueResponseBucket>& Entry : Buckets)
+	{
+		FDialogueResponseBucket& Bucket = Entry.Value;
+
+		//Most specific first, so a query can stop at the first step down
+		Bucket.Rules.StableSort(
+			[this](int32 A, int32 B)
+			{
+				return Rules[A].GetSpecificity() > Rules[B].GetSpecificity();
+			}
+		);
+
+		//Mark which rules need each fact and speaker
+		const int32 NumRules = Bucket.Rules.Num();
+		for (int32 Position = 0; Position < NumRules; ++Position)
+		{
+			const FDialogueResponseRule& Rule = Rules[Bucket.Rules[Position]];
+
+			for (const FGameplayTag& Fact : Rule.RequiredFacts)
+			{
+				int32 FactIndex = Bucket.FactTags.Find(Fact);
+				if (FactIndex == INDEX_NONE)
+				{
+					FactIndex = Bucket.FactTags.Add(Fact);
+					Bucket.RulesRequiringFact.Emplace(false, NumRules);
+				}
+				Bucket.RulesRequiringFact[FactIndex][Position] = true;
+			}
+
+			if (!Rule.SpeakerName.IsNone())
+			{
+				int32 SpeakerIndex =
+					Bucket.SpeakerNames.Find(Rule.SpeakerName);
+				if (SpeakerIndex == INDEX_NONE)
+				{
+					SpeakerIndex = Bucket.SpeakerNames.Add(Rule.SpeakerName);
+					Bucket.RulesRequiringSpeaker.Emplace(false, NumRules);
+				}
+				Bucket.RulesRequiringSpeaker[SpeakerIndex][Position] = true;
+			}
+		}
+	}
+}
+
+bool UDialogueResponseDatabase::MatchesCriteria(
+	const FDialogueResponseRule& InRule, const FDialogueResponseQuery& InQuery)
+{
+	for (const FDialogueFactCriterion& Criterion : InRule.Criteria)
+	{
+		const float* Value = InQuery.FactValues.Find(Criterion.Fact);
+		if (!Value || *Value < Criterion.Min || *Value > Criterion.Max)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -8,16 +8,11 @@
 #include "Dialogue.h"
 #include "DialogueConnectionLimit.h"
 #include "DialogueSpeakerComponent.h"
+#include "DialogueTransitionScheduler.h"
 #include "Nodes/DialogueNode.h"
 #include "Nodes/DialogueSpeechNode.h"
 #include "LogDialogueTree.h"
 
-UDialogueTransition::UDialogueTransition()
-{
-	OnContentEnd.BindUFunction(this, "OnDonePlayingContent");
-	OnTimerEnd.BindUFunction(this, "OnMinPlayTimeElapsed");
-}
-
 void UDialogueTransition::SetOwningNode(UDialogueSpeechNode* InNode)
 {
 	OwningNode = InNode;
@@ -25,9 +20,11 @@ void UDialogueTransition::SetOwningNode(UDialogueSpeechNode* InNode)
 
 void UDialogueTransition::StartTransition()
 {
-	//Reset end marker values
+	//Reset end marker values and retire anything still scheduled
 	bMinPlayTimeElapsed = false;
 	bAudioFinished = false;
+	bAudioVirtualized = false;
+	++WaitID;
 
 	//Verify owning node exists
 	if (!OwningNode)
@@ -54,17 +51,16 @@ void UDialogueTransition::StartTransition()
 		return;
 	}
 
-	//Set timer for minimum play time
-	float MinPlayTime = OwningNode->GetDetails().MinimumPlayTime;
+	UDialogueTransitionScheduler* Scheduler = GetScheduler();
+	check(Scheduler);
+	StartTime = Speaker->GetWorld()->GetTimeSeconds();
+
+	//Schedule the minimum play time
+	const float MinPlayTime = OwningNode->GetDetails().MinimumPlayTime;
 
 	if (MinPlayTime > 0.01f)
 	{
-		Speaker->GetWorld()->GetTimerManager().SetTimer(
-			MinPlayTimeHandle,
-			OnTimerEnd,
-			MinPlayTime,
-			false
-		);
+		Scheduler->ScheduleMinPlayTime(this, WaitID, MinPlayTime);
 	}
 	//No minimum time
 	else
@@ -72,10 +68,35 @@ void UDialogueTransition::StartTransition()
 		bMinPlayTimeElapsed = true;
 	}
 
-	//Start listening to see when the audio content finishes 
-	if (Speaker->IsPlaying())
+	//Virtual speech plays no audio, but still takes as long as it would
+	if (OwningNode->GetDialogue()->GetLOD() == EDialogueLOD::Virtual)
+	{
+		const float AudioDuration = OwningNode->GetAudioDuration();
+		if (AudioDuration > 0.f)
+		{
+			bAudioVirtualized = true;
+			Scheduler->ScheduleAudioEnd(this, WaitID, AudioDuration);
+		}
+		else
+		{
+			bAudioFinished = true;
+		}
+	}
+	//Wait to hear when the audio content finishes 
+	else if (Speaker->IsSpeechAudioPlaying())
+	{
+		Scheduler->WaitForAudio(this, WaitID, Speaker);
+	}
+	//Audio refused a voice channel, as when culled by distance, keeps its
+	//timing the same way virtual speech does
+	else if (OwningNode->GetAudioDuration() > 0.f)
 	{
-		Speaker->OnAudioFinished.AddUnique(OnContentEnd);
+		bAudioVirtualized = true;
+		Scheduler->ScheduleAudioEnd(
+			this,
+			WaitID,
+			OwningNode->GetAudioDuration()
+		);
 	}
 	//No audio playing 
 	else
@@ -108,6 +129,39 @@ void UDialogueTransition::Skip()
 	);
 }
 
+void UDialogueTransition::VirtualizeAudio()
+{
+	if (bAudioFinished || bAudioVirtualized)
+	{
+		return;
+	}
+
+	UDialogueSpeakerComponent* Speaker = OwningNode->GetSpeaker();
+	UDialogueTransitionScheduler* Scheduler = GetScheduler();
+	if (!Speaker || !Scheduler)
+	{
+		return;
+	}
+
+	//Finishing is left to the next tick, so the level change that got us
+	//here completes before the dialogue moves on
+	bAudioVirtualized = true;
+	Scheduler->CancelAudioWait(Speaker);
+	Scheduler->ScheduleAudioEnd(
+		this,
+		WaitID,
+		FMath::Max(OwningNode->GetAudioDuration() - GetElapsedTime(), 0.f)
+	);
+}
+
+float UDialogueTransition::GetElapsedTime() const
+{
+	const UDialogueSpeakerComponent* Speaker = OwningNode->GetSpeaker();
+	return Speaker
+		? Speaker->GetWorld()->GetTimeSeconds() - StartTime
+		: 0.f;
+}
+
 FText UDialogueTransition::GetDisplayName() const
 {
 	return FText::FromString(StaticClass()->GetName());
@@ -133,13 +187,16 @@ void UDialogueTransition::CheckTransitionConditions()
 
 void UDialogueTransition::OnDonePlayingContent()
 {
-	//Unbind from audio event 
+	//Stop waiting on the audio 
 	UDialogueSpeakerComponent* Speaker = OwningNode->GetSpeaker();
 
 	if (Speaker)
 	{
-		Speaker->Stop();
-		Speaker->OnAudioFinished.Remove(OnContentEnd);
+		if (UDialogueTransitionScheduler* Scheduler = GetScheduler())
+		{
+			Scheduler->CancelAudioWait(Speaker);
+		}
+		Speaker->StopSpeechAudio();
 	}
 
 	//Mark audio complete
@@ -157,3 +214,13 @@ void UDialogueTransition::OnMinPlayTimeElapsed()
 	//Check if we should transition out
 	CheckTransitionConditions();
 }
+
+UDialogueTransitionScheduler* UDialogueTransition::GetScheduler() const
+{
+	UDialogueSpeakerComponent* Speaker = OwningNode->GetSpeaker();
+	UWorld* World = Speaker ? Speaker->GetWorld() : nullptr;
+
+	return World 
+		? World->GetSubsystem<UDialogueTransitionScheduler>() 
+		: nullptr;
+}
@@ -75,7 +75,7 @@ void UInputDialogueTransition::SelectOption(int32 InOptionIndex)
 	UDialogueSpeakerComponent* Speaker = OwningNode->GetSpeaker();
 	if (Speaker)
 	{
-		Speaker->Stop();
+		Speaker->StopSpeechAudio();
 	}
 
 	//Transition to the selected node 
@@ -113,8 +113,8 @@ void UInputDialogueTransition::ShowOptions()
 
 void UInputDialogueTransition::GetOptions()
 {
-	//Retrieve all valid options 
-	Options.Empty();
+	//Retrieve all valid options, keeping the buffer between menus
+	Options.Reset();
 	TArray<UDialogueNode*> NodeChildren = OwningNode->GetChildren();
 
 	for (UDialogueNode* Node : NodeChildren)
@@ -124,7 +124,7 @@ void UInputDialogueTransition::GetOptions()
 		//If a valid option
 		if (!NodeOption.Details.SpeechText.IsEmpty() && NodeOption.TargetNode)
 		{
-			Options.Add(NodeOption);
+			Options.Add(MoveTemp(NodeOption));
 		}
 	}
 }
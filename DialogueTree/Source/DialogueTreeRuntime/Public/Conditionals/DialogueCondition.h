@@ -27,6 +27,13 @@ public:
 	*/
 	virtual void SetQuery(UDialogueQuery* InQuery);
 
+	/**
+	* Retrieves the query for the condition. 
+	* 
+	* @return UDialogueQuery* - the query, nullptr if none. 
+	*/
+	virtual UDialogueQuery* GetQuery() const;
+
 	/**
 	* Sets the dialogue for the condition and its query.
 	*
@@ -23,6 +23,7 @@ public:
 	/** UDialogueCondition Impl. */
 	virtual bool IsMet() const override;
 	virtual void SetQuery(UDialogueQuery* InQuery) override;
+	virtual UDialogueQuery* GetQuery() const override;
 	virtual void SetDialogue(UDialogue* InDialogue) override;
 	virtual FText GetDisplayText(const TMap<FName, FText>& ArgTexts,
 		const FText QueryText) const override;
@@ -30,6 +31,22 @@ public:
 	virtual bool IsValidCondition() override;
 	/** End UDialogueCondition */
 
+	/**
+	* Sets whether the query must be true or false for the condition to 
+	* be met. 
+	* 
+	* @param bInQueryTrue - bool, whether the query should be true.
+	*/
+	void SetQueryTrue(bool bInQueryTrue);
+
+	/**
+	* Checks whether the query must be true or false for the condition to
+	* be met. 
+	* 
+	* @return bool - whether the query should be true. 
+	*/
+	bool GetQueryTrue() const;
+
 private: 
 	/** The query for the condition  */
 	UPROPERTY()
@@ -34,6 +34,7 @@ public:
 	/** UDialogueCondition Impl. */
 	virtual bool IsMet() const override;
 	virtual void SetQuery(UDialogueQuery* InQuery) override;
+	virtual UDialogueQuery* GetQuery() const override;
 	virtual void SetDialogue(UDialogue* InDialogue) override;
 	virtual FText GetDisplayText(const TMap<FName, FText>& ArgTexts, 
 		const FText QueryText) const override;
@@ -0,0 +1,28 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "NodeVisitedQuery.h"
+//Generated
+#include "NodeSpokenRecentlyQuery.generated.h"
+
+/**
+ * Dialogue query that checks if a specified speech is on cooldown or 
+ * among its dialogue's most recently spoken lines. Useful for steering 
+ * away from lines the player has just heard.
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API UNodeSpokenRecentlyQuery : 
+	public UNodeVisitedQuery
+{
+	GENERATED_BODY()
+
+public:
+	/** IDialogueQueryBool Impl. */
+	virtual bool ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	/** End IDialogueQueryBool */
+};
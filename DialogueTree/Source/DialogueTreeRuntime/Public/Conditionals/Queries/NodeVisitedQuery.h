@@ -39,7 +39,14 @@ public:
 	*/
 	UDialogueNodeSocket* GetSocket();
 
-private: 
+	/**
+	* Sets the node socket for this query.
+	* 
+	* @param InSocket - UDialogueNodeSocket*, the new socket.
+	*/
+	void SetSocket(UDialogueNodeSocket* InSocket);
+
+protected: 
 	/** Node to check */
 	UPROPERTY(EditAnywhere, Category = "Dialogue")
 	TObjectPtr<UDialogueNodeSocket> TargetNode;
@@ -0,0 +1,35 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "Conditionals/Queries/Base/DialogueQueryBool.h"
+//Generated
+#include "SpeakerOnCooldownQuery.generated.h"
+
+class UDialogueSpeakerSocket;
+
+/**
+ * Query that checks if a speaker is still cooling down from the last 
+ * thing it said. False if the speaker is not present. 
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API USpeakerOnCooldownQuery : 
+	public UDialogueQueryBool
+{
+	GENERATED_BODY()
+	
+public:
+	/** IDialogueQueryBool Impl. */
+	virtual bool ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	virtual bool IsValidQuery() const override;
+	/** End IDialogueQueryBool */
+
+private:
+	/** The speaker socket associated with the target speaker */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	TObjectPtr<UDialogueSpeakerSocket> Speaker;
+};
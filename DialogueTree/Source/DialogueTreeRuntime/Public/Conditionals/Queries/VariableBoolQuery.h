@@ -0,0 +1,41 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "Conditionals/Queries/Base/DialogueQueryBool.h"
+#include "DialogueVariables.h"
+//Generated
+#include "VariableBoolQuery.generated.h"
+
+/**
+ * Query that reads a bool dialogue variable. False if never set or if
+ * the variable's owner is not present.
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API UVariableBoolQuery : public UDialogueQueryBool
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+	/** IDialogueQueryBool Impl. */
+	virtual bool ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	virtual bool IsValidQuery() const override;
+	/** End IDialogueQueryBool */
+
+private:
+	/** The variable to read */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueVariable Variable;
+};
@@ -0,0 +1,41 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "Conditionals/Queries/Base/DialogueQueryFloat.h"
+#include "DialogueVariables.h"
+//Generated
+#include "VariableFloatQuery.generated.h"
+
+/**
+ * Query that reads a float dialogue variable. 0 if never set or if
+ * the variable's owner is not present.
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API UVariableFloatQuery : public UDialogueQueryFloat
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+	/** IDialogueQueryFloat Impl. */
+	virtual double ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	virtual bool IsValidQuery() const override;
+	/** End IDialogueQueryFloat */
+
+private:
+	/** The variable to read */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueVariable Variable;
+};
@@ -0,0 +1,41 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "Conditionals/Queries/Base/DialogueQueryInt.h"
+#include "DialogueVariables.h"
+//Generated
+#include "VariableIntQuery.generated.h"
+
+/**
+ * Query that reads an integer dialogue variable. 0 if never set or if
+ * the variable's owner is not present.
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API UVariableIntQuery : public UDialogueQueryInt
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+	/** IDialogueQueryInt Impl. */
+	virtual int32 ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	virtual bool IsValidQuery() const override;
+	/** End IDialogueQueryInt */
+
+private:
+	/** The variable to read */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueVariable Variable;
+};
@@ -0,0 +1,45 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Plugin
+#include "Conditionals/Queries/Base/DialogueQueryBool.h"
+#include "DialogueVariables.h"
+//Generated
+#include "VariableTagQuery.generated.h"
+
+/**
+ * Query that checks if a tag dialogue variable holds the given tag, or
+ * one beneath it. False if never set.
+ */
+UCLASS(EditInlineNew)
+class DIALOGUETREERUNTIME_API UVariableTagQuery : public UDialogueQueryBool
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+	/** IDialogueQueryBool Impl. */
+	virtual bool ExecuteQuery() override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	virtual bool IsValidQuery() const override;
+	/** End IDialogueQueryBool */
+
+private:
+	/** The variable to read */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueVariable Variable;
+
+	/** The tag to check for */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FGameplayTag Value;
+};
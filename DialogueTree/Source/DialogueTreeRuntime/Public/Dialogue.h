@@ -4,18 +4,24 @@
 
 //UE
 #include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
 #include "UObject/NoExportTypes.h"
 //Plugin
+#include "DialogueLOD.h"
+#include "DialogueSpeakerComponent.h"
 #include "Nodes/DialogueSpeechNode.h"
 //Generated
 #include "Dialogue.generated.h"
 
 class ADialogueController;
+class FDialogueVariableStore;
+class IDialogueTextArgumentProvider;
 class UDialogueEntryNode;
 class UDialogueNode;
 class UDialogueSpeakerComponent;
 class UDialogueSpeakerSocket;
 class UEdGraph;
+class UStringTable;
 
 DECLARE_DELEGATE(FSpeakerRolesChangedSignature);
 
@@ -106,12 +112,35 @@ public:
 	UDialogue();
 
 public: 
-#if WITH_EDITOR
 	/** UObject Impl. */
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 4
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context)
+		const override;
+#else
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags)
+		const override;
+#endif
+	virtual void PostLoad() override;
+#if WITH_EDITOR
 	virtual void PostEditChangeProperty(
 		struct FPropertyChangedEvent& PropertyChangedEvent) override;
-	/** End UObject */
 #endif
+	/** End UObject */
+
+public:
+	/** Asset registry tag names, for querying dialogues without loading */
+	static const FName SpeakerRolesTag;
+	static const FName CompileStatusTag;
+	static const FName NumNodesTag;
+	static const FName NumSpeechNodesTag;
+	static const FName NumEventNodesTag;
+	static const FName NumBranchNodesTag;
+	static const FName NumOptionLockNodesTag;
+	static const FName NumJumpNodesTag;
+	static const FName NumVoicedSpeechesTag;
+	static const FName WordCountTag;
+	static const FName EventClassesTag;
+	static const FName ReferencedAudioTag;
 
 	/**
 	* Sets the component value associated with the given name 
@@ -138,13 +167,66 @@ public:
 	UDialogueSpeakerComponent* GetSpeaker(FName InName) const;
 
 	/**
-	* Adds a speaker entry for the given name with a component value
-	* of nullptr. 
+	* Adds a speaker slot for the given name if there is not one already.
 	* 
-	* @param InName - FName, name to create an entry for.
+	* @param InName - FName, name to create a slot for.
 	*/
 	void AddSpeakerEntry(FName InName);
 
+	/**
+	* Retrieves the slot a speaking role was assigned when the dialogue 
+	* was compiled. Meant to be resolved once and cached by the caller. 
+	* 
+	* @param InName - FName, the role name. 
+	* @return int32 - the slot, INDEX_NONE if the dialogue has no such role.
+	*/
+	int32 GetSpeakerSlot(FName InName) const;
+
+	/**
+	* Retrieves the role name of the given slot. 
+	* 
+	* @param InSlot - int32, the slot. 
+	* @return FName - the role name, none if the slot is invalid.
+	*/
+	FName GetSpeakerSlotName(int32 InSlot) const;
+
+	/**
+	* Retrieves the role names of every slot, in slot order. 
+	* 
+	* @return const TArray<FName>& - the role names.
+	*/
+	const TArray<FName>& GetSpeakerSlotNames() const;
+
+	/**
+	* Retrieves the speaker component filling the given slot in the 
+	* current conversation. 
+	* 
+	* @param InSlot - int32, the slot. 
+	* @return UDialogueSpeakerComponent* - the component, nullptr if the 
+	* slot is invalid or unfilled. 
+	*/
+	UDialogueSpeakerComponent* GetSpeakerInSlot(int32 InSlot) const;
+
+	/**
+	* Retrieves the cached speaker and actor entry for the given slot in 
+	* the current conversation. 
+	* 
+	* @param InSlot - int32, the slot. 
+	* @return const FSpeakerActorEntry& - the entry, empty if the slot is 
+	* invalid or unfilled.
+	*/
+	const FSpeakerActorEntry& GetSpeakerEntryInSlot(int32 InSlot) const;
+
+	/**
+	* Checks whether the given component fills any slot of the current 
+	* conversation. 
+	* 
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the component. 
+	* @return bool - true if the component is a participant.
+	*/
+	bool HasSpeakerComponent(const UDialogueSpeakerComponent* InSpeaker) 
+		const;
+
 	/**
 	* Opens the dialogue at the given node ID. 
 	* 
@@ -163,6 +245,22 @@ public:
 	*/
 	void ClearController();
 
+	/**
+	* Gets how much of the dialogue is being played out.
+	*
+	* @return EDialogueLOD - the dialogue's current level of detail.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	EDialogueLOD GetLOD() const;
+
+	/**
+	* Sets how much of the dialogue is played out. The active node picks up
+	* the change straight away, mid-line if need be.
+	*
+	* @param InLOD - EDialogueLOD, the new level of detail.
+	*/
+	void SetLOD(EDialogueLOD InLOD);
+
 	/**
 	* Calls on the controller to end the dialogue. 
 	*/
@@ -173,17 +271,27 @@ public:
 	* 
 	* @param InDetails - const FSpeechDetails&, details for the 
 	* target speech. 
+	* @param InSpeakerSlot - int32, the slot of the speaking role.
+	*/
+	void DisplaySpeech(const FSpeechDetails& InDetails, int32 InSpeakerSlot) 
+		const;
+
+	/**
+	* Retrieves the controller's provider of formatted speech arguments. 
+	* 
+	* @return const IDialogueTextArgumentProvider* - the provider, nullptr 
+	* if none or if the dialogue is not playing. 
 	*/
-	void DisplaySpeech(const FSpeechDetails& InDetails) const;
+	const IDialogueTextArgumentProvider* GetTextArgumentProvider() const;
 
 	/**
 	* Calls on the controller to display the given dialogue options
 	* for the user to select from. 
 	* 
-	* @param InOptions - TArray<FDialogueOption>, options to
+	* @param InOptions - TConstArrayView<FDialogueOption>, options to
 	* display.
 	*/
-	void DisplayOptions(TArray<FDialogueOption> InOptions) const;
+	void DisplayOptions(TConstArrayView<FDialogueOption> InOptions) const;
 
 	/**
 	* Attempts to select a dialogue option at the given index. 
@@ -213,6 +321,15 @@ public:
 	*/
 	EDialogueCompileStatus GetCompileStatus() const;
 
+	/**
+	* Gets a number which changes each time the dialogue's nodes are
+	* cleared for compiling, so anything built from them can tell it is
+	* out of date.
+	*
+	* @return uint32 - the compile serial.
+	*/
+	uint32 GetCompileSerial() const;
+
 	/**
 	* Retrieves the entire map of expected speaker names to their 
 	* speaker components. 
@@ -250,6 +367,41 @@ public:
 	*/
 	void MarkNodeVisited(UDialogueNode* TargetNode, bool bVisited);
 
+	/**
+	* Checks if the given node was spoken recently enough that it should not
+	* be repeated yet. If dialogue is inactive, returns false.
+	*
+	* @param TargetNode - UDialogueNode*, the node we are interested in.
+	* @return bool - True if the node is on cooldown or among the most 
+	* recently spoken, False otherwise.
+	*/
+	bool WasNodeSpokenRecently(UDialogueNode* TargetNode) const;
+
+	/**
+	* Records that the given speech was spoken, putting it and its speaker
+	* on cooldown.
+	*
+	* @param InNode - UDialogueSpeechNode*, the speech.
+	*/
+	void MarkSpeechSpoken(UDialogueSpeechNode* InNode);
+
+	/**
+	* Checks if the given speaker is on cooldown. If dialogue is inactive, 
+	* returns false.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @return bool - True if the speaker is on cooldown, False otherwise.
+	*/
+	bool IsSpeakerOnCooldown(UDialogueSpeakerComponent* InSpeaker) const;
+
+	/**
+	* Gets the variables read and written by conditions and events. If 
+	* dialogue is inactive, returns nullptr.
+	*
+	* @return FDialogueVariableStore* - the variables.
+	*/
+	FDialogueVariableStore* GetVariables() const;
+
 	/**
 	* Marks all nodes in the dialogue unvisited. 
 	*/
@@ -277,6 +429,23 @@ public:
 	*/
 	UDialogueNode* GetRootNode() const;
 
+	/**
+	* Retrieves every compiled node of the dialogue, keyed by node ID.
+	*
+	* @return const TMap<FName, TObjectPtr<UDialogueNode>>& - the nodes.
+	*/
+	const TMap<FName, TObjectPtr<UDialogueNode>>& GetNodes() const;
+
+	/**
+	* Resolves a key compiled into the dialogue's string table to its text.
+	* The returned text references the table entry rather than copying it, 
+	* so it follows culture changes. 
+	* 
+	* @param InKey - const FString&, the string table key. 
+	* @return FText - the text, empty if the key is empty or not found. 
+	*/
+	FText ResolveText(const FString& InKey) const;
+
 #if WITH_EDITOR
 public:
 	/**
@@ -309,6 +478,15 @@ public:
 	*/
 	const TMap<FName, FSpeakerField>& GetSpeakerRoles() const;
 
+	/**
+	* Adds a speaker role with the given name if the dialogue does not 
+	* already have one. 
+	* 
+	* @param InName - FName, the name of the role.
+	* @return UDialogueSpeakerSocket* - the role's speaker socket.
+	*/
+	UDialogueSpeakerSocket* AddSpeakerRole(FName InName);
+
 	/**
 	* Add the given node to the dialogue. 
 	* 
@@ -348,9 +526,33 @@ public:
 	* @param InStatus - EDialogueCompileStatus, new compile status.
 	*/
 	void SetCompileStatus(EDialogueCompileStatus InStatus);
+
+	/**
+	* Adds the given text to the dialogue's string table if compiling text 
+	* to string tables is enabled. The text's own namespace and key are 
+	* kept so existing translations stay matched. The table takes the 
+	* namespace of the first text compiled into it; text from any other 
+	* namespace is left inline. 
+	* 
+	* @param InText - const FText&, the text to compile. 
+	* @param InFallbackKey - const FString&, the key to use if the text 
+	* has none of its own. Should be stable between compiles, e.g. derived
+	* from the node ID. 
+	* @return FString - the string table key, empty if the text should be 
+	* stored inline instead. 
+	*/
+	FString CompileText(const FText& InText, const FString& InFallbackKey);
 #endif
 
 private: 
+	/**
+	* Gathers the dialogue's asset registry tags, whichever engine version
+	* asks for them.
+	*
+	* @param OutTags - TArray<FAssetRegistryTag>&, added to.
+	*/
+	void GatherAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const;
+
 	/**
 	* Adds the default set of speakers into the graph.
 	*/
@@ -415,22 +617,37 @@ private:
 	UPROPERTY()
 	TObjectPtr<UDialogueEntryNode> RootNode; 
 
+	/** String table holding compiled text, if enabled in the settings */
+	UPROPERTY()
+	TObjectPtr<UStringTable> TextTable;
+
 	/** The currently active node in the dialogue */
 	UPROPERTY()
 	TObjectPtr<UDialogueNode> ActiveNode;
 
-	/** A mapping of speaker names to their found components */
+	/** Speaking role names, indexed by the slots assigned at compile time */
 	UPROPERTY()
-	TMap<FName, TObjectPtr<UDialogueSpeakerComponent>> Speakers;
+	TArray<FName> SpeakerSlotNames;
+
+	/** The participants of the current conversation, indexed by slot */
+	UPROPERTY(Transient)
+	TArray<FSpeakerActorEntry> SpeakerSlots;
 
 	/** The controlling actor for the dialogue */
 	UPROPERTY()
 	TObjectPtr<ADialogueController> DialogueController;
 
+	/** How much of the current conversation is played out */
+	UPROPERTY(Transient)
+	EDialogueLOD LOD = EDialogueLOD::Full;
+
 	/** Thhe current compile status of the dialogue */
 	UPROPERTY()
 	EDialogueCompileStatus CompileStatus = EDialogueCompileStatus::Uncompiled;
 
+	/** Bumped each time the nodes are cleared */
+	uint32 CompileSerial = 0;
+
 	/** The default colors for the speakers in the graph */
 	UPROPERTY()
 	FDefaultDialogueColors DefaultSpeakerColors;
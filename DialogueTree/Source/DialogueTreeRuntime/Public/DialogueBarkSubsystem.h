@@ -0,0 +1,219 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+//Plugin
+#include "DialogueLOD.h"
+#include "Responses/DialogueResponseDatabase.h"
+#include "SpeechDetails.h"
+//Generated
+#include "DialogueBarkSubsystem.generated.h"
+
+class ADialogueController;
+class UDialogue;
+class UDialogueLODSubsystem;
+class UDialogueResponseDatabase;
+class UDialogueSpeakerComponent;
+class UDialogueSpeechNode;
+
+/** Delegate used to pass data about barks as they are spoken */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FDialogueBarkSignature,
+	UDialogueSpeakerComponent*,
+	InSpeaker,
+	FSpeechDetails,
+	InSpeechDetails
+);
+
+/** Native counterpart of the above, passing a reference rather than a copy */
+DECLARE_MULTICAST_DELEGATE_TwoParams(
+	FDialogueBarkNativeSignature,
+	UDialogueSpeakerComponent*,
+	const FSpeechDetails&
+);
+
+/**
+* A bark in progress.
+*/
+struct FDialogueBark
+{
+	/** The dialogue the bark was taken from */
+	TWeakObjectPtr<UDialogue> Dialogue;
+
+	/** The speech currently being spoken */
+	TWeakObjectPtr<UDialogueSpeechNode> Node;
+
+	/** The speaker barking */
+	TWeakObjectPtr<UDialogueSpeakerComponent> Speaker;
+
+	/** World time at which the current speech started */
+	double StartTime = 0.0;
+
+	/** World time at which the current speech is done */
+	double EndTime = 0.0;
+
+	/** How much of the bark is played out */
+	EDialogueLOD LOD = EDialogueLOD::Full;
+
+	/** How many more speeches the bark may follow on to */
+	int32 ChainRemaining = 0;
+
+	/** Whether spoken nodes are marked visited */
+	bool bMarkVisited = false;
+};
+
+/**
+* Plays barks: ambient one-liners spoken straight from a dialogue's speech
+* nodes, without a controller, display or node traversal. Any number of
+* speakers may bark at once. A bark speaks a single speech node, optionally
+* followed by the auto-transition speeches after it that share its speaker.
+* Events, options and text display are left out; listen to OnBark to show
+* bark text in the world. Barks far enough from the listener run virtually,
+* keeping their timing without playing audio or broadcasting.
+*/
+UCLASS()
+class DIALOGUETREERUNTIME_API UDialogueBarkSubsystem :
+	public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem Impl. */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** End UTickableWorldSubsystem */
+
+	/**
+	* Has the speaker bark the given speech node. Replaces any bark the
+	* speaker is already playing. Speakers engaged in a conversation or on
+	* cooldown do not bark, and recently spoken lines are not repeated.
+	*
+	* @param InDialogue - UDialogue*, the dialogue holding the speech.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @param InNodeID - FName, the speech node. If none, the first node
+	* after the dialogue's entry is used.
+	* @param bFollowAutoTransitions - bool, whether to continue on through
+	* auto-transition speeches by the same speaker.
+	* @param bMarkVisited - bool, whether to record spoken nodes as visited.
+	* @return bool - True if the bark started.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool PlayBark(UDialogue* InDialogue, UDialogueSpeakerComponent* InSpeaker,
+		FName InNodeID = NAME_None, bool bFollowAutoTransitions = false,
+		bool bMarkVisited = false);
+
+	/**
+	* Has the speaker bark the best response to a situation, as chosen by
+	* the given response database. The query's speaker name defaults to
+	* the speaker's dialogue name. Recently spoken lines are passed over.
+	*
+	* @param InDatabase - UDialogueResponseDatabase*, the responses.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @param InQuery - FDialogueResponseQuery, the situation.
+	* @return bool - True if a response was found and the bark started.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool PlayResponse(UDialogueResponseDatabase* InDatabase,
+		UDialogueSpeakerComponent* InSpeaker, FDialogueResponseQuery InQuery);
+
+	/**
+	* Stops any bark the speaker is playing.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void StopBark(UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Checks whether the speaker is barking.
+	*
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the speaker.
+	* @return bool - True if the speaker is barking.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Dialogue")
+	bool IsBarking(const UDialogueSpeakerComponent* InSpeaker) const;
+
+private:
+	/**
+	* Speaks the given node as part of a bark. The bark is not touched
+	* once listeners have been called, as they may start or stop barks.
+	*
+	* @param InBarkIndex - int32, the index of the bark.
+	* @param InNode - UDialogueSpeechNode*, the speech.
+	*/
+	void SpeakNode(int32 InBarkIndex, UDialogueSpeechNode* InNode);
+
+	/**
+	* Plays out a bark's speech: its audio, speaker tags and broadcasts.
+	* Takes the speaker and speech rather than the bark, which listeners
+	* may end.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @param InNode - const UDialogueSpeechNode*, the speech.
+	* @param InStartTime - float, seconds into the speech to start from.
+	*/
+	void PresentNode(UDialogueSpeakerComponent* InSpeaker,
+		const UDialogueSpeechNode* InNode, float InStartTime);
+
+	/**
+	* Moves a bark to the LOD its distance calls for, picking its speech up
+	* or silencing it mid-line as needed.
+	*
+	* @param InBarkIndex - int32, the index of the bark.
+	* @param InLODSubsystem - const UDialogueLODSubsystem*, picks the LOD.
+	*/
+	void UpdateLOD(int32 InBarkIndex,
+		const UDialogueLODSubsystem* InLODSubsystem);
+
+	/**
+	* Finds the speech a bark moves on to after its current one.
+	*
+	* @param InBark - const FDialogueBark&, the bark.
+	* @return UDialogueSpeechNode* - the next speech, nullptr if done.
+	*/
+	UDialogueSpeechNode* GetNextNode(const FDialogueBark& InBark) const;
+
+	/**
+	* Finds the bark the speaker is playing.
+	*
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the speaker.
+	* @return int32 - the index of the bark, INDEX_NONE if none.
+	*/
+	int32 FindBark(const UDialogueSpeakerComponent* InSpeaker) const;
+
+	/**
+	* Ends a bark, clearing its speaker's tags. While ticking, the bark is
+	* only emptied, and removed at the end of the tick.
+	*
+	* @param InBarkIndex - int32, the index of the bark.
+	*/
+	void EndBark(int32 InBarkIndex);
+
+	/**
+	* Gets the controller keeping the dialogue records barks are noted in.
+	*
+	* @return ADialogueController* - the controller, nullptr if none.
+	*/
+	ADialogueController* GetRecordController() const;
+
+public:
+	/** Broadcast whenever a speaker speaks a line of a bark */
+	UPROPERTY(BlueprintAssignable, Category = "Dialogue")
+	FDialogueBarkSignature OnBark;
+
+	/** Native version of OnBark */
+	FDialogueBarkNativeSignature OnBarkNative;
+
+	/** The longest run of speeches a single bark will follow */
+	static const int32 MAX_BARK_CHAIN;
+
+private:
+	/** Barks in progress */
+	TArray<FDialogueBark> ActiveBarks;
+
+	/** Whether barks are being ticked, deferring their removal */
+	bool bTickingBarks = false;
+};
@@ -7,15 +7,20 @@
 #include "GameFramework/Actor.h"
 //Plugin
 #include "Dialogue.h"
+#include "DialogueTimingWheel.h"
+#include "DialogueVariables.h"
 //Generated
 #include "DialogueController.generated.h"
 
+class IDialogueTextArgumentProvider;
 class UDialogue;
 class UDialogueSpeakerComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDialogueControllerDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
 	FDialogueControllerSpeechDelegate, FSpeechDetails, SpeechDetails);
+DECLARE_MULTICAST_DELEGATE_OneParam(
+	FDialogueControllerSpeechNativeDelegate, const FSpeechDetails&);
 
 /**
 * Struct used to extract node visited data for a single dialogue.
@@ -35,6 +40,32 @@ struct FDialogueNodeVisits
 
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
 	FName ResumeNodeID = NAME_None;
+
+	/** The dialogue's most recently spoken lines, oldest first */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	TArray<FName> RecentNodeIDs;
+};
+
+/**
+* Struct used to extract a cooldown that was still running. Primarily 
+* useful for saving/loading.
+*/
+USTRUCT(BlueprintType)
+struct FDialogueCooldownRecord
+{
+	GENERATED_BODY()
+
+	/** The dialogue of the line cooling down. None for a speaker. */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FName DialogueFName;
+
+	/** The line's node ID, or the speaker's dialogue name */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FName ID;
+
+	/** Seconds of the cooldown left to run */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	float RemainingTime = 0.f;
 };
 
 /**
@@ -49,6 +80,14 @@ struct FDialogueRecords
 	/** Map of dialogue FNames to their records of visited nodes */
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
 	TMap<FName, FDialogueNodeVisits> Records;
+
+	/** Line and speaker cooldowns which had yet to run out */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	TArray<FDialogueCooldownRecord> Cooldowns;
+
+	/** Dialogue variables holding anything other than their defaults */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	TArray<FDialogueVariableRecord> Variables;
 };
 
 /**
@@ -242,6 +281,203 @@ public:
 	bool WasNodeVisited(const UDialogue* TargetDialogue,
 		FName TargetNodeID) const;
 
+	/**
+	* Records that a line was spoken, remembering it among the dialogue's 
+	* recent lines and starting its cooldown.
+	*
+	* @param TargetDialogue - UDialogue*, the dialogue holding the line.
+	* @param TargetNodeID - FName, the line's node ID.
+	* @param InCooldown - float, seconds before the line may be repeated.
+	*/
+	void MarkLineSpoken(UDialogue* TargetDialogue, FName TargetNodeID,
+		float InCooldown);
+
+	/**
+	* Checks whether a line is still cooling down.
+	*
+	* @param TargetDialogue - const UDialogue*, the dialogue holding the line.
+	* @param TargetNodeID - FName, the line's node ID.
+	* @return bool - True if the line is on cooldown.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool IsLineOnCooldown(const UDialogue* TargetDialogue, 
+		FName TargetNodeID) const;
+
+	/**
+	* Checks whether a line should be avoided for now: either it is cooling
+	* down, or it is among the dialogue's most recently spoken lines.
+	*
+	* @param TargetDialogue - const UDialogue*, the dialogue holding the line.
+	* @param TargetNodeID - FName, the line's node ID.
+	* @return bool - True if the line was spoken recently.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool WasLineSpokenRecently(const UDialogue* TargetDialogue,
+		FName TargetNodeID) const;
+
+	/**
+	* Puts a speaker on cooldown. Speakers are tracked by dialogue name, so
+	* speakers sharing a name share a cooldown.
+	*
+	* @param InSpeakerName - FName, the speaker's dialogue name.
+	* @param InCooldown - float, seconds the cooldown lasts.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void StartSpeakerCooldown(FName InSpeakerName, float InCooldown);
+
+	/**
+	* Checks whether a speaker is still cooling down.
+	*
+	* @param InSpeakerName - FName, the speaker's dialogue name.
+	* @return bool - True if the speaker is on cooldown.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool IsSpeakerOnCooldown(FName InSpeakerName) const;
+
+	/**
+	* Drops every cooldown which has run out by now. Called each frame by
+	* the bark subsystem, so that expired cooldowns are released even
+	* while no new ones are started.
+	*/
+	void AdvanceCooldowns();
+
+	/**
+	* Gets the dialogue variables read and written by conditions and events.
+	*
+	* @return FDialogueVariableStore& - the variables.
+	*/
+	FDialogueVariableStore& GetVariables();
+
+	/**
+	* Gets a bool dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @return bool - the value, false if never set.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dialogue")
+	bool GetVariableBool(EDialogueVariableScope InScope, FName InOwner,
+		FName InName) const;
+
+	/**
+	* Sets a bool dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @param InValue - bool, the value.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetVariableBool(EDialogueVariableScope InScope, FName InOwner,
+		FName InName, bool InValue);
+
+	/**
+	* Gets a int dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @return int32 - the value, 0 if never set.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dialogue")
+	int32 GetVariableInt(EDialogueVariableScope InScope, FName InOwner,
+		FName InName) const;
+
+	/**
+	* Sets a int dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @param InValue - int32, the value.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetVariableInt(EDialogueVariableScope InScope, FName InOwner,
+		FName InName, int32 InValue);
+
+	/**
+	* Gets a float dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @return float - the value, 0 if never set.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dialogue")
+	float GetVariableFloat(EDialogueVariableScope InScope, FName InOwner,
+		FName InName) const;
+
+	/**
+	* Sets a float dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @param InValue - float, the value.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetVariableFloat(EDialogueVariableScope InScope, FName InOwner,
+		FName InName, float InValue);
+
+	/**
+	* Gets a name dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @return FName - the value, none if never set.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dialogue")
+	FName GetVariableName(EDialogueVariableScope InScope, FName InOwner,
+		FName InName) const;
+
+	/**
+	* Sets a name dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @param InValue - FName, the value.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetVariableName(EDialogueVariableScope InScope, FName InOwner,
+		FName InName, FName InValue);
+
+	/**
+	* Gets a tag dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @return FGameplayTag - the value, empty if never set.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Dialogue")
+	FGameplayTag GetVariableTag(EDialogueVariableScope InScope, FName InOwner,
+		FName InName) const;
+
+	/**
+	* Sets a tag dialogue variable.
+	*
+	* @param InScope - EDialogueVariableScope, who the variable belongs to.
+	* @param InOwner - FName, the dialogue FName or speaker dialogue name
+	* owning the variable. Ignored for globals.
+	* @param InName - FName, the variable's name.
+	* @param InValue - FGameplayTag, the value.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetVariableTag(EDialogueVariableScope InScope, FName InOwner,
+		FName InName, FGameplayTag InValue);
+
 	/**
 	* Sets the resume node for the target dialogue to the target node. Called
 	* from the dialogue.
@@ -251,6 +487,66 @@ public:
 	*/
 	void SetResumeNode(UDialogue* InDialogue, FName InNodeID);
 
+	/**
+	* Sets the object which supplies named arguments for formatted speech 
+	* text. The object must implement IDialogueTextArgumentProvider. 
+	* BlueprintCallable.
+	*
+	* @param InProvider - UObject*, the provider, or nullptr to clear it.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void SetTextArgumentProvider(UObject* InProvider);
+
+	/**
+	* Retrieves the provider of formatted speech arguments. Falls back to
+	* the controller itself if it implements the interface.
+	*
+	* @return const IDialogueTextArgumentProvider* - the provider, nullptr 
+	* if none.
+	*/
+	const IDialogueTextArgumentProvider* GetTextArgumentProvider() const;
+
+	/**
+	* Native entry point for displaying a speech. Notifies native listeners
+	* with a reference to the details, then copies them out to the 
+	* Blueprint DisplaySpeech event and OnDialogueSpeechDisplayed only if 
+	* those are implemented or bound. Native controllers may override this
+	* to read the details in place. 
+	*
+	* @param InSpeechDetails - const FSpeechDetails&, the speech.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	virtual void NativeDisplaySpeech(const FSpeechDetails& InSpeechDetails,
+		UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Native entry point for displaying options. The view is only valid 
+	* for the duration of the call. Gathers the option details into a 
+	* buffer reused for the whole conversation and passes it to the 
+	* Blueprint DisplayOptions event, but only if it is implemented. Native
+	* controllers may override this to read the options in place. 
+	*
+	* @param InOptions - TConstArrayView<FDialogueOption>, the options.
+	*/
+	virtual void NativeDisplayOptions(
+		TConstArrayView<FDialogueOption> InOptions);
+
+private:
+	/**
+	* Starts or restarts a cooldown.
+	*
+	* @param InKey - const FDialogueCooldownKey&, what is cooling down.
+	* @param InCooldown - float, seconds the cooldown lasts.
+	*/
+	void StartCooldown(const FDialogueCooldownKey& InKey, float InCooldown);
+
+	/**
+	* Gets the current world time in cooldown ticks.
+	*
+	* @return uint64 - the current tick.
+	*/
+	uint64 GetCooldownTick() const;
+
 public:
 	/**
 	* Opens the user-defined dialogue display.
@@ -317,6 +613,23 @@ private:
 	/** Controller's memory of visited nodes */
 	FDialogueRecords DialogueRecords;
 
+	/**
+	* Running line and speaker cooldowns. Mutable so that exporting the
+	* records can drop those which have run out.
+	*/
+	mutable FDialogueTimingWheel Cooldowns;
+
+	/** Global, per-dialogue and per-speaker variables */
+	FDialogueVariableStore Variables;
+
+	/** Supplies arguments for formatted speech text */
+	UPROPERTY()
+	TObjectPtr<UObject> TextArgumentProvider = nullptr;
+
+	/** Option details handed to Blueprint, reused between menus */
+	UPROPERTY(Transient)
+	TArray<FSpeechDetails> OptionDetailsBuffer;
+
 public:
 	/** Delegate event call for when a new dialogue is started.*/
 	UPROPERTY(BlueprintAssignable, Category = "Dialogue")
@@ -329,4 +642,11 @@ public:
 	/** Delegate event call for when a speech plays.*/
 	UPROPERTY(BlueprintAssignable, Category = "Dialogue")
 	FDialogueControllerSpeechDelegate OnDialogueSpeechDisplayed;
+
+	/** Native delegate call for when a speech plays, passing a reference 
+	* rather than a copy */
+	FDialogueControllerSpeechNativeDelegate OnDialogueSpeechDisplayedNative;
+
+	/** Length of a cooldown tick, in seconds */
+	static const double COOLDOWN_TICK_LENGTH;
 };
@@ -0,0 +1,337 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+//Plugin
+#include "SpeechDetails.h"
+//Generated
+#include "DialogueCrowdSubsystem.generated.h"
+
+class UDialogue;
+class UDialogueSpeakerComponent;
+class UDialogueSpeechNode;
+
+/** Delegate used to pass data about crowd lines spoken by bound speakers */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FDialogueCrowdSpeechSignature,
+	UDialogueSpeakerComponent*,
+	InSpeaker,
+	FSpeechDetails,
+	InSpeechDetails
+);
+
+/** Native counterpart of the above, passing a reference rather than a copy */
+DECLARE_MULTICAST_DELEGATE_TwoParams(
+	FDialogueCrowdSpeechNativeSignature,
+	UDialogueSpeakerComponent*,
+	const FSpeechDetails&
+);
+
+/**
+* Identifies a crowd conversation. Plain data, so it can be held by
+* whatever drives the crowd agents taking part.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGUETREERUNTIME_API FDialogueCrowdHandle
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	* Checks whether the handle was ever given a conversation. The
+	* conversation may since have ended.
+	*
+	* @return bool - True if the handle is set.
+	*/
+	bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	/** Index of the conversation in the crowd subsystem */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** Tells apart conversations which have used the same index */
+	UPROPERTY()
+	int32 Serial = 0;
+};
+
+/**
+* A dialogue's speeches compiled for crowd playback. Each line is a speech
+* node, found by index, alongside the role speaking it, how long it runs
+* and the line following it.
+*/
+struct FDialogueCrowdScript
+{
+	/** The dialogue compiled */
+	TWeakObjectPtr<UDialogue> Dialogue;
+
+	/** Key of the dialogue in the script cache */
+	FObjectKey DialogueKey;
+
+	/** The dialogue's compile serial when it was compiled */
+	uint32 CompileSerial = 0;
+
+	/** Number of conversations playing the script */
+	int32 NumConversations = 0;
+
+	/** The speech node behind each line */
+	TArray<TWeakObjectPtr<UDialogueSpeechNode>> Nodes;
+
+	/** The speaker slot speaking each line */
+	TArray<int32> SpeakerSlots;
+
+	/** How long each line runs, in seconds */
+	TArray<float> Durations;
+
+	/** The line following each line, INDEX_NONE if the conversation ends */
+	TArray<int32> NextLines;
+
+	/** Lines by node ID */
+	TMap<FName, int32> LineIndices;
+};
+
+/**
+* A crowd conversation in progress.
+*/
+struct FDialogueCrowdConversation
+{
+	/** The compiled script being played */
+	int32 Script = INDEX_NONE;
+
+	/** The line being spoken */
+	int32 Line = INDEX_NONE;
+
+	/** World time at which the current line started */
+	double LineStartTime = 0.0;
+
+	/** Matches the handle given out for the conversation */
+	int32 Serial = 0;
+
+	/** Speakers standing in for each speaker slot. Only agents promoted to
+	* actors have one. */
+	TArray<TWeakObjectPtr<UDialogueSpeakerComponent>, TInlineAllocator<4>>
+		BoundSpeakers;
+};
+
+/**
+* When a crowd conversation's current line runs out.
+*/
+struct FDialogueCrowdDeadline
+{
+	/** World time at which the line runs out */
+	double Deadline = 0.0;
+
+	/** Index of the conversation */
+	int32 Index = INDEX_NONE;
+
+	/** Serial of the conversation */
+	int32 Serial = 0;
+
+	/** Orders the deadline heap soonest first */
+	bool operator<(const FDialogueCrowdDeadline& Other) const
+	{
+		return Deadline < Other.Deadline;
+	}
+};
+
+/**
+* Plays ambient conversations between crowd agents which have no speaker
+* components of their own. Dialogues are compiled down to flat arrays of
+* lines, and each conversation is reduced to a script, a line index and a
+* deadline, so thousands can run at once; every tick advances all
+* conversations whose lines have run out together. Scripts are dropped
+* once their dialogue is destroyed or recompiled. There is no display,
+* events or player input. Agents promoted to actors can bind their speaker
+* to a role, which then plays that role's audio, tags and OnCrowdSpeech
+* broadcasts, picking up part way through a line if need be. Mass agents
+* are handled by the optional DialogueTree Mass companion plugin.
+*/
+UCLASS()
+class DIALOGUETREERUNTIME_API UDialogueCrowdSubsystem :
+	public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem Impl. */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** End UTickableWorldSubsystem */
+
+	/**
+	* Moves on every conversation whose line has run out. Done once a
+	* frame, from the subsystem's tick or whatever drives the crowd,
+	* whichever comes first.
+	*/
+	void AdvanceConversations();
+
+	/**
+	* Starts a crowd conversation.
+	*
+	* @param InDialogue - UDialogue*, the dialogue to play.
+	* @param InNodeID - FName, the speech node to start at. If none, the
+	* first node after the dialogue's entry is used.
+	* @return FDialogueCrowdHandle - the conversation, unset if it could
+	* not be started.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	FDialogueCrowdHandle StartConversation(UDialogue* InDialogue,
+		FName InNodeID = NAME_None);
+
+	/**
+	* Ends a crowd conversation early, silencing any bound speakers.
+	*
+	* @param InHandle - FDialogueCrowdHandle, the conversation.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void StopConversation(FDialogueCrowdHandle InHandle);
+
+	/**
+	* Checks whether a crowd conversation is still going.
+	*
+	* @param InHandle - FDialogueCrowdHandle, the conversation.
+	* @return bool - True if the conversation is going.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Dialogue")
+	bool IsConversationActive(FDialogueCrowdHandle InHandle) const;
+
+	/**
+	* Gets the role speaking a crowd conversation's current line.
+	*
+	* @param InHandle - FDialogueCrowdHandle, the conversation.
+	* @return FName - the speaker role, none if the conversation is over.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Dialogue")
+	FName GetSpeakingRole(FDialogueCrowdHandle InHandle) const;
+
+	/**
+	* Has a speaker stand in for a role of a crowd conversation. If the
+	* role is speaking, the speaker picks up the line where it is.
+	*
+	* @param InHandle - FDialogueCrowdHandle, the conversation.
+	* @param InRole - FName, the speaker role.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @return bool - True if the speaker was bound.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool BindSpeaker(FDialogueCrowdHandle InHandle, FName InRole,
+		UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Stops a speaker standing in for a role of a crowd conversation,
+	* silencing it. The role carries on unheard.
+	*
+	* @param InHandle - FDialogueCrowdHandle, the conversation.
+	* @param InRole - FName, the speaker role.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void UnbindSpeaker(FDialogueCrowdHandle InHandle, FName InRole);
+
+private:
+	/**
+	* Gets the compiled script for a dialogue, compiling it on first use.
+	*
+	* @param InDialogue - UDialogue*, the dialogue.
+	* @return int32 - the index of the script.
+	*/
+	int32 FindOrCompileScript(UDialogue* InDialogue);
+
+	/**
+	* Checks whether a script's dialogue has since been destroyed or
+	* recompiled.
+	*
+	* @param InScript - const FDialogueCrowdScript&, the script.
+	* @return bool - True if the script is out of date.
+	*/
+	static bool IsScriptStale(const FDialogueCrowdScript& InScript);
+
+	/**
+	* Drops a script from the cache, freeing it once no conversation is
+	* playing it.
+	*
+	* @param InScriptIndex - int32, the index of the script.
+	*/
+	void EvictScript(int32 InScriptIndex);
+
+	/**
+	* Drops every out of date script from the cache.
+	*/
+	void EvictStaleScripts();
+
+	/**
+	* Finds the conversation a handle refers to.
+	*
+	* @param InHandle - const FDialogueCrowdHandle&, the handle.
+	* @return FDialogueCrowdConversation* - the conversation, nullptr if it
+	* has ended.
+	*/
+	FDialogueCrowdConversation* FindConversation(
+		const FDialogueCrowdHandle& InHandle);
+	const FDialogueCrowdConversation* FindConversation(
+		const FDialogueCrowdHandle& InHandle) const;
+
+	/**
+	* Starts a conversation's line, scheduling its end and playing it
+	* through the speaker bound to its role, if any.
+	*
+	* @param InIndex - int32, the index of the conversation.
+	* @param InLine - int32, the line.
+	*/
+	void StartLine(int32 InIndex, int32 InLine);
+
+	/**
+	* Plays a conversation's current line through a bound speaker: its
+	* audio, tags and broadcasts.
+	*
+	* @param InConversation - const FDialogueCrowdConversation&, the
+	* conversation.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @param InStartTime - float, seconds into the line to start from.
+	*/
+	void PresentLine(const FDialogueCrowdConversation& InConversation,
+		UDialogueSpeakerComponent* InSpeaker, float InStartTime);
+
+	/**
+	* Ends a conversation, silencing any bound speakers.
+	*
+	* @param InIndex - int32, the index of the conversation.
+	*/
+	void EndConversation(int32 InIndex);
+
+public:
+	/** Broadcast whenever a bound speaker speaks a crowd line */
+	UPROPERTY(BlueprintAssignable, Category = "Dialogue")
+	FDialogueCrowdSpeechSignature OnCrowdSpeech;
+
+	/** Native version of OnCrowdSpeech */
+	FDialogueCrowdSpeechNativeSignature OnCrowdSpeechNative;
+
+private:
+	/** Compiled scripts. Evicted scripts stay until their conversations
+	* end. */
+	TSparseArray<FDialogueCrowdScript> Scripts;
+
+	/** Cached scripts by dialogue */
+	TMap<FObjectKey, int32> ScriptIndices;
+
+	/** Conversations in progress */
+	TSparseArray<FDialogueCrowdConversation> Conversations;
+
+	/** When each conversation's line runs out, soonest first */
+	TArray<FDialogueCrowdDeadline> Deadlines;
+
+	/** Scratch space for advancing a tick's worth of conversations */
+	TArray<FDialogueCrowdDeadline> ReadyConversations;
+
+	/** Serial given to the next conversation started */
+	int32 NextSerial = 1;
+
+	/** The frame conversations were last advanced on */
+	uint64 LastAdvancedFrame = 0;
+};
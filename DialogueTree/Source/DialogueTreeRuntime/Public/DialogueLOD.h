@@ -0,0 +1,26 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+//Generated
+#include "DialogueLOD.generated.h"
+
+/**
+* Enum defining how much of a conversation is played out, based on how far
+* its speakers are from the listener.
+*/
+UENUM(BlueprintType)
+enum class EDialogueLOD : uint8
+{
+	/** Everything plays */
+	Full,
+
+	/** Audio and display play, but cosmetic events are skipped */
+	Reduced,
+
+	/** Only timing runs: no audio, display, speaker tags or cosmetic
+	* events */
+	Virtual
+};
@@ -0,0 +1,84 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+//Plugin
+#include "DialogueLOD.h"
+//Generated
+#include "DialogueLODSubsystem.generated.h"
+
+class UDialogue;
+
+/**
+* Picks how much of each conversation to play out from its distance to the
+* listener, so that conversations far from the player stay cheap. Playing
+* conversations are re-evaluated every frame and moved between levels as
+* their speakers or the listener move, mid-line if need be. Barks consult
+* the same distances. Does nothing unless conversation LOD is enabled in
+* the settings.
+*/
+UCLASS()
+class DIALOGUETREERUNTIME_API UDialogueLODSubsystem :
+	public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem Impl. */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** End UTickableWorldSubsystem */
+
+	/**
+	* Picks the LOD for a speaker at the given location. A level already
+	* reached holds on a little past its boundary, so that speakers near
+	* one do not flicker between levels.
+	*
+	* @param InLocation - const FVector&, where the speaker is.
+	* @param InCurrentLOD - EDialogueLOD, the speaker's current level.
+	* @return EDialogueLOD - the level to use. Full if LOD is disabled or
+	* there is no listener.
+	*/
+	EDialogueLOD GetLODAt(const FVector& InLocation,
+		EDialogueLOD InCurrentLOD) const;
+
+	/**
+	* Picks the LOD for a playing dialogue from its nearest speaker.
+	*
+	* @param InDialogue - const UDialogue*, the dialogue.
+	* @return EDialogueLOD - the level to use.
+	*/
+	EDialogueLOD GetDialogueLOD(const UDialogue* InDialogue) const;
+
+	/**
+	* Starts keeping a playing dialogue's LOD up to date.
+	*
+	* @param InDialogue - UDialogue*, the dialogue.
+	*/
+	void RegisterDialogue(UDialogue* InDialogue);
+
+	/**
+	* Stops keeping a dialogue's LOD up to date.
+	*
+	* @param InDialogue - UDialogue*, the dialogue.
+	*/
+	void UnregisterDialogue(UDialogue* InDialogue);
+
+public:
+	/** How far past a boundary a level holds on, as a fraction of the
+	* boundary's distance */
+	static const float LOD_HYSTERESIS;
+
+private:
+	/** Dialogues being kept up to date */
+	TArray<TWeakObjectPtr<UDialogue>> Dialogues;
+
+	/** Where the listener was as of this frame */
+	FVector ListenerLocation = FVector::ZeroVector;
+
+	/** Whether there was a listener this frame */
+	bool bHasListener = false;
+};
@@ -130,4 +130,64 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly,
 		Category = "DefaultController")
 	bool AllowGameInputInDialogue = true;
+
+	/** 
+	* Whether speech text and option lock messages are compiled into a 
+	* string table owned by each dialogue. Nodes then store only the entry 
+	* key and resolve their text when it is displayed, rather than holding 
+	* a full copy of every text. Text keeps its localization namespace and 
+	* key, so existing translations still apply; text from a different 
+	* namespace than the rest of the dialogue stays inline. Takes effect 
+	* when a dialogue is next compiled.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, 
+		Category = "Localization")
+	bool CompileTextToStringTables = false;
+
+	/**
+	* Whether speech audio is played through a shared pool of voice 
+	* channels rather than each speaker's own audio. Speakers then only 
+	* hold a channel while speaking, which keeps mixer load down in 
+	* crowded scenes. 
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Voice")
+	bool PoolSpeechAudio = false;
+
+	/** The most speeches that can play at once when pooling speech audio */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Voice",
+		meta = (ClampMin = 1, EditCondition = "PoolSpeechAudio"))
+	int32 MaxVoiceChannels = 8;
+
+	/** Speeches further than this from the listener are not played when 
+	* pooling speech audio. Zero or less disables culling. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Voice",
+		meta = (EditCondition = "PoolSpeechAudio"))
+	float VoiceCullDistance = 0.f;
+
+	/** How many of each dialogue's most recently spoken lines are 
+	* remembered, so that barks and responses avoid repeating them. Zero 
+	* disables the memory. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, 
+		Category = "Repetition", meta = (ClampMin = 0))
+	int32 RecentLineMemory = 0;
+
+	/**
+	* Whether conversations and barks play out in less detail the further
+	* they are from the listener. Beyond the reduced distance, cosmetic
+	* events are skipped; beyond the virtual distance, speech runs on
+	* timing alone, without audio, display or speaker tags.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "LOD")
+	bool UseConversationLOD = false;
+
+	/** Distance from the listener beyond which cosmetic events are
+	* skipped */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "LOD",
+		meta = (ClampMin = 0, EditCondition = "UseConversationLOD"))
+	float LODReducedDistance = 1500.f;
+
+	/** Distance from the listener beyond which speech runs virtually */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "LOD",
+		meta = (ClampMin = 0, EditCondition = "UseConversationLOD"))
+	float LODVirtualDistance = 4000.f;
 };
@@ -29,6 +29,16 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
 	InSpeechDetails
 );
 
+/** Native counterparts of the above, passing references rather than copies */
+DECLARE_MULTICAST_DELEGATE_OneParam(
+	FOnDialogueGameplayTagsChangedNative,
+	const FGameplayTagContainer&
+);
+DECLARE_MULTICAST_DELEGATE_OneParam(
+	FSpeakerSpeechNativeSignature,
+	const FSpeechDetails&
+);
+
 /**
 * Helper struct used to condense a speaker component and the actor which owns
 * it into a single parameter value for easier access. 
@@ -151,13 +161,49 @@ public:
 	virtual void PlaySpeechAudioClip_Implementation(
 		USoundBase* InAudio);
 
+	/**
+	* Plays the given audio clip from part way through. Used to pick speech
+	* back up when a conversation comes close enough to be heard again.
+	* Starting from the beginning defers to PlaySpeechAudioClip.
+	*
+	* @param InAudio - USoundBase*, the audio clip.
+	* @param InStartTime - float, seconds into the clip to start from.
+	*/
+	void PlaySpeechAudioFrom(USoundBase* InAudio, float InStartTime);
+
+	/**
+	* Speaks the given speech from part way through: replaces whatever
+	* audio is playing with the speech's, unless that would already be
+	* over, and takes on its gameplay tags.
+	*
+	* @param InDetails - const FSpeechDetails&, the speech.
+	* @param InStartTime - float, seconds into the speech to start from.
+	*/
+	void PlaySpeechFrom(const FSpeechDetails& InDetails, float InStartTime);
+
+	/**
+	* Stops any speech audio the speaker is playing, whether through its 
+	* own audio or a pooled voice channel. 
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	void StopSpeechAudio();
+
+	/**
+	* Checks whether the speaker is playing speech audio, whether through 
+	* its own audio or a pooled voice channel. 
+	* 
+	* @return bool - True if speech audio is playing.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Dialogue")
+	bool IsSpeechAudioPlaying() const;
+
 	/**
 	* Changes out the speaker's current gameplay tags to the 
 	* provided set. Primarily meant to be called from dialogue side.
 	* 
-	* @param InTags - FGameplayTagContainer, the new tags to set. 
+	* @param InTags - const FGameplayTagContainer&, the new tags to set. 
 	*/
-	void SetCurrentGameplayTags(FGameplayTagContainer InTags);
+	void SetCurrentGameplayTags(const FGameplayTagContainer& InTags);
 
 	/**
 	* Clears the gameplay tags. 
@@ -281,13 +327,27 @@ public:
 	/**
 	* Notifies subscribers that the given speech was skipped.
 	* 
-	* @param SkippedSpeech - FSpeechDetails, the skipped speech. 
+	* @param SkippedSpeech - const FSpeechDetails&, the skipped speech. 
+	*/
+	void BroadcastSpeechSkipped(const FSpeechDetails& SkippedSpeech);
+
+	/**
+	* Called by the voice subsystem when speech played on the speaker's 
+	* behalf finishes or is cut off. Broadcasts OnAudioFinished as though 
+	* the speaker had played the speech itself. 
 	*/
-	void BroadcastSpeechSkipped(FSpeechDetails SkippedSpeech);
+	void NotifyVoiceFinished();
 
 private:
 	void BroadcastCurrentGameplayTags();
 
+	/**
+	* Passes audio completion on to the transition scheduler. 
+	* 
+	* @param InComponent - UAudioComponent*, the finished component. 
+	*/
+	void OnSpeechAudioFinished(UAudioComponent* InComponent);
+
 protected:
 	/** The name to display for this speaker in dialogue */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
@@ -301,6 +361,16 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
 	TObjectPtr<UDialogue> OwnedDialogue;
 
+	/** How important this speaker's speech is when pooled voice channels 
+	* run out. Higher priority speech cuts off lower priority speech. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	int32 VoicePriority = 0;
+
+	/** Seconds after the speaker speaks before it will bark again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue",
+		meta = (ClampMin = 0))
+	float SpeakerCooldown = 0.f;
+
 	/** Tags associated with a speech in dialogue. Used for animation, etc. 
 	* Set up as maps for ease of access and greater flexibility. */
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue", 
@@ -322,4 +392,10 @@ public:
 	*/
 	UPROPERTY(BlueprintAssignable, Category = "Dialogue")
 	FSpeakerSpeechSignature OnSpeechSkipped;
+
+	/** Native version of OnGameplayTagsChanged */
+	FOnDialogueGameplayTagsChangedNative OnGameplayTagsChangedNative;
+
+	/** Native version of OnSpeechSkipped */
+	FSpeakerSpeechNativeSignature OnSpeechSkippedNative;
 };
@@ -44,6 +44,17 @@ public:
 	class UDialogueSpeakerComponent* GetSpeakerComponent(
 		class UDialogue* InDialogue) const;
 
+	/**
+	* Retrieve the cached speaker and actor entry for this speaker from 
+	* the provided dialogue. The dialogue's slot for the speaker is looked 
+	* up once and reused while it still matches. 
+	* 
+	* @param InDialogue - const UDialogue*, the dialogue. 
+	* @return const FSpeakerActorEntry& - the entry, empty if none found.
+	*/
+	const struct FSpeakerActorEntry& GetSpeakerEntry(
+		const class UDialogue* InDialogue) const;
+
 	/**
 	* Checks to see if the socket's value is valid. 
 	* 
@@ -51,8 +62,21 @@ public:
 	*/
 	bool IsValidSocket() const;
 
+private:
+	/**
+	* Resolves the dialogue's slot for this speaker, reusing the cached 
+	* slot while it still names this speaker.
+	* 
+	* @param InDialogue - const UDialogue*, the dialogue. 
+	* @return int32 - the slot, INDEX_NONE if none.
+	*/
+	int32 ResolveSlot(const class UDialogue* InDialogue) const;
+
 private:
 	/** Name of the speaker */
 	UPROPERTY(EditAnywhere, Category = "Dialogue")
 	FName SpeakerName;
+
+	/** Last slot resolved for the speaker */
+	mutable int32 CachedSlot = INDEX_NONE;
 };
@@ -0,0 +1,37 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+//Generated
+#include "DialogueTextArgumentProvider.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UDialogueTextArgumentProvider : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+* Native interface for objects which supply the named arguments of 
+* formatted speech text, such as {PlayerName} or {Gold}. Set on the dialogue
+* controller, or implemented by the controller itself. 
+*/
+class DIALOGUETREERUNTIME_API IDialogueTextArgumentProvider
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	* Fills in the values of the given arguments. Arguments left unfilled 
+	* are displayed as written in the speech. 
+	* 
+	* @param InArgumentNames - const TArray<FString>&, the arguments the 
+	* speech expects.
+	* @param OutArguments - FFormatNamedArguments&, the argument values.
+	*/
+	virtual void GetTextArguments(const TArray<FString>& InArgumentNames,
+		FFormatNamedArguments& OutArguments) const = 0;
+};
@@ -0,0 +1,163 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+
+/**
+* Identifies something that can be put on cooldown: a line, by its
+* dialogue and node ID, or a speaker, by its dialogue name alone.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueCooldownKey
+{
+	/** The dialogue the line belongs to. None for a speaker. */
+	FName DialogueName;
+
+	/** The line's node ID, or the speaker's dialogue name */
+	FName ID;
+
+	bool operator==(const FDialogueCooldownKey& Other) const
+	{
+		return DialogueName == Other.DialogueName && ID == Other.ID;
+	}
+
+	friend uint32 GetTypeHash(const FDialogueCooldownKey& InKey)
+	{
+		return HashCombine(GetTypeHash(InKey.DialogueName),
+			GetTypeHash(InKey.ID));
+	}
+};
+
+/**
+* Hierarchical timing wheel tracking when cooldowns run out, measured in
+* whole ticks. Each level is a ring of slots, and each slot spans a full
+* turn of the level below. Entries are filed by how far off they are and
+* move down a level as their slot comes round, so starting, cancelling and
+* expiring a cooldown are all constant time. Expired entries are removed
+* outright, leaving nothing behind.
+*/
+class DIALOGUETREERUNTIME_API FDialogueTimingWheel
+{
+public:
+	/** Constructor */
+	FDialogueTimingWheel();
+
+	/**
+	* Starts or restarts the key's cooldown. Expiry ticks which have
+	* already been reached cancel the cooldown instead.
+	*
+	* @param InKey - const FDialogueCooldownKey&, what is cooling down.
+	* @param InExpiryTick - uint64, the tick at which the cooldown ends.
+	*/
+	void Schedule(const FDialogueCooldownKey& InKey, uint64 InExpiryTick);
+
+	/**
+	* Ends the key's cooldown early.
+	*
+	* @param InKey - const FDialogueCooldownKey&, what is cooling down.
+	*/
+	void Cancel(const FDialogueCooldownKey& InKey);
+
+	/**
+	* Moves the wheel on to the given tick, dropping every cooldown that
+	* has ended by then. Empty stretches of the wheel are skipped.
+	*
+	* @param InTick - uint64, the tick to move to.
+	*/
+	void Advance(uint64 InTick);
+
+	/**
+	* Checks whether the key is still cooling down at the given tick.
+	*
+	* @param InKey - const FDialogueCooldownKey&, what is cooling down.
+	* @param InTick - uint64, the tick to check at.
+	* @return bool - True if the cooldown has not yet ended.
+	*/
+	bool IsActive(const FDialogueCooldownKey& InKey, uint64 InTick) const;
+
+	/**
+	* Visits every cooldown being tracked.
+	*
+	* @param InVisitor - TFunctionRef, called with each key and the tick at
+	* which its cooldown ends.
+	*/
+	void ForEach(TFunctionRef<void(const FDialogueCooldownKey&, uint64)>
+		InVisitor) const;
+
+	/**
+	* Drops every cooldown and returns the wheel to tick zero.
+	*/
+	void Reset();
+
+private:
+	/**
+	* Files an entry into the slot matching how far off it is.
+	*
+	* @param InEntryIndex - int32, the entry.
+	*/
+	void Place(int32 InEntryIndex);
+
+	/**
+	* Takes an entry out of its slot.
+	*
+	* @param InEntryIndex - int32, the entry.
+	*/
+	void Unlink(int32 InEntryIndex);
+
+	/**
+	* Refiles the entries of each upper level slot that has come round.
+	* Called as the bottom level completes a turn.
+	*/
+	void Cascade();
+
+	/**
+	* Drops every entry in a bottom level slot.
+	*
+	* @param InSlot - int32, the slot.
+	*/
+	void ExpireSlot(int32 InSlot);
+
+public:
+	/** Number of bits of the tick each level covers */
+	static const int32 SLOT_BITS;
+
+	/** Number of slots in each level */
+	static const int32 NUM_SLOTS;
+
+	/** Number of levels in the wheel */
+	static const int32 NUM_LEVELS;
+
+private:
+	/** A cooldown being tracked */
+	struct FEntry
+	{
+		/** What is cooling down */
+		FDialogueCooldownKey Key;
+
+		/** The tick at which the cooldown ends */
+		uint64 ExpiryTick = 0;
+
+		/** Neighbouring entries in the same slot */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		/** Index of the slot holding the entry, across all levels */
+		int32 SlotIndex = INDEX_NONE;
+	};
+
+	/** Every cooldown being tracked */
+	TSparseArray<FEntry> Entries;
+
+	/** Entries by key */
+	TMap<FDialogueCooldownKey, int32> Lookup;
+
+	/** The first entry in each slot, level by level */
+	TArray<int32> SlotHeads;
+
+	/** For each level, a bit per slot holding any entries */
+	TArray<uint64> OccupiedSlots;
+
+	/** The tick the wheel has been advanced to */
+	uint64 CurrentTick = 0;
+};
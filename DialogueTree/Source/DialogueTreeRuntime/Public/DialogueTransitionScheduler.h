@@ -0,0 +1,148 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+//Generated
+#include "DialogueTransitionScheduler.generated.h"
+
+class UDialogueSpeakerComponent;
+class UDialogueTransition;
+
+/**
+* A transition waiting on its minimum play time, or on when its virtualized
+* audio would have finished.
+*/
+struct FDialogueTransitionDeadline
+{
+	/** World time at which the minimum play time elapses */
+	double Deadline = 0.0;
+
+	/** The waiting transition */
+	TWeakObjectPtr<UDialogueTransition> Transition;
+
+	/** Which wait of the transition the deadline belongs to */
+	uint32 WaitID = 0;
+
+	/** Whether the deadline stands in for the end of the audio */
+	bool bAudio = false;
+
+	/** Orders the deadline heap soonest first */
+	bool operator<(const FDialogueTransitionDeadline& Other) const
+	{
+		return Deadline < Other.Deadline;
+	}
+};
+
+/**
+* A transition waiting on its speaker's audio to finish.
+*/
+struct FDialogueTransitionAudioWait
+{
+	/** The waiting transition */
+	TWeakObjectPtr<UDialogueTransition> Transition;
+
+	/** Which wait of the transition this belongs to */
+	uint32 WaitID = 0;
+};
+
+/**
+* Advances every waiting speech transition in the world once per frame,
+* rather than each transition arming its own timer and binding to its own
+* speaker's audio. Minimum play time deadlines are kept in a min-heap, and
+* speakers push audio completion into a queue drained on the same tick, so
+* the cost of waiting scales with active conversations.
+*/
+UCLASS()
+class DIALOGUETREERUNTIME_API UDialogueTransitionScheduler :
+	public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem Impl. */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** End UTickableWorldSubsystem */
+
+	/**
+	* Lets the transition know once the given time has passed.
+	*
+	* @param InTransition - UDialogueTransition*, the waiting transition.
+	* @param InWaitID - uint32, identifies the transition's current wait.
+	* @param InDelay - float, seconds to wait.
+	*/
+	void ScheduleMinPlayTime(UDialogueTransition* InTransition,
+		uint32 InWaitID, float InDelay);
+
+	/**
+	* Lets the transition know its audio is done once the given time has
+	* passed. Used in place of waiting on the speaker when the audio is not
+	* actually playing.
+	*
+	* @param InTransition - UDialogueTransition*, the waiting transition.
+	* @param InWaitID - uint32, identifies the transition's current wait.
+	* @param InDelay - float, seconds until the audio would have finished.
+	*/
+	void ScheduleAudioEnd(UDialogueTransition* InTransition,
+		uint32 InWaitID, float InDelay);
+
+	/**
+	* Lets the transition know once the speaker's audio finishes. Replaces
+	* any earlier wait on the same speaker.
+	*
+	* @param InTransition - UDialogueTransition*, the waiting transition.
+	* @param InWaitID - uint32, identifies the transition's current wait.
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	void WaitForAudio(UDialogueTransition* InTransition, uint32 InWaitID,
+		UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Stops waiting on the speaker's audio.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	void CancelAudioWait(UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Queues up a speaker's audio completion, to be handled on the next
+	* tick. Called by the speaker.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	void QueueAudioFinished(UDialogueSpeakerComponent* InSpeaker);
+
+private:
+	/**
+	* Adds a deadline to the heap.
+	*
+	* @param InTransition - UDialogueTransition*, the waiting transition.
+	* @param InWaitID - uint32, identifies the transition's current wait.
+	* @param InDelay - float, seconds until the deadline.
+	* @param bInAudio - bool, whether the deadline ends the audio.
+	*/
+	void PushDeadline(UDialogueTransition* InTransition, uint32 InWaitID,
+		float InDelay, bool bInAudio);
+
+private:
+	/** Deadlines, ordered soonest first */
+	TArray<FDialogueTransitionDeadline> Deadlines;
+
+	/** Transitions waiting on audio, by speaker */
+	TMap<TWeakObjectPtr<UDialogueSpeakerComponent>,
+		FDialogueTransitionAudioWait> AudioWaits;
+
+	/** Speakers whose audio finished since the last tick */
+	TArray<TWeakObjectPtr<UDialogueSpeakerComponent>> FinishedSpeakers;
+
+	/** Scratch space for dispatching a tick's worth of transitions whose
+	* audio is done */
+	TArray<FDialogueTransitionAudioWait> ReadyAudio;
+
+	/** Scratch space for dispatching a tick's worth of transitions whose
+	* minimum play time is up */
+	TArray<FDialogueTransitionAudioWait> ReadyMinPlayTime;
+};
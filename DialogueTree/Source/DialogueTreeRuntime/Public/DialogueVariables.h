@@ -0,0 +1,326 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+//Generated
+#include "DialogueVariables.generated.h"
+
+class UDialogue;
+class UDialogueSpeakerSocket;
+
+/**
+* Enum for who a dialogue variable belongs to.
+*/
+UENUM(BlueprintType)
+enum class EDialogueVariableScope : uint8
+{
+	Global,
+	Dialogue,
+	Speaker
+};
+
+/**
+* Enum for the kind of value a dialogue variable holds.
+*/
+UENUM(BlueprintType)
+enum class EDialogueVariableType : uint8
+{
+	Bool,
+	Int,
+	Float,
+	Name,
+	Tag
+};
+
+/**
+* Struct used to extract a single dialogue variable. Only the value matching
+* the variable's type is used. Primarily useful for saving/loading.
+*/
+USTRUCT(BlueprintType)
+struct FDialogueVariableRecord
+{
+	GENERATED_BODY()
+
+	/** Who the variable belongs to */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	EDialogueVariableScope Scope = EDialogueVariableScope::Global;
+
+	/** The dialogue FName or speaker dialogue name owning the variable.
+	* None for globals. */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FName Owner;
+
+	/** The variable's name */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FName Name;
+
+	/** The kind of value held */
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	EDialogueVariableType Type = EDialogueVariableType::Bool;
+
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	bool BoolValue = false;
+
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	int32 IntValue = 0;
+
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	float FloatValue = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FName NameValue;
+
+	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Dialogue")
+	FGameplayTag TagValue;
+};
+
+/**
+* Hands out slot indices for dialogue variable names, numbering each type
+* separately, so that reading a variable at runtime is a plain array
+* index. Names are resolved once, as the conditions and events using them
+* are loaded or edited. Safe to use from any thread.
+*/
+class DIALOGUETREERUNTIME_API FDialogueVariableRegistry
+{
+public:
+	/**
+	* Gets the registry.
+	*
+	* @return FDialogueVariableRegistry& - the registry.
+	*/
+	static FDialogueVariableRegistry& Get();
+
+	/**
+	* Gets the slot for a variable name, handing out a new one the first
+	* time the name is seen.
+	*
+	* @param InType - EDialogueVariableType, the variable's type.
+	* @param InName - FName, the variable's name.
+	* @return int32 - the slot, INDEX_NONE if the name is none.
+	*/
+	int32 GetSlot(EDialogueVariableType InType, FName InName);
+
+	/**
+	* Finds the slot for a variable name without handing out a new one.
+	*
+	* @param InType - EDialogueVariableType, the variable's type.
+	* @param InName - FName, the variable's name.
+	* @return int32 - the slot, INDEX_NONE if the name has never been seen.
+	*/
+	int32 FindSlot(EDialogueVariableType InType, FName InName) const;
+
+	/**
+	* Gets the name a slot was handed out for.
+	*
+	* @param InType - EDialogueVariableType, the variable's type.
+	* @param InSlot - int32, the slot.
+	* @return FName - the variable's name, none if the slot is unused.
+	*/
+	FName GetSlotName(EDialogueVariableType InType, int32 InSlot) const;
+
+public:
+	/** Number of variable types */
+	static const int32 NUM_VARIABLE_TYPES;
+
+private:
+	/** Guards the tables, as assets may load off the game thread */
+	mutable FCriticalSection Lock;
+
+	/** Slots by name, per type */
+	TArray<TMap<FName, int32>> SlotsByName;
+
+	/** Names by slot, per type */
+	TArray<TArray<FName>> SlotNames;
+};
+
+/**
+* The values of every variable belonging to one owner, one array per type,
+* indexed by slot. Variables never set read back as their type's default.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueVariableBlock
+{
+	bool GetBool(int32 InSlot) const;
+	void SetBool(int32 InSlot, bool InValue);
+
+	int32 GetInt(int32 InSlot) const;
+	void SetInt(int32 InSlot, int32 InValue);
+
+	float GetFloat(int32 InSlot) const;
+	void SetFloat(int32 InSlot, float InValue);
+
+	FName GetName(int32 InSlot) const;
+	void SetName(int32 InSlot, FName InValue);
+
+	FGameplayTag GetTag(int32 InSlot) const;
+	void SetTag(int32 InSlot, FGameplayTag InValue);
+
+	TBitArray<> Bools;
+	TArray<int32> Ints;
+	TArray<float> Floats;
+	TArray<FName> Names;
+	TArray<FGameplayTag> Tags;
+};
+
+/**
+* Holds dialogue variables at global, per-dialogue and per-speaker scope.
+* Dialogues are keyed by FName, as with node visits, and speakers by
+* dialogue name, so speakers sharing a name share their variables.
+*/
+class DIALOGUETREERUNTIME_API FDialogueVariableStore
+{
+public:
+	/**
+	* Finds the variables of the given owner.
+	*
+	* @param InScope - EDialogueVariableScope, the scope.
+	* @param InOwner - FName, the owner. Ignored for globals.
+	* @return const FDialogueVariableBlock* - the variables, nullptr if
+	* none have been set.
+	*/
+	const FDialogueVariableBlock* FindBlock(EDialogueVariableScope InScope,
+		FName InOwner) const;
+
+	/**
+	* Finds the variables of the given owner, adding them if need be.
+	*
+	* @param InScope - EDialogueVariableScope, the scope.
+	* @param InOwner - FName, the owner. Ignored for globals.
+	* @return FDialogueVariableBlock& - the variables.
+	*/
+	FDialogueVariableBlock& FindOrAddBlock(EDialogueVariableScope InScope,
+		FName InOwner);
+
+	/**
+	* Writes out every variable holding something other than its default.
+	*
+	* @param OutRecords - TArray<FDialogueVariableRecord>&, added to.
+	*/
+	void ExportRecords(TArray<FDialogueVariableRecord>& OutRecords) const;
+
+	/**
+	* Sets variables from records.
+	*
+	* @param InRecords - const TArray<FDialogueVariableRecord>&, the records.
+	*/
+	void ImportRecords(const TArray<FDialogueVariableRecord>& InRecords);
+
+	/**
+	* Drops every variable.
+	*/
+	void Reset();
+
+private:
+	/**
+	* Writes out the variables of one owner.
+	*
+	* @param InBlock - const FDialogueVariableBlock&, the variables.
+	* @param InScope - EDialogueVariableScope, the scope.
+	* @param InOwner - FName, the owner.
+	* @param OutRecords - TArray<FDialogueVariableRecord>&, added to.
+	*/
+	static void ExportBlock(const FDialogueVariableBlock& InBlock,
+		EDialogueVariableScope InScope, FName InOwner,
+		TArray<FDialogueVariableRecord>& OutRecords);
+
+private:
+	/** Global variables */
+	FDialogueVariableBlock GlobalBlock;
+
+	/** Per-dialogue variables, by dialogue FName */
+	TMap<FName, FDialogueVariableBlock> DialogueBlocks;
+
+	/** Per-speaker variables, by speaker dialogue name */
+	TMap<FName, FDialogueVariableBlock> SpeakerBlocks;
+};
+
+/**
+* A dialogue variable as referred to by a condition or event. The name is
+* resolved to a slot ahead of time, leaving only the owner to find when
+* the variable is used.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGUETREERUNTIME_API FDialogueVariable
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	* Resolves the variable's name to its slot.
+	*
+	* @param InType - EDialogueVariableType, the variable's type.
+	*/
+	void Resolve(EDialogueVariableType InType);
+
+	/**
+	* Gets the variable's slot, resolving it first if that has yet to be
+	* done, as with copies made since loading.
+	*
+	* @param InType - EDialogueVariableType, the variable's type.
+	* @return int32 - the slot, INDEX_NONE if the variable has no name.
+	*/
+	int32 GetSlot(EDialogueVariableType InType);
+
+	/**
+	* Finds the block holding the variable for the given dialogue.
+	*
+	* @param InDialogue - UDialogue*, the dialogue using the variable.
+	* @return const FDialogueVariableBlock* - the block, nullptr if the
+	* variable has never been set or cannot be reached.
+	*/
+	const FDialogueVariableBlock* FindBlock(UDialogue* InDialogue) const;
+
+	/**
+	* Finds the block holding the variable for the given dialogue, adding
+	* it if need be.
+	*
+	* @param InDialogue - UDialogue*, the dialogue using the variable.
+	* @return FDialogueVariableBlock* - the block, nullptr if the variable
+	* cannot be reached.
+	*/
+	FDialogueVariableBlock* FindOrAddBlock(UDialogue* InDialogue) const;
+
+	/**
+	* Checks if the variable has all the information it needs.
+	*
+	* @return bool - True if valid, False otherwise.
+	*/
+	bool IsValidVariable() const;
+
+	/**
+	* Gets text naming the variable, for graph descriptions.
+	*
+	* @return FText - the text.
+	*/
+	FText GetDisplayText() const;
+
+private:
+	/**
+	* Finds who owns the variable in the given dialogue.
+	*
+	* @param InDialogue - UDialogue*, the dialogue using the variable.
+	* @param OutOwner - FName&, the owner.
+	* @return bool - True if the owner could be found.
+	*/
+	bool GetOwner(UDialogue* InDialogue, FName& OutOwner) const;
+
+public:
+	/** Who the variable belongs to */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	EDialogueVariableScope Scope = EDialogueVariableScope::Global;
+
+	/** The variable's name */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FName Name;
+
+	/** The speaker the variable belongs to, for speaker variables */
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Scope == EDialogueVariableScope::Speaker", EditConditionHides))
+	TObjectPtr<UDialogueSpeakerSocket> Speaker;
+
+private:
+	/** The variable's slot, resolved from its name */
+	int32 Slot = INDEX_NONE;
+};
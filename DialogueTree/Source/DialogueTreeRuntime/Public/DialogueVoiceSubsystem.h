@@ -0,0 +1,140 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+//Generated
+#include "DialogueVoiceSubsystem.generated.h"
+
+class UAudioComponent;
+class UDialogueSpeakerComponent;
+class USoundBase;
+
+/**
+* A pooled audio component and the speaker currently borrowing it.
+*/
+USTRUCT()
+struct FDialogueVoiceChannel
+{
+	GENERATED_BODY()
+
+	/** The audio component speech is played through */
+	UPROPERTY()
+	TObjectPtr<UAudioComponent> AudioComponent;
+
+	/** The speaker borrowing the channel, if any */
+	UPROPERTY()
+	TWeakObjectPtr<UDialogueSpeakerComponent> Speaker;
+
+	/** Priority of the speech currently playing */
+	int32 Priority = 0;
+
+	/** World time the current speech started at */
+	double StartTime = 0.0;
+};
+
+/**
+* Plays speech audio for speaker components through a shared pool of voice
+* channels, rather than through each speaker's own audio component. Speakers
+* borrow a channel only while speaking. When every channel is busy, a new
+* speech steals the channel of the lowest priority speech, oldest first,
+* provided that speech's priority is lower. Speeches further from the
+* listener than the cull distance are not played at all. Used when
+* PoolSpeechAudio is enabled in the plugin settings.
+*/
+UCLASS()
+class DIALOGUETREERUNTIME_API UDialogueVoiceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UWorldSubsystem Impl. */
+	virtual void Deinitialize() override;
+	/** End UWorldSubsystem */
+
+	/**
+	* Plays speech for the given speaker on a voice channel. Any speech the
+	* speaker is already playing is stopped first.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	* @param InSound - USoundBase*, the speech audio.
+	* @param InPriority - int32, how important the speech is relative to
+	* others when channels run out.
+	* @param InStartTime - float, seconds into the audio to start from.
+	* @return bool - True if the speech is playing; False if it was culled
+	* or no channel could be freed for it.
+	*/
+	bool PlayVoice(UDialogueSpeakerComponent* InSpeaker, USoundBase* InSound,
+		int32 InPriority, float InStartTime = 0.f);
+
+	/**
+	* Stops any speech the given speaker is playing and frees its channel.
+	* The speaker is not notified, as it asked for the stop.
+	*
+	* @param InSpeaker - UDialogueSpeakerComponent*, the speaker.
+	*/
+	void StopVoice(UDialogueSpeakerComponent* InSpeaker);
+
+	/**
+	* Checks whether the given speaker is currently playing speech on a
+	* voice channel.
+	*
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the speaker.
+	* @return bool - True if the speaker holds a channel.
+	*/
+	bool IsVoicePlaying(const UDialogueSpeakerComponent* InSpeaker) const;
+
+private:
+	/**
+	* Checks whether the speaker is too far from the listener to be heard.
+	*
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the speaker.
+	* @param InCullDistance - float, the cull distance.
+	* @return bool - True if the speech should not be played.
+	*/
+	bool IsBeyondCullDistance(const UDialogueSpeakerComponent* InSpeaker,
+		float InCullDistance) const;
+
+	/**
+	* Finds a channel for a new speech, creating or stealing one if need be.
+	*
+	* @param InPriority - int32, the priority of the new speech.
+	* @param InMaxChannels - int32, the concurrency limit.
+	* @param OutStolenFrom - UDialogueSpeakerComponent*&, the speaker whose 
+	* speech was cut off to free the channel, if any.
+	* @return int32 - the index of the channel, or INDEX_NONE if none.
+	*/
+	int32 AcquireChannel(int32 InPriority, int32 InMaxChannels,
+		UDialogueSpeakerComponent*& OutStolenFrom);
+
+	/**
+	* Finds the channel the given speaker is borrowing.
+	*
+	* @param InSpeaker - const UDialogueSpeakerComponent*, the speaker.
+	* @return int32 - the index of the channel, or INDEX_NONE if none.
+	*/
+	int32 FindChannel(const UDialogueSpeakerComponent* InSpeaker) const;
+
+	/**
+	* Returns a channel to the pool. The caller lets the speaker know its
+	* speech is over, if it should be, once the pool is consistent.
+	*
+	* @param InChannelIndex - int32, the index of the channel.
+	* @return UDialogueSpeakerComponent* - the speaker which held it, if any.
+	*/
+	UDialogueSpeakerComponent* ReleaseChannel(int32 InChannelIndex);
+
+	/**
+	* Releases a channel once its speech finishes playing.
+	*
+	* @param InAudioComponent - UAudioComponent*, the channel's component.
+	*/
+	void OnChannelFinished(UAudioComponent* InAudioComponent);
+
+private:
+	/** Every voice channel created so far */
+	UPROPERTY()
+	TArray<FDialogueVoiceChannel> Channels;
+};
@@ -7,9 +7,43 @@
 #include "DialogueEventBase.generated.h"
 
 class UDialogue;
+class UDialogueEventBase;
 
 DECLARE_DELEGATE(FDialogueEventSignature);
 
+/**
+* Handle to a single asynchronous run of a dialogue event. Completing the 
+* handle frees up the dialogue to continue. Handles are cheap to copy and 
+* may be completed from any thread; completion is always applied on the 
+* game thread. Completing a handle whose run has already finished, or 
+* whose event has since been replayed, does nothing.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueEventHandle
+{
+	FDialogueEventHandle() = default;
+	FDialogueEventHandle(UDialogueEventBase* InEvent, uint32 InRunID)
+		: Event(InEvent), RunID(InRunID) {}
+
+	/**
+	* Marks the run as complete. Safe to call from any thread.
+	*/
+	void Complete() const;
+
+	/**
+	* Checks if the handle refers to an event.
+	*
+	* @return bool - True if the handle was issued by an event.
+	*/
+	bool IsValid() const;
+
+private:
+	/** The event the run belongs to */
+	TWeakObjectPtr<UDialogueEventBase> Event;
+
+	/** Which run of the event the handle completes */
+	uint32 RunID = 0;
+};
+
 /**
  * Base class for dialogue events. Does not require a speaker. 
  */
@@ -43,10 +77,19 @@ public:
 	UFUNCTION(BlueprintPure, Category="DialogueEvent")
 	bool GetIsBlocking() const;
 
+	/**
+	* Checks if the event only affects presentation, and so can be skipped
+	* by conversations playing out in reduced detail.
+	*
+	* @return bool - True if cosmetic, False otherwise.
+	*/
+	bool GetIsCosmetic() const;
+
 	/**
 	* Sets the blocking status of the event to true. Where possible, the 
 	* dialogue will attempt to wait until the event completes. StopBlocking() 
-	* should be called to free up the dialogue to continue. 
+	* should be called to free up the dialogue to continue. Must be called 
+	* while the event is being played. 
 	*/
 	UFUNCTION(BlueprintCallable, Category="DialogueEvent")
 	void StartBlocking();
@@ -58,6 +101,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "DialogueEvent")
 	void StopBlocking();
 
+	/**
+	* Starts blocking and returns a handle which ends the block when 
+	* completed. Native alternative to StartBlocking() for events whose 
+	* work finishes somewhere other than the event itself. Must be called
+	* while the event is being played. 
+	* 
+	* @return FDialogueEventHandle - handle completing this run. 
+	*/
+	FDialogueEventHandle BeginAsync();
+
+	/**
+	* Runs work on a background task, blocking the dialogue until it 
+	* finishes. The work must not touch UObjects; anything it needs should
+	* be captured by value. Must be called on the game thread.
+	* 
+	* @param InWork - TUniqueFunction<void()>&&, the work to run.
+	*/
+	void RunAsync(TUniqueFunction<void()>&& InWork);
+
 	/**
 	* User specified behavior for when a speech the event is attached
 	* to gets skipped.
@@ -88,6 +150,26 @@ protected:
 	UPROPERTY()
 	bool bBlocking = false;
 
+	/** Whether the event only affects presentation, such as animation or
+	* camera work. Cosmetic events are skipped when the conversation is far
+	* enough from the listener to play out in reduced detail. */
+	UPROPERTY(EditAnywhere, Category = "DialogueEvent")
+	bool bCosmetic = false;
+
+private:
+	/**
+	* Ends the block if the given run is still the current one. 
+	* 
+	* @param InRunID - uint32, the run being completed.
+	*/
+	void FinishAsync(uint32 InRunID);
+
+	friend struct FDialogueEventHandle;
+
+private:
+	/** Identifies the current blocking run; bumped whenever one ends */
+	uint32 CurrentRunID = 0;
+
 public:
 	FDialogueEventSignature OnStoppedBlocking;
 };
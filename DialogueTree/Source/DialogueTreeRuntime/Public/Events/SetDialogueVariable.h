@@ -0,0 +1,68 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DialogueVariables.h"
+#include "Events/DialogueEventBase.h"
+#include "SetDialogueVariable.generated.h"
+
+/**
+ * Dialogue event that sets a dialogue variable, or adds to a number.
+ */
+UCLASS()
+class DIALOGUETREERUNTIME_API USetDialogueVariable : public UDialogueEventBase
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+protected:
+	/** UDialogueEvent Impl. */
+	virtual void PlayEvent() override;
+	virtual bool HasAllRequirements() const override;
+	virtual FText GetGraphDescription_Implementation() const override;
+	/** End UDialogueEvent */
+
+private:
+	/** The variable to set */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueVariable Variable;
+
+	/** The kind of value the variable holds */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	EDialogueVariableType Type = EDialogueVariableType::Bool;
+
+	/** Whether to add the value to the variable rather than replace it */
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Int || Type == EDialogueVariableType::Float",
+		EditConditionHides))
+	bool AddToCurrent = false;
+
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Bool", EditConditionHides))
+	bool BoolValue = true;
+
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Int", EditConditionHides))
+	int32 IntValue = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Float", EditConditionHides))
+	float FloatValue = 0.f;
+
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Name", EditConditionHides))
+	FName NameValue;
+
+	UPROPERTY(EditAnywhere, Category = "Dialogue", meta = (EditCondition =
+		"Type == EDialogueVariableType::Tag", EditConditionHides))
+	FGameplayTag TagValue;
+};
@@ -0,0 +1,153 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+
+class UDialogue;
+class UDialogueCondition;
+
+/**
+* A single named value of an exported dialogue node.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueExportField
+{
+	FDialogueExportField() = default;
+	FDialogueExportField(const FString& InName, const FString& InValue)
+		: Name(InName), Value(InValue) {}
+
+	/** What the value represents */
+	FString Name;
+
+	/** The value itself */
+	FString Value;
+};
+
+/**
+* Snapshot of a compiled dialogue node. Gathered on the game thread, since
+* condition descriptions may call into Blueprint, and formatted anywhere.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueExportNode
+{
+	/**
+	* Adds a named value to the node.
+	*
+	* @param InName - const FString&, what the value represents.
+	* @param InValue - const FString&, the value.
+	*/
+	void AddField(const FString& InName, const FString& InValue);
+
+	/**
+	* Adds a piece of text to the node along with its localization key,
+	* so translations can be matched back to the source.
+	*
+	* @param InName - const FString&, what the text represents.
+	* @param InText - const FText&, the text.
+	*/
+	void AddText(const FString& InName, const FText& InText);
+
+	/**
+	* Adds the description of a condition to the node.
+	*
+	* @param InCondition - UDialogueCondition*, the condition.
+	*/
+	void AddCondition(UDialogueCondition* InCondition);
+
+	/** The ID of the node */
+	FName NodeID;
+
+	/** The kind of node */
+	FString NodeType;
+
+	/** The node's content, in the order it was added */
+	TArray<FDialogueExportField> Fields;
+
+	/** IDs of the nodes which follow this one, in traversal order */
+	TArray<FName> Children;
+};
+
+/**
+* Snapshot of a compiled dialogue.
+*/
+struct DIALOGUETREERUNTIME_API FDialogueExportData
+{
+	/** The package holding the dialogue */
+	FString PackageName;
+
+	/** The dialogue's compile status */
+	FString CompileStatus;
+
+	/** The ID of the dialogue's entry node */
+	FName RootNodeID;
+
+	/** The speaking roles of the dialogue */
+	TArray<FName> Speakers;
+
+	/** Every node of the compiled dialogue */
+	TArray<FDialogueExportNode> Nodes;
+};
+
+/**
+* Writes compiled dialogues out as plain text for localization and review.
+* Only the runtime payload built when a dialogue is compiled is read, never
+* the editor graph. Nodes, speakers and tags are sorted so that the same
+* dialogue always produces the same text, and files whose text has not
+* changed are left untouched, keeping diffs between builds to a minimum.
+*/
+class DIALOGUETREERUNTIME_API FDialogueTextExporter
+{
+public:
+	/**
+	* Snapshots the compiled content of a dialogue. Must be called on the
+	* game thread. Static.
+	*
+	* @param InDialogue - const UDialogue*, the dialogue.
+	* @param OutData - FDialogueExportData&, the snapshot.
+	*/
+	static void GatherExportData(const UDialogue* InDialogue,
+		FDialogueExportData& OutData);
+
+	/**
+	* Formats a snapshot as text. Safe to call from any thread. Static.
+	*
+	* @param InData - const FDialogueExportData&, the snapshot.
+	* @return FString - the exported text.
+	*/
+	static FString FormatExportData(const FDialogueExportData& InData);
+
+	/**
+	* Gets the file a dialogue is exported to. Static.
+	*
+	* @param InPackageName - const FString&, the dialogue's package.
+	* @param InOutputDir - const FString&, the root export directory.
+	* @return FString - the export file path.
+	*/
+	static FString GetExportFilePath(const FString& InPackageName,
+		const FString& InOutputDir);
+
+	/**
+	* Exports the given dialogues. Snapshots are taken on the calling
+	* thread, which must be the game thread, then formatted and written in
+	* parallel. Static.
+	*
+	* @param InDialogues - const TArray<UDialogue*>&, the dialogues.
+	* @param InOutputDir - const FString&, the root export directory.
+	* @return int32 - the number of files which were written or changed.
+	*/
+	static int32 ExportDialogues(const TArray<UDialogue*>& InDialogues,
+		const FString& InOutputDir);
+
+public:
+	/** The extension given to exported files */
+	static const FString FILE_EXTENSION;
+
+private:
+	/**
+	* Escapes a value so that it fits on a single line. Static.
+	*
+	* @param InValue - const FString&, the value.
+	* @return FString - the escaped value.
+	*/
+	static FString EscapeValue(const FString& InValue);
+};
@@ -24,6 +24,7 @@ public:
 	/** UDialogueNode Implementation */
 	virtual FDialogueOption GetAsOption() override;
 	virtual void EnterNode() override;
+	virtual void GetExportData(FDialogueExportNode& OutNode) const override;
 	/** End UDialogueNode */
 
 	/**
@@ -13,7 +13,9 @@ class UDialogueEventBase;
 
 /**
  * Dialogue node that plays a user-specified sequence of 
- * dialogue events. 
+ * dialogue events. Events may wait on other events in the node to finish 
+ * before starting; events with nothing to wait on start together, and the 
+ * node completes once every event has finished. 
  */
 UCLASS()
 class DIALOGUETREERUNTIME_API UDialogueEventNode : public UDialogueNode
@@ -25,6 +27,7 @@ public:
 	virtual void EnterNode() override;
 	virtual FDialogueOption GetAsOption() override;
 	virtual void Skip() override;
+	virtual void GetExportData(FDialogueExportNode& OutNode) const override;
 	/** End UDialogueNode */
 
 	/**
@@ -35,12 +38,31 @@ public:
 	void SetEvents(TArray<UDialogueEventBase*>& InEvents);
 
 	/**
-	* Checks if there an ongoing event is blocking. 
+	* Sets which events must finish before each event starts. Must be 
+	* called after SetEvents() and describe an acyclic graph. Events without
+	* dependencies start as soon as the node is entered. 
+	* 
+	* @param InDependencies - const TArray<TArray<int32>>&, for each event, 
+	* the indices of the events it waits on. 
+	*/
+	void SetEventDependencies(const TArray<TArray<int32>>& InDependencies);
+
+	/**
+	* Checks if there an ongoing event is blocking or waiting to start. 
+	* Constant time; the node keeps a count of outstanding events rather 
+	* than polling them.
 	* 
 	* @return bool - True if an event is blocking; False otherwise.
 	*/
 	bool GetIsBlocking() const;
 
+	/**
+	* Retrieves the node's events. 
+	* 
+	* @return const TArray<TObjectPtr<UDialogueEventBase>>& - the events.
+	*/
+	const TArray<TObjectPtr<UDialogueEventBase>>& GetEvents() const;
+
 protected: 
 	/**
 	* Plays the node's events. 
@@ -53,8 +75,57 @@ protected:
 	UFUNCTION()
 	virtual void TransitionIfNotBlocking() const;
 
+private:
+	/**
+	* Plays a single event, finishing it straight away if it does not block.
+	* 
+	* @param InIndex - int32, the index of the event. 
+	*/
+	void StartEvent(int32 InIndex);
+
+	/**
+	* Marks an event as finished and starts any events left with nothing to
+	* wait on. 
+	* 
+	* @param InIndex - int32, the index of the event. 
+	*/
+	void FinishEvent(int32 InIndex);
+
+	/**
+	* Finishes an event which has stopped blocking, transitioning once no 
+	* events remain.
+	* 
+	* @param InIndex - int32, the index of the event. 
+	*/
+	void OnEventStoppedBlocking(int32 InIndex);
+
 private:
 	/** Events to play */
 	UPROPERTY()
 	TArray<TObjectPtr<UDialogueEventBase>> Events;
+
+	/** Number of events each event waits on. Empty if all start together */
+	UPROPERTY()
+	TArray<int32> EventDependencyCounts;
+
+	/** Where each event's dependents begin in EventDependents; one entry 
+	* per event plus a terminator */
+	UPROPERTY()
+	TArray<int32> EventDependentOffsets;
+
+	/** Events waiting on each event, flattened in event order */
+	UPROPERTY()
+	TArray<int32> EventDependents;
+
+	/** Dependencies each event is still waiting on this play */
+	TArray<int32> RemainingDependencies;
+
+	/** Which events have started blocking and not yet finished */
+	TBitArray<> RunningEvents;
+
+	/** Number of events which have not yet finished */
+	int32 OutstandingEvents = 0;
+
+	/** Whether the node is in the middle of scheduling its events */
+	bool bSchedulingEvents = false;
 };
@@ -22,6 +22,7 @@ public:
 	/** UDialogueNode Implementation */
 	virtual void EnterNode() override;
 	virtual FDialogueOption GetAsOption() override;
+	virtual void GetExportData(FDialogueExportNode& OutNode) const override;
 	/** End UDialogueNode */
 
 	/**
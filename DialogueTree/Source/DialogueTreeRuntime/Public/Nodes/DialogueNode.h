@@ -6,11 +6,13 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 //Plugin
+#include "DialogueLOD.h"
 #include "DialogueOption.h"
 //Generated
 #include "DialogueNode.generated.h"
 
 class UDialogue;
+struct FDialogueExportNode;
 
 /**
  * Abstract base class for all runtime dialogue nodes. 
@@ -64,6 +66,14 @@ public:
 	*/
 	TArray<UDialogueNode*> GetChildren() const;
 
+	/**
+	* Retrieves the first child of this node without copying the list of
+	* children. 
+	* 
+	* @return UDialogueNode*, the first child, nullptr if none. 
+	*/
+	UDialogueNode* GetFirstChild() const;
+
 	/**
 	* Gets an FDialogueOption struct representing this node as a
 	* selectable option. 
@@ -91,6 +101,21 @@ public:
 	*/
 	virtual void Skip() {};
 
+	/**
+	* Reacts to the dialogue's LOD changing while the node is active.
+	*
+	* @param InOldLOD - EDialogueLOD, the level the dialogue was at.
+	*/
+	virtual void OnLODChanged(EDialogueLOD InOldLOD) {};
+
+	/**
+	* Snapshots the node's compiled content for text export. Subclasses 
+	* add their own content on top of the ID, type and children. 
+	* 
+	* @param OutNode - FDialogueExportNode&, the snapshot to fill. 
+	*/
+	virtual void GetExportData(FDialogueExportNode& OutNode) const;
+
 	/**
 	* Retrieves the id for the node in dialogue
 	* 
@@ -21,6 +21,7 @@ public:
 	/** UDialogueNode Implementation */
 	virtual FDialogueOption GetAsOption() override;
 	virtual void EnterNode() override;
+	virtual void GetExportData(FDialogueExportNode& OutNode) const override;
 	/** End UDialogueNode */
 
 public:
@@ -32,10 +33,31 @@ public:
 	* @param InConditions - TArray<UDialogueCondition*>&, array of conditions.
 	* @param LockedText - FText - optional message when locked
 	* @param UnlockedText - FText - optional message when unlocked
+	* @param LockedKey - const FString& - string table key of the locked 
+	* message. If set, the message is resolved when needed rather than 
+	* stored. 
+	* @param UnlockedKey - const FString& - string table key of the 
+	* unlocked message.
 	*/
 	void InitLockNodeData(bool InIfAny, 
 		TArray<UDialogueCondition*>& InConditions, 
-		const FText& LockedText, const FText& UnlockedText);
+		const FText& LockedText, const FText& UnlockedText,
+		const FString& LockedKey = FString(), 
+		const FString& UnlockedKey = FString());
+
+	/**
+	* Retrieves the message shown while the option is locked.
+	*
+	* @return FText - the locked message.
+	*/
+	FText GetLockedMessage() const;
+
+	/**
+	* Retrieves the message shown while the option is unlocked.
+	*
+	* @return FText - the unlocked message.
+	*/
+	FText GetUnlockedMessage() const;
 
 private:
 	/**
@@ -74,5 +96,14 @@ private:
 	FText LockedMessage = FText();
 
 	/** Optional message to include when unlocked */
+	UPROPERTY()
 	FText UnlockedMessage = FText();
+
+	/** String table key of the locked message, if any */
+	UPROPERTY()
+	FString LockedMessageKey;
+
+	/** String table key of the unlocked message, if any */
+	UPROPERTY()
+	FString UnlockedMessageKey;
 };
@@ -29,9 +29,13 @@ public:
 	* @param Details - FSpeechDetails&, the data for the speech node. 
 	* @param TransitionType - TSubclassOf<UDialogueTransition>, the type of 
 	* transition to use. 
+	* @param InTextKey - const FString&, the key of the speech text in the 
+	* dialogue's string table. If set, the text is resolved when needed 
+	* rather than stored in the details. 
 	*/
 	void InitSpeechData(FSpeechDetails& InDetails, 
-		TSubclassOf<UDialogueTransition> TransitionType);
+		TSubclassOf<UDialogueTransition> TransitionType, 
+		const FString& InTextKey = FString());
 
 	/**
 	* Checks if the node is skippable by the player. 
@@ -41,11 +45,37 @@ public:
 	bool GetCanSkip() const;
 
 	/**
-	* Retrieves the details struct for the speech.
+	* Gets how long the speech cools down for once spoken.
+	*
+	* @return float - the cooldown, in seconds.
+	*/
+	float GetCooldown() const;
+
+	/**
+	* Gets the least time the speech plays for, unless skipped.
+	*
+	* @return float - the minimum play time, in seconds.
+	*/
+	float GetMinimumPlayTime() const;
+
+	/**
+	* Gets how long the speech's audio lasts, if it plays at all.
+	*
+	* @return float - the duration in seconds; zero if the speech has no
+	* audio, loops forever or has its content ignored.
+	*/
+	float GetAudioDuration() const;
+
+	/**
+	* Retrieves the details struct for the speech, resolving the speech 
+	* text from the dialogue's string table if needed and filling in any 
+	* named arguments from the controller's argument provider. The 
+	* reference remains valid until the details are next retrieved from 
+	* this node. 
 	* 
-	* @return FSpeechDetails, details for the speech. 
+	* @return const FSpeechDetails&, details for the speech. 
 	*/
-	FSpeechDetails GetDetails() const;
+	const FSpeechDetails& GetDetails() const;
 
 	/**
 	* Retrieves the speaker component associated with the speech 
@@ -56,11 +86,40 @@ public:
 	*/
 	UDialogueSpeakerComponent* GetSpeaker() const;
 
+	/**
+	* Sets the dialogue's speaker slot for the speaking role. Used when 
+	* the node is created during compiling of the dialogue. 
+	* 
+	* @param InSlot - int32, the slot. 
+	*/
+	void SetSpeakerSlot(int32 InSlot);
+
+	/**
+	* Retrieves the dialogue's speaker slot for the speaking role. 
+	* 
+	* @return int32 - the slot, INDEX_NONE if unresolved. 
+	*/
+	int32 GetSpeakerSlot() const;
+
+	/**
+	* Checks whether the speech moves on to its first child by itself once
+	* done playing, rather than waiting on a selection. 
+	* 
+	* @return bool - True if the node uses an auto transition. 
+	*/
+	bool GetIsAutoTransition() const;
+
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+	/** End UObject */
+
 	/** DialogueEventNode Impl. */
 	virtual void EnterNode() override;
 	virtual FDialogueOption GetAsOption() override;
 	virtual void SelectOption(int32 InOptionIndex) override;
 	virtual void Skip() override;
+	virtual void OnLODChanged(EDialogueLOD InOldLOD) override;
+	virtual void GetExportData(FDialogueExportNode& OutNode) const override;
 	/** End DialogueEventNode */
 
 protected:
@@ -72,14 +131,46 @@ private:
 	/**
 	* Tells the active speaker component to start speaking and 
 	* sets any behavior flags associated with this speech. 
+	*
+	* @param InStartTime - float, seconds into the audio to start from.
+	*/
+	void StartAudio(float InStartTime = 0.f);
+
+	/**
+	* Compiles the speech text into a format pattern and caches the names 
+	* of its arguments, so displaying the speech needs no parsing. Called 
+	* on first display rather than on load, once the dialogue's string 
+	* table is available. Argument names are read from the source string,
+	* so they hold for every culture.
 	*/
-	void StartAudio();
+	void CacheSpeechFormat() const;
 
 private:
 	/** The primary content of the speech */
 	UPROPERTY()
 	FSpeechDetails Details;
 
+	/** Slot of the speaking role in the dialogue */
+	UPROPERTY()
+	int32 SpeakerSlot = INDEX_NONE;
+
+	/** Key of the speech text in the dialogue's string table, if any */
+	UPROPERTY()
+	FString SpeechTextKey;
+
+	/** The speech text compiled as a format pattern */
+	mutable FTextFormat SpeechFormat;
+
+	/** Names of the arguments the speech text expects, empty if none */
+	mutable TArray<FString> SpeechArgumentNames;
+
+	/** Whether the format pattern has been compiled */
+	mutable bool bSpeechFormatCached = false;
+
+	/** Reused copy of the details with text resolved, when resolving is 
+	* needed */
+	mutable FSpeechDetails ResolvedDetails;
+
 	/** The transition that governs how we leave the speech */
 	UPROPERTY()
 	TObjectPtr<UDialogueTransition> Transition = nullptr;
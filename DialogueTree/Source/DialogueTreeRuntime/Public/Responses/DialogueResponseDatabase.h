@@ -0,0 +1,205 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+//Generated
+#include "DialogueResponseDatabase.generated.h"
+
+class UDialogue;
+
+/**
+* A range a numeric fact must fall within for a rule to match.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGUETREERUNTIME_API FDialogueFactCriterion
+{
+	GENERATED_BODY()
+
+	/** The fact to test */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FGameplayTag Fact;
+
+	/** The lowest matching value, inclusive */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	float Min = 0.f;
+
+	/** The highest matching value, inclusive */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	float Max = 0.f;
+};
+
+/**
+* A line which may be spoken in response to a concept, along with the
+* criteria the situation must meet for it to be chosen.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGUETREERUNTIME_API FDialogueResponseRule
+{
+	GENERATED_BODY()
+
+	/** What is being responded to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FGameplayTag Concept;
+
+	/** The dialogue name of the speaker who may say the line. If none, any
+	* speaker may. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FName SpeakerName;
+
+	/** Facts which must all hold */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FGameplayTagContainer RequiredFacts;
+
+	/** Numeric facts which must fall within range */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	TArray<FDialogueFactCriterion> Criteria;
+
+	/** The dialogue holding the line */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	TObjectPtr<UDialogue> Dialogue;
+
+	/** The speech node to speak */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FName NodeID;
+
+	/** Relative chance of being picked over equally specific matches */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue",
+		meta = (ClampMin = 0))
+	float Weight = 1.f;
+
+	/**
+	* Gets how specific the rule is; more specific matches win.
+	*
+	* @return int32 - the number of criteria the rule imposes.
+	*/
+	int32 GetSpecificity() const;
+};
+
+/**
+* The situation a response is being chosen for.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGUETREERUNTIME_API FDialogueResponseQuery
+{
+	GENERATED_BODY()
+
+	/** What is being responded to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FGameplayTag Concept;
+
+	/** The dialogue name of the responding speaker */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FName SpeakerName;
+
+	/** Facts which currently hold */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	FGameplayTagContainer Facts;
+
+	/** Current values of numeric facts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+	TMap<FGameplayTag, float> FactValues;
+};
+
+/**
+* Index over the rules responding to a single concept. Rules are ordered
+* most specific first, and for each distinct fact and speaker a bit is set
+* against every rule requiring it, so rules which cannot match are
+* discarded a word at a time.
+*/
+struct FDialogueResponseBucket
+{
+	/** Indices of the bucket's rules, most specific first */
+	TArray<int32> Rules;
+
+	/** Distinct facts required by the bucket's rules */
+	TArray<FGameplayTag> FactTags;
+
+	/** For each fact, which rules require it */
+	TArray<TBitArray<>> RulesRequiringFact;
+
+	/** Distinct speakers the bucket's rules are restricted to */
+	TArray<FName> SpeakerNames;
+
+	/** For each speaker, which rules are restricted to it */
+	TArray<TBitArray<>> RulesRequiringSpeaker;
+};
+
+/**
+* Database of response rules for context-driven barks. Given a concept, a
+* speaker and the facts of the moment, picks the most specific matching
+* line, choosing between equally specific lines by weight. Rules are
+* compiled into a per-concept index when the database loads, so the cost
+* of a query follows the rules that could match rather than every rule.
+*/
+UCLASS(BlueprintType)
+class DIALOGUETREERUNTIME_API UDialogueResponseDatabase : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** UObject Impl. */
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(
+		FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/** End UObject */
+
+	/**
+	* Picks the best response for a situation.
+	*
+	* @param InQuery - const FDialogueResponseQuery&, the situation.
+	* @param OutDialogue - UDialogue*&, the dialogue holding the response.
+	* @param OutNodeID - FName&, the speech node to speak.
+	* @return bool - True if a rule matched.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Dialogue")
+	bool FindResponse(const FDialogueResponseQuery& InQuery,
+		UDialogue*& OutDialogue, FName& OutNodeID) const;
+
+	/**
+	* Picks the best response for a situation from among the rules passing
+	* the given filter. Rules filtered out give way to less specific ones.
+	*
+	* @param InQuery - const FDialogueResponseQuery&, the situation.
+	* @param InFilter - TFunctionRef, returns false for rules to pass over.
+	* @param OutDialogue - UDialogue*&, the dialogue holding the response.
+	* @param OutNodeID - FName&, the speech node to speak.
+	* @return bool - True if a rule matched.
+	*/
+	bool FindFilteredResponse(const FDialogueResponseQuery& InQuery,
+		TFunctionRef<bool(const FDialogueResponseRule&)> InFilter,
+		UDialogue*& OutDialogue, FName& OutNodeID) const;
+
+	/**
+	* Rebuilds the index from the rules. Called automatically on load and
+	* when the rules are edited.
+	*/
+	void CompileRules();
+
+private:
+	/**
+	* Checks a rule's numeric criteria against the query.
+	*
+	* @param InRule - const FDialogueResponseRule&, the rule.
+	* @param InQuery - const FDialogueResponseQuery&, the situation.
+	* @return bool - True if every criterion holds.
+	*/
+	static bool MatchesCriteria(const FDialogueResponseRule& InRule,
+		const FDialogueResponseQuery& InQuery);
+
+private:
+	/** The rules to choose between */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	TArray<FDialogueResponseRule> Rules;
+
+	/** Compiled index, by concept */
+	TMap<FGameplayTag, FDialogueResponseBucket> Buckets;
+
+	/** Reused mask of the rules a query could match */
+	mutable TBitArray<> CandidateRules;
+};
@@ -35,6 +35,10 @@ struct FSpeechDetails
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
 	float MinimumPlayTime = 0.f;
 
+	/** Seconds after the speech is spoken before it may be barked again */
+	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
+	float Cooldown = 0.f;
+
 	/** Any behavior flags associated with the speech as gameplay tags */
 	UPROPERTY(BlueprintReadOnly, Category = "Dialogue")
 	FGameplayTagContainer GameplayTags;
@@ -4,7 +4,6 @@
 
 //UE
 #include "CoreMinimal.h"
-#include "TimerManager.h"
 #include "UObject/NoExportTypes.h"
 //Plugin
 #include "DialogueConnectionLimit.h"
@@ -12,6 +11,7 @@
 #include "DialogueTransition.generated.h"
 
 class UDialogueSpeechNode;
+class UDialogueTransitionScheduler;
 
 /**
  * Abstract base class for speech transitions. Transitions govern
@@ -22,10 +22,6 @@ class DIALOGUETREERUNTIME_API UDialogueTransition : public UObject
 {
 	GENERATED_BODY()
 
-public:
-	//Constructor
-	UDialogueTransition();
-	
 public:
 	/**
 	* Sets the owning node. 
@@ -59,6 +55,20 @@ public:
 	*/
 	virtual void Skip();
 
+	/**
+	* Stops waiting on the speaker's audio and waits instead until it
+	* would have finished. Called when the speech's audio is cut short by
+	* the dialogue going virtual, so the speech keeps its timing.
+	*/
+	void VirtualizeAudio();
+
+	/**
+	* Gets how long the speech has been playing.
+	*
+	* @return float - seconds since the transition started.
+	*/
+	float GetElapsedTime() const;
+
 	/**
 	* Retrieves the display name for the transition. 
 	* 
@@ -90,19 +100,25 @@ public:
 	void CheckTransitionConditions();
 
 private:
+	/**
+	* Retrieves the scheduler advancing the transition.
+	* 
+	* @return UDialogueTransitionScheduler* - the scheduler, if any. 
+	*/
+	UDialogueTransitionScheduler* GetScheduler() const;
 
 	/**
 	* Called when the speech content has finished playing.
 	*/
-	UFUNCTION()
 	void OnDonePlayingContent();
 
 	/**
 	* Called when the minimum play time has elapsed.
 	*/
-	UFUNCTION()
 	void OnMinPlayTimeElapsed();
 
+	friend class UDialogueTransitionScheduler;
+
 protected:
 	/** The node upon which the transition operates*/
 	UPROPERTY()
@@ -115,12 +131,12 @@ protected:
 	bool bAudioFinished = false;
 
 private:
-	/** Delegate to call when the minimum play time for the node has elapsed */
-	FTimerDelegate OnTimerEnd;
+	/** Identifies the current wait, so the scheduler can drop stale ones */
+	uint32 WaitID = 0;
 
-	/** Timer handle for timer that tracks minimum play time */
-	FTimerHandle MinPlayTimeHandle;
+	/** World time at which the transition started */
+	double StartTime = 0.0;
 
-	/** Delegate to call when the speech has finished playing */
-	FScriptDelegate OnContentEnd;
+	/** Whether the end of the audio is timed rather than listened for */
+	bool bAudioVirtualized = false;
 };
@@ -0,0 +1,31 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+using UnrealBuildTool;
+
+public class DialogueTreeMass : ModuleRules
+{
+	public DialogueTreeMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"MassEntity",
+				"DialogueTreeRuntime"
+			}
+			);
+
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Engine",
+				"MassCommon",
+				"MassActors"
+			}
+			);
+	}
+}
@@ -0,0 +1,107 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+//Header
+#include "DialogueCrowdProcessor.h"
+//UE
+#include "Engine/World.h"
+#include "MassActorSubsystem.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+//Plugin
+#include "DialogueCrowdFragment.h"
+#include "DialogueCrowdSubsystem.h"
+#include "DialogueSpeakerComponent.h"
+
+UDialogueCrowdProcessor::UDialogueCrowdProcessor()
+	: EntityQuery(*this)
+{
+	//Speakers are components, so binding them is game thread work
+	bRequiresGameThreadExecution = true;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteAfter.Add(
+		UE::Mass::ProcessorGroupNames::Representation
+	);
+}
+
+void UDialogueCrowdProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FDialogueCrowdFragment>(
+		EMassFragmentAccess::ReadWrite
+	);
+	EntityQuery.AddRequirement<FMassActorFragment>(
+		EMassFragmentAccess::ReadWrite
+	);
+}
+
+void UDialogueCrowdProcessor::Execute(FMassEntityManager& EntityManager,
+	FMassExecutionContext& Context)
+{
+	UWorld* World = EntityManager.GetWorld();
+	UDialogueCrowdSubsystem* CrowdSubsystem =
+		World ? World->GetSubsystem<UDialogueCrowdSubsystem>() : nullptr;
+	if (!CrowdSubsystem)
+	{
+		return;
+	}
+
+	CrowdSubsystem->AdvanceConversations();
+
+	EntityQuery.ForEachEntityChunk(
+		EntityManager,
+		Context,
+		[CrowdSubsystem](FMassExecutionContext& Context)
+		{
+			const TArrayView<FDialogueCrowdFragment> CrowdList =
+				Context.GetMutableFragmentView<FDialogueCrowdFragment>();
+			const TArrayView<FMassActorFragment> ActorList =
+				Context.GetMutableFragmentView<FMassActorFragment>();
+
+			for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+			{
+				FDialogueCrowdFragment& Crowd = CrowdList[Index];
+				AActor* Actor = ActorList[Index].GetMutable();
+
+				//Ending a conversation silences its speakers already
+				if (!CrowdSubsystem->IsConversationActive(Crowd.Conversation))
+				{
+					Crowd.BoundSpeaker.Reset();
+					continue;
+				}
+
+				//Nothing to do while the agent keeps the same speaker
+				UDialogueSpeakerComponent* OldSpeaker =
+					Crowd.BoundSpeaker.Get();
+				if (OldSpeaker && OldSpeaker->GetOwner() == Actor)
+				{
+					continue;
+				}
+
+				UDialogueSpeakerComponent* NewSpeaker = Actor
+					? Actor->FindComponentByClass<UDialogueSpeakerComponent>()
+					: nullptr;
+				if (!NewSpeaker && Crowd.BoundSpeaker.IsExplicitlyNull())
+				{
+					continue;
+				}
+
+				//Demoted, or swapped for another actor
+				if (!Crowd.BoundSpeaker.IsExplicitlyNull())
+				{
+					CrowdSubsystem->UnbindSpeaker(
+						Crowd.Conversation,
+						Crowd.Role
+					);
+					Crowd.BoundSpeaker.Reset();
+				}
+
+				if (NewSpeaker && CrowdSubsystem->BindSpeaker(
+					Crowd.Conversation,
+					Crowd.Role,
+					NewSpeaker))
+				{
+					Crowd.BoundSpeaker = NewSpeaker;
+				}
+			}
+		}
+	);
+}
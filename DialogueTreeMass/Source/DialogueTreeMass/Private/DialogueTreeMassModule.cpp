@@ -0,0 +1,19 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#include "DialogueTreeMassModule.h"
+
+#define LOCTEXT_NAMESPACE "FDialogueTreeMassModule"
+
+void FDialogueTreeMassModule::StartupModule()
+{
+	//Currently empty.
+}
+
+void FDialogueTreeMassModule::ShutdownModule()
+{
+	//Currently empty.
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FDialogueTreeMassModule, DialogueTreeMass)
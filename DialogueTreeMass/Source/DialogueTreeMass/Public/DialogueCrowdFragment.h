@@ -0,0 +1,34 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+//Plugin
+#include "DialogueCrowdSubsystem.h"
+//Generated
+#include "DialogueCrowdFragment.generated.h"
+
+class UDialogueSpeakerComponent;
+
+/**
+* Puts a Mass agent in a crowd conversation, speaking one of its roles.
+* Whatever starts the conversation fills in the handle and role.
+*/
+USTRUCT()
+struct DIALOGUETREEMASS_API FDialogueCrowdFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** The conversation the agent takes part in */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FDialogueCrowdHandle Conversation;
+
+	/** The speaker role the agent speaks */
+	UPROPERTY(EditAnywhere, Category = "Dialogue")
+	FName Role;
+
+	/** The speaker bound to the role while the agent is an actor */
+	TWeakObjectPtr<UDialogueSpeakerComponent> BoundSpeaker;
+};
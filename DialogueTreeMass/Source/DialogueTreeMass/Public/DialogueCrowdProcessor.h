@@ -0,0 +1,38 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+//UE
+#include "CoreMinimal.h"
+#include "MassEntityQuery.h"
+#include "MassProcessor.h"
+//Generated
+#include "DialogueCrowdProcessor.generated.h"
+
+/**
+* Drives crowd conversations for Mass agents. Advances the crowd
+* subsystem's conversations, and binds an agent's speaker to its role when
+* the agent is promoted to an actor, unbinding it again once demoted.
+* Written against the processor API of UE 5.2 to 5.5: queries registered
+* through the FMassEntityQuery(UMassProcessor&) constructor, which 5.1
+* lacks, and the argumentless ConfigureQueries, which 5.6 replaces.
+*/
+UCLASS()
+class DIALOGUETREEMASS_API UDialogueCrowdProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UDialogueCrowdProcessor();
+
+protected:
+	/** UMassProcessor Impl. */
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager,
+		FMassExecutionContext& Context) override;
+	/** End UMassProcessor */
+
+private:
+	/** Agents taking part in crowd conversations */
+	FMassEntityQuery EntityQuery;
+};
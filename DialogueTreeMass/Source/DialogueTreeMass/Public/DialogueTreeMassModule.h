@@ -0,0 +1,19 @@
+// Copyright Zachary Brett, 2024. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+* Loads and unloads the dialogue system's optional Mass module.
+*/
+class FDialogueTreeMassModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	/** End IModuleInterface */
+};